@@ -1,11 +1,10 @@
 #include "App.h"
 #include "../Vulkan/ProjectionPass.h"
+#include "../Vulkan/BinningPass.h"
 #include "../Vulkan/SortPass.h"
+#include "../Vulkan/TileRangePass.h"
 #include "../Vulkan/RasterPass.h"
 
-// Gaussian2D struct size in std430: 48 bytes per element
-static constexpr vk::DeviceSize GAUSSIAN_2D_STRIDE = 48;
-
 // ---------------------------------------------------------------------------
 // Constructor / Destructor
 // ---------------------------------------------------------------------------
@@ -20,23 +19,38 @@ App::~App() {
         context_->Device().waitIdle();
     }
 
+    // 로더 스레드가 staging 매핑에 쓰고 있을 수 있으므로 먼저 취소/join
+    sceneLoader_.reset();
+    sceneStaging_ = {};
+
     // Destroy in reverse dependency order
     renderer_.reset();
 
     // Passes (각 pass가 자기 pipeline + descriptor 소유)
     projPass_.reset();
+    binPass_.reset();
     sortPass_.reset();
+    rangePass_.reset();
     rastPass_.reset();
 
     // Per-frame output buffers
     for (auto& buf : projected2DBuffers_) buf.reset();
     for (auto& buf : visibilityBuffers_) buf.reset();
     for (auto& buf : tileCountBuffers_) buf.reset();
+    for (auto& buf : lodRowBuffers_) buf.reset();
+    for (auto& buf : visibleClusterBuffers_) buf.reset();
+    for (auto& buf : dispatchArgsBuffers_) buf.reset();
+    for (auto& tiles : tileKeyBuffers_) tiles = {};
+    for (auto& buf : tileRangeBuffers_) buf.reset();
+    for (auto& img : rasterImages_) img.reset();
 
     // UBO buffers
     for (auto& buf : uboStaging_) buf.reset();
     for (auto& buf : uboDevice_) buf.reset();
 
+    // 읽기 worker join (pool 버퍼와 uploadManager_를 참조)
+    streamer_.reset();
+    uploadManager_.reset();
     commandManager_.reset();
 
     // Input buffers
@@ -45,8 +59,8 @@ App::~App() {
     opacityBuffer_.reset();
     scaleBuffer_.reset();
     rotationBuffer_.reset();
+    clusterBoundsBuffer_.reset();
 
-    pipeline_.reset();
     swapchain_.reset();
     splatSet_.reset();
     context_.reset();
@@ -88,7 +102,6 @@ void App::initWindow(uint32_t width, uint32_t height, const char* title) {
 void App::initVulkan() {
     context_        = std::make_unique<Context>(window_);
     swapchain_      = std::make_unique<Swapchain>(*context_, window_);
-    pipeline_       = std::make_unique<Pipeline>(*context_, *swapchain_);
 
     for (uint32_t i = 0; i < CommandManager::FRAMES_IN_FLIGHT; i++) {
         uboStaging_[i] = std::make_unique<Buffer>(
@@ -102,15 +115,19 @@ void App::initVulkan() {
     }
     camera_.SetScreenSize(swapchain_->GetExtent().width, swapchain_->GetExtent().height);
 
-    // ─── 3 compute passes (각 pass가 자기 pipeline 소유) ───
+    // ─── 5 compute passes (각 pass가 자기 pipeline 소유) ───
     projPass_ = std::make_unique<ProjectionPass>(
         *context_, "Shaders/proj.comp.spv", CommandManager::FRAMES_IN_FLIGHT);
-    sortPass_ = std::make_unique<SortPass>(*context_, "Shaders/sort.comp.spv");
-    rastPass_ = std::make_unique<RasterPass>(*context_, "Shaders/rast.comp.spv");
+    binPass_  = std::make_unique<BinningPass>(*context_, "Shaders/bin.comp.spv", CommandManager::FRAMES_IN_FLIGHT);
+    sortPass_ = std::make_unique<SortPass>(*context_, "Shaders/sort.comp.spv", CommandManager::FRAMES_IN_FLIGHT);
+    rangePass_ = std::make_unique<TileRangePass>(
+        *context_, "Shaders/ranges.comp.spv", CommandManager::FRAMES_IN_FLIGHT);
+    rastPass_ = std::make_unique<RasterPass>(
+        *context_, "Shaders/rast.comp.spv", CommandManager::FRAMES_IN_FLIGHT);
 
     commandManager_ = std::make_unique<CommandManager>(*context_);
-    renderer_       = std::make_unique<Renderer>(*context_, *swapchain_,
-                                                 *pipeline_, *commandManager_);
+    uploadManager_  = std::make_unique<UploadManager>(*context_);
+    renderer_       = std::make_unique<Renderer>(*context_, *swapchain_, *commandManager_);
 }
 
 // ---------------------------------------------------------------------------
@@ -121,67 +138,233 @@ void App::Run() {
     mainLoop();
 }
 
-void App::InitializePLY(const char* filename)
-{
-    auto splatSet = std::make_unique<SplatSet>();
-    if (!loadPly(filename, *splatSet)) {
-        std::cerr << "Failed to load PLY: " << filename << std::endl;
+void App::RunSortBenchmark(const SortBenchmarkOptions& options) {
+    ::RunSortBenchmark(*context_, *commandManager_, *uploadManager_, options);
+}
+
+App::InputStaging App::createInputStaging(size_t count, ProjectionPass::InputFormat format) {
+    using Format = ProjectionPass::InputFormat;
+    auto makeStaging = [&](vk::DeviceSize size) {
+        return std::make_unique<Buffer>(
+            Buffer::CreateHostVisible(*context_, vk::BufferUsageFlagBits::eTransferSrc, size));
+    };
+    auto streamBytes = [&](size_t floatsPerSplat) -> vk::DeviceSize {
+        switch (format) {
+        case Format::Float16:   return packedHalfBytes(floatsPerSplat * count);
+        case Format::Quantized: return sizeof(uint32_t) * count;
+        default:                return sizeof(float) * floatsPerSplat * count;
+        }
+    };
+
+    InputStaging staging;
+    staging.capacity  = count;
+    staging.format    = format;
+    staging.positions = makeStaging(format == Format::Quantized ? streamBytes(3) : sizeof(float) * 3 * count);
+    staging.sh        = makeStaging(streamBytes(3));
+    staging.opacity   = makeStaging(format == Format::Quantized ? sizeof(QuantizedChunk) * quantChunkCount(count)
+                                                                : streamBytes(1));
+    if (format == Format::Covariance) {
+        // rotation binding은 쓰이지 않지만 descriptor에 유효한 버퍼가 필요
+        staging.scale    = makeStaging(sizeof(float) * kCovarianceFloats * count);
+        staging.rotation = makeStaging(sizeof(uint32_t));
+    } else {
+        staging.scale    = makeStaging(streamBytes(3));
+        staging.rotation = makeStaging(streamBytes(4));
+    }
+    staging.clusters = makeStaging(4 * sizeof(float) * clusterCount(count));
+    return staging;
+}
+
+bool App::writeInputRows(const InputStaging& staging, const SplatView& splats,
+                         size_t first, size_t last) {
+    using Format = ProjectionPass::InputFormat;
+    auto mapped = [](const Buffer& buf) { return buf.GetMappedData(); };
+
+    if (staging.format == Format::Quantized) {
+        QuantizedTargets targets;
+        targets.chunks   = static_cast<QuantizedChunk*>(mapped(*staging.opacity));
+        targets.position = static_cast<uint32_t*>(mapped(*staging.positions));
+        targets.color    = static_cast<uint32_t*>(mapped(*staging.sh));
+        targets.scale    = static_cast<uint32_t*>(mapped(*staging.scale));
+        targets.rotation = static_cast<uint32_t*>(mapped(*staging.rotation));
+        return quantizeSplatRows(splats, first, last, targets);
+    }
+
+    auto write = [&](const Buffer& dst, const float* src, size_t width, bool halfStream) {
+        if (!src) return;
+        if (halfStream) {
+            packHalf(src + first * width,
+                     static_cast<uint16_t*>(mapped(dst)) + first * width,
+                     (last - first) * width, 0);
+        } else {
+            memcpy(static_cast<float*>(mapped(dst)) + first * width,
+                   src + first * width, (last - first) * width * sizeof(float));
+        }
+    };
+    const bool half = staging.format == Format::Float16;
+    write(*staging.positions, splats.positions, 3, false);
+    write(*staging.sh,        splats.f_dc,      3, half);
+    if (staging.format == Format::Covariance) {
+        return precomputeSplatRows(splats, first, last,
+                                   static_cast<float*>(mapped(*staging.scale)),
+                                   static_cast<float*>(mapped(*staging.opacity)));
+    }
+    write(*staging.opacity,   splats.opacity,   1, half);
+    write(*staging.scale,     splats.scale,     3, half);
+    write(*staging.rotation,  splats.rotation,  4, half);
+    return true;
+}
+
+void App::writeClusterBounds(const InputStaging& staging, const SplatView& splats,
+                             size_t first, size_t last) {
+    const size_t firstRow = first / kClusterRows * kClusterRows;
+    SplatView rows;
+    rows.count     = last - firstRow;
+    rows.positions = splats.positions + firstRow * 3;
+    rows.scale     = splats.scale ? splats.scale + firstRow * 3 : nullptr;
+    computeClusterBounds(rows, static_cast<float*>(staging.clusters->GetMappedData()) + first / kClusterRows * 4);
+}
+
+void App::enqueueInputRows(const InputStaging& staging, size_t first, size_t last) {
+    using Format = ProjectionPass::InputFormat;
+
+    // [begin, end) 바이트 구간 복사. 마지막 행까지면 word 정렬 패딩도 포함
+    auto enqueue = [&](const Buffer& src, const Buffer& dst, vk::DeviceSize begin, vk::DeviceSize end) {
+        if (last == staging.capacity) end = src.GetSize();
+        if (end > begin) uploadManager_->EnqueueCopy(src, dst, end - begin, begin, begin);
+    };
+    auto rows = [&](const Buffer& src, const Buffer& dst, vk::DeviceSize rowBytes) {
+        enqueue(src, dst, first * rowBytes, last * rowBytes);
+    };
+
+    switch (staging.format) {
+    case Format::Quantized:
+        rows(*staging.positions, *positionBuffer_, sizeof(uint32_t));
+        rows(*staging.sh,        *shBuffer_,       sizeof(uint32_t));
+        enqueue(*staging.opacity, *opacityBuffer_,
+                sizeof(QuantizedChunk) * (first / kQuantChunkSize),
+                sizeof(QuantizedChunk) * quantChunkCount(last));
+        rows(*staging.scale,     *scaleBuffer_,    sizeof(uint32_t));
+        rows(*staging.rotation,  *rotationBuffer_, sizeof(uint32_t));
+        break;
+    case Format::Covariance:
+        rows(*staging.positions, *positionBuffer_, 3 * sizeof(float));
+        rows(*staging.sh,        *shBuffer_,       3 * sizeof(float));
+        rows(*staging.opacity,   *opacityBuffer_,  1 * sizeof(float));
+        rows(*staging.scale,     *scaleBuffer_,    kCovarianceFloats * sizeof(float));
+        if (first == 0) enqueue(*staging.rotation, *rotationBuffer_, 0, staging.rotation->GetSize());
+        break;
+    case Format::Float16:
+        // 한 행이 half 홀수 개여도 복사는 바이트 단위라 청크 경계에서 word를 나눠 써도 됨
+        rows(*staging.positions, *positionBuffer_, 3 * sizeof(float));
+        rows(*staging.sh,        *shBuffer_,       3 * sizeof(uint16_t));
+        rows(*staging.opacity,   *opacityBuffer_,  1 * sizeof(uint16_t));
+        rows(*staging.scale,     *scaleBuffer_,    3 * sizeof(uint16_t));
+        rows(*staging.rotation,  *rotationBuffer_, 4 * sizeof(uint16_t));
+        break;
+    default:
+        rows(*staging.positions, *positionBuffer_, 3 * sizeof(float));
+        rows(*staging.sh,        *shBuffer_,       3 * sizeof(float));
+        rows(*staging.opacity,   *opacityBuffer_,  1 * sizeof(float));
+        rows(*staging.scale,     *scaleBuffer_,    3 * sizeof(float));
+        rows(*staging.rotation,  *rotationBuffer_, 4 * sizeof(float));
+        break;
+    }
+    // first가 속한 cluster부터 (writeClusterBounds가 경계 cluster를 다시 계산)
+    enqueue(*staging.clusters, *clusterBoundsBuffer_,
+            4 * sizeof(float) * (first / kClusterRows), 4 * sizeof(float) * clusterCount(last));
+}
+
+void App::ensureProjectionPass(ProjectionPass::InputFormat format, bool indexedInput) {
+    if (projPass_->GetInputFormat() == format && projPass_->IsIndexedInput() == indexedInput) {
         return;
     }
+    context_->Device().waitIdle();
+    projPass_ = std::make_unique<ProjectionPass>(
+        *context_, "Shaders/proj.comp.spv", CommandManager::FRAMES_IN_FLIGHT, format, indexedInput);
+}
 
-    gaussianCount_ = static_cast<uint32_t>(splatSet->size());
+void App::createInputBuffers(const InputStaging& staging) {
+    auto makeDevice = [&](const Buffer& src) {
+        return std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                src.GetSize()));
+    };
 
-    // ─── SOA 입력 버퍼 업로드 ───
-    positionBuffer_ = std::make_unique<Buffer>(
-        Buffer::CreateDeviceLocal(*context_,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            sizeof(float) * splatSet->positions.size(),
-            splatSet->positions.data()));
+    positionBuffer_ = makeDevice(*staging.positions);
+    shBuffer_       = makeDevice(*staging.sh);
+    opacityBuffer_  = makeDevice(*staging.opacity);
+    scaleBuffer_    = makeDevice(*staging.scale);
+    rotationBuffer_ = makeDevice(*staging.rotation);
+    clusterBoundsBuffer_ = makeDevice(*staging.clusters);
+}
 
-    shBuffer_ = std::make_unique<Buffer>(
-        Buffer::CreateDeviceLocal(*context_,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            sizeof(float) * splatSet->f_dc.size(),
-            splatSet->f_dc.data()));
+void App::uploadInputs(const InputStaging& staging) {
+    createInputBuffers(staging);
 
-    opacityBuffer_ = std::make_unique<Buffer>(
-        Buffer::CreateDeviceLocal(*context_,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            sizeof(float) * splatSet->opacity.size(),
-            splatSet->opacity.data()));
+    // 5개 복사를 하나의 submit으로 묶고, 그 제출의 timeline 값만 대기 (staging 해제 전)
+    enqueueInputRows(staging, 0, staging.capacity);
+    uploadManager_->Wait(uploadManager_->Flush());
+}
 
-    scaleBuffer_ = std::make_unique<Buffer>(
-        Buffer::CreateDeviceLocal(*context_,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            sizeof(float) * splatSet->scale.size(),
-            splatSet->scale.data()));
+bool App::createFrameResources(size_t capacity) {
+    // raster는 projected2D segment 수만큼의 descriptor 배열로 특수화됨. 한도를 넘는 장면은 로드하지 않음
+    const vk::PhysicalDeviceLimits limits = context_->PhysicalDevice().getProperties().limits;
+    const uint64_t rasterSegments = RasterPass::SegmentCount(limits, capacity);
+    if (rasterSegments > RasterPass::MaxSegments(limits)) {
+        std::cerr << "Scene needs " << rasterSegments << " projected storage buffer ranges, device allows "
+                  << RasterPass::MaxSegments(limits) << " (" << capacity << " splats)" << std::endl;
+        return false;
+    }
+    if (rastPass_->GetProjectedSegments() != rasterSegments) {
+        context_->Device().waitIdle();
+        rastPass_ = std::make_unique<RasterPass>(*context_, "Shaders/rast.comp.spv",
+                                                 CommandManager::FRAMES_IN_FLIGHT,
+                                                 static_cast<uint32_t>(rasterSegments));
+    }
 
-    rotationBuffer_ = std::make_unique<Buffer>(
-        Buffer::CreateDeviceLocal(*context_,
-            vk::BufferUsageFlagBits::eStorageBuffer,
-            sizeof(float) * splatSet->rotation.size(),
-            splatSet->rotation.data()));
+    frameCapacity_ = capacity;
 
     // ─── Per-frame 출력 버퍼 (빈 device-local) ───
     for (uint32_t i = 0; i < CommandManager::FRAMES_IN_FLIGHT; i++) {
         projected2DBuffers_[i] = std::make_unique<Buffer>(
             Buffer::CreateDeviceLocal(*context_,
                 vk::BufferUsageFlagBits::eStorageBuffer,
-                GAUSSIAN_2D_STRIDE * gaussianCount_));
+                ProjectionPass::GAUSSIAN_2D_STRIDE * capacity));
 
+        // cluster culling이면 projection 전에 0으로 채움 (건너뛴 cluster의 행)
         visibilityBuffers_[i] = std::make_unique<Buffer>(
             Buffer::CreateDeviceLocal(*context_,
-                vk::BufferUsageFlagBits::eStorageBuffer,
-                sizeof(uint32_t) * gaussianCount_));
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                sizeof(uint32_t) * capacity));
 
         tileCountBuffers_[i] = std::make_unique<Buffer>(
             Buffer::CreateDeviceLocal(*context_,
-                vk::BufferUsageFlagBits::eStorageBuffer,
-                sizeof(uint32_t) * gaussianCount_));
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                sizeof(uint32_t) * capacity));
+
+        // ─── Cluster culling: 보이는 cluster 목록 + segment별 dispatch 인자 ───
+        visibleClusterBuffers_[i].reset();
+        dispatchArgsBuffers_[i].reset();
+        if (clusterCulling_ && clusterBoundsBuffer_ && !projPass_->IsIndexedInput()) {
+            const uint64_t segmentCount = std::max<uint64_t>(
+                1, (capacity + projPass_->GetSegmentSize() - 1) / projPass_->GetSegmentSize());
+            visibleClusterBuffers_[i] = std::make_unique<Buffer>(
+                Buffer::CreateDeviceLocal(*context_,
+                    vk::BufferUsageFlagBits::eStorageBuffer,
+                    sizeof(uint32_t) * clusterCount(capacity)));
+            dispatchArgsBuffers_[i] = std::make_unique<Buffer>(
+                Buffer::CreateDeviceLocal(*context_,
+                    vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
+                    vk::BufferUsageFlagBits::eTransferDst,
+                    ClusterCullPass::DISPATCH_ARGS_STRIDE * segmentCount));
+        }
     }
 
     // ─── Per-frame descriptor update ───
     for (uint32_t i = 0; i < CommandManager::FRAMES_IN_FLIGHT; i++) {
+        const bool culled = visibleClusterBuffers_[i] != nullptr;
         ProjectionPass::Buffers buffers{
             positionBuffer_->GetHandle(),
             shBuffer_->GetHandle(),
@@ -191,6 +374,10 @@ void App::InitializePLY(const char* filename)
             projected2DBuffers_[i]->GetHandle(),
             visibilityBuffers_[i]->GetHandle(),
             tileCountBuffers_[i]->GetHandle(),
+            lodRowBuffers_[i] ? lodRowBuffers_[i]->GetHandle() : vk::Buffer{},
+            culled ? clusterBoundsBuffer_->GetHandle() : vk::Buffer{},
+            culled ? visibleClusterBuffers_[i]->GetHandle() : vk::Buffer{},
+            culled ? dispatchArgsBuffers_[i]->GetHandle() : vk::Buffer{},
         };
         ProjectionPass::BufferSizes sizes{
             positionBuffer_->GetSize(),
@@ -201,14 +388,630 @@ void App::InitializePLY(const char* filename)
             projected2DBuffers_[i]->GetSize(),
             visibilityBuffers_[i]->GetSize(),
             tileCountBuffers_[i]->GetSize(),
+            lodRowBuffers_[i] ? lodRowBuffers_[i]->GetSize() : 0,
+            culled ? clusterBoundsBuffer_->GetSize() : 0,
+            culled ? visibleClusterBuffers_[i]->GetSize() : 0,
+            culled ? dispatchArgsBuffers_[i]->GetSize() : 0,
         };
         projPass_->UpdateDescriptors(*context_, i,
                                      uboDevice_[i]->GetHandle(),
                                      uboDevice_[i]->GetSize(),
-                                     buffers, sizes);
+                                     buffers, sizes, capacity);
+    }
+
+    // ─── Tile binning + 정렬: 키 버퍼는 splat 수만큼으로 시작, 부족하면 growTileKeyBuffers ───
+    for (uint32_t i = 0; i < CommandManager::FRAMES_IN_FLIGHT; i++) {
+        TileKeyBuffers& tiles = tileKeyBuffers_[i];
+        tiles = {};
+        tiles.blockOffsets = std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                BinningPass::BlockOffsetBytes(capacity)));
+        tiles.keyCount = std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                sizeof(uint32_t)));
+        tiles.stats = std::make_unique<Buffer>(
+            Buffer::CreateHostVisible(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                sizeof(uint32_t)));
+        const uint32_t noKeys = 0;
+        tiles.stats->Upload(&noKeys, sizeof(noKeys));
+
+        createTileKeyBuffers(i, std::min(maxTileKeys(), std::max<uint64_t>(MIN_TILE_KEYS, capacity)));
+    }
+}
+
+uint64_t App::maxTileKeys() const {
+    const vk::DeviceSize maxRange = context_->PhysicalDevice().getProperties().limits.maxStorageBufferRange;
+    return std::min<uint64_t>(std::numeric_limits<uint32_t>::max(), maxRange / (2 * sizeof(uint32_t)));
+}
+
+void App::createTileKeyBuffers(uint32_t frame, uint64_t keyCapacity) {
+    // 이 슬롯은 fence 대기 후라 사용 중이 아님. 새로 할당하기 전에 이전 버퍼를 먼저 놓음
+    TileKeyBuffers& tiles = tileKeyBuffers_[frame];
+    for (auto& buf : tiles.keys) buf.reset();
+    for (auto& buf : tiles.values) buf.reset();
+    tiles.histograms.reset();
+    tiles.keyCapacity = keyCapacity;
+
+    for (uint32_t k = 0; k < 2; k++) {
+        tiles.keys[k] = std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                2 * sizeof(uint32_t) * keyCapacity));
+        tiles.values[k] = std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer,
+                sizeof(uint32_t) * keyCapacity));
+    }
+    tiles.histograms = std::make_unique<Buffer>(
+        Buffer::CreateDeviceLocal(*context_,
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+            SortPass::HistogramBytes(keyCapacity)));
+
+    BinningPass::Buffers binBuffers{
+        projected2DBuffers_[frame]->GetHandle(),
+        tileCountBuffers_[frame]->GetHandle(),
+        tiles.blockOffsets->GetHandle(),
+        tiles.keys[0]->GetHandle(),
+        tiles.values[0]->GetHandle(),
+        tiles.keyCount->GetHandle(),
+        tiles.stats->GetHandle(),
+    };
+    binPass_->UpdateDescriptors(*context_, frame, binBuffers, frameCapacity_, keyCapacity);
+
+    SortPass::Buffers sortBuffers{
+        {tiles.keys[0]->GetHandle(), tiles.keys[1]->GetHandle()},
+        {tiles.values[0]->GetHandle(), tiles.values[1]->GetHandle()},
+        tiles.keyCount->GetHandle(),
+        tiles.histograms->GetHandle(),
+    };
+    sortPass_->UpdateDescriptors(*context_, frame, sortBuffers, keyCapacity);
+
+    createScreenResources(frame);
+}
+
+void App::createScreenResources(uint32_t frame) {
+    const vk::Extent2D grid = TileRangePass::TileGrid(swapchain_->GetExtent());
+    const uint32_t tileCount = grid.width * grid.height;
+    tileRangeBuffers_[frame] = std::make_unique<Buffer>(
+        Buffer::CreateDeviceLocal(*context_,
+            vk::BufferUsageFlagBits::eStorageBuffer,
+            2 * sizeof(uint32_t) * tileCount));
+
+    const TileKeyBuffers& tiles = tileKeyBuffers_[frame];
+    TileRangePass::Buffers buffers{
+        {tiles.keys[0]->GetHandle(), tiles.keys[1]->GetHandle()},
+        tiles.keyCount->GetHandle(),
+        tileRangeBuffers_[frame]->GetHandle(),
+    };
+    rangePass_->UpdateDescriptors(*context_, frame, buffers, tiles.keyCapacity, tileCount);
+
+    // ─── Raster: swapchain에 직접 쓰지 못하면 화면 크기 출력 이미지 (TRANSFER_SRC: 복사 / blit) ───
+    // 출력 대상은 Renderer가 매 프레임 RasterPass::SetTarget으로 지정
+    rasterImages_[frame].reset();
+    if (renderer_->GetPresentPath() != Renderer::PresentPath::Direct) {
+        rasterImages_[frame] = std::make_unique<Image>(
+            Image::CreateDeviceLocal(*context_, RasterPass::OUTPUT_FORMAT, swapchain_->GetExtent(),
+                vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eTransferSrc));
+    }
+
+    RasterPass::Buffers rasterBuffers{
+        projected2DBuffers_[frame]->GetHandle(),
+        {tiles.values[0]->GetHandle(), tiles.values[1]->GetHandle()},
+        tileRangeBuffers_[frame]->GetHandle(),
+    };
+    RasterPass::BufferSizes rasterSizes{
+        projected2DBuffers_[frame]->GetSize(),
+        tiles.values[0]->GetSize(),
+        tileRangeBuffers_[frame]->GetSize(),
+    };
+    rastPass_->UpdateDescriptors(*context_, frame, rasterBuffers, rasterSizes);
+}
+
+void App::growTileKeyBuffers(uint32_t frame) {
+    TileKeyBuffers& tiles = tileKeyBuffers_[frame];
+    const uint64_t required = *static_cast<const uint32_t*>(tiles.stats->GetMappedData());
+    const uint64_t maxKeys  = maxTileKeys();
+    if (required <= tiles.keyCapacity || tiles.keyCapacity >= maxKeys) {
+        return;
+    }
+    // 카메라가 조금씩 움직여도 매번 다시 할당하지 않도록 1.5배 여유
+    const uint64_t keyCapacity = std::min(maxKeys, required + required / 2);
+    std::cout << "Tile keys (frame " << frame << "): " << required << " needed, capacity "
+              << tiles.keyCapacity << " -> " << keyCapacity << std::endl;
+    createTileKeyBuffers(frame, keyCapacity);
+}
+
+void App::InitializePLY(const char* filename, const SceneLoadOptions& options)
+{
+    streamer_.reset();
+    lodCut_.reset();
+    for (auto& buf : lodRowBuffers_) buf.reset();
+    clusterBoundsBuffer_.reset();
+    clusterCulling_ = options.clusterCulling;
+
+    // 이미 양자화된 장면(.gsq, PlayCanvas compressed.ply)은 변환 없이 Quantized로 업로드
+    if (std::filesystem::path(filename).extension() == ".gsq" || isCompressedPly(filename)) {
+        loadQuantizedScene(filename, options.ply);
+        return;
+    }
+    // .gsc 또는 --stream: 장면 전체 대신 보이는 chunk만 고정 크기 pool에 올림
+    if (options.streaming || isChunkedScene(filename)) {
+        loadStreamingScene(filename, options);
+        return;
+    }
+    // .gsl 또는 --lod: 병합 계층 전체를 올리고 매 프레임 화면 크기로 고른 cut만 projection
+    if (options.lod || isLodScene(filename)) {
+        loadLodScene(filename, options);
+        return;
+    }
+    // .splat은 스트리밍 리더가 없고, prune / Morton 재배열은 전체 행이 필요하므로 동기 경로로 읽음
+    const bool splatFile = isSplatFile(filename);
+    const bool reorder   = options.prune || options.mortonOrder;
+    if (options.async && !splatFile && !reorder) {
+        startAsyncLoad(filename, options);
+        return;
+    }
+
+    // 로드 경로 (모두 헤더 크기만큼의 매핑된 staging 버퍼로 귀결):
+    //   1) 유효한 .gsbin 캐시 → 매핑 후 staging으로 memcpy
+    //   2) 캐시 기록/호스트 사본/형식 변환 필요 → SplatSet으로 파싱, 캐시 기록 후 staging으로 memcpy
+    //   3) 그 외 → loadPly가 staging 메모리에 직접 기록 (호스트 사본 없음)
+    // inputFormat이 Float32가 아니면 staging에 기록할 때 fp16 패킹 / 청크 양자화
+    // prune / mortonOrder면 1), 2)에서 staging에 기록하기 전에 제거·재배열 (3은 사용 안 함)
+    const std::filesystem::path cachePath = splatCachePath(filename);
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    std::unique_ptr<SplatCache> cache;
+    if (options.useCache) {
+        cache = std::make_unique<SplatCache>(cachePath, filename);
+        if (cache->valid() && !cache->coversShDegree(options.ply.maxShDegree, filename)) {
+            std::cout << "Splat cache has fewer SH bands than requested, rebuilding: "
+                      << cachePath.string() << std::endl;
+            cache.reset();
+        }
+    }
+
+    std::unique_ptr<SplatSet> splatSet;
+    InputStaging staging;
+    size_t count = 0;
+
+    auto copyIntoStaging = [&](const SplatView& splats) {
+        count   = splats.count;
+        staging = createInputStaging(count, options.inputFormat);
+        writeClusterBounds(staging, splats, 0, count);
+        return writeInputRows(staging, splats, 0, count);
+    };
+
+    if (cache && cache->valid()) {
+        // mortonOrder: 매핑에서 재배열된 사본으로 바로 gather (캐시는 파일 순서 유지)
+        // prune: 매핑 전체를 사본으로 복사한 뒤 제거·재배열
+        SplatView splats = cache->view();
+        if (shRestFloatsForDegree(splats.fRestPerSplat, options.ply.maxShDegree) == 0) {
+            // 캐시에 SH band가 더 있어도 재배열 / 호스트 사본으로 가져오지 않음
+            splats.f_rest        = nullptr;
+            splats.fRestPerSplat = 0;
+        }
+        SplatSet ordered;
+        if (options.prune) {
+            std::vector<uint32_t> identity(splats.count);
+            for (size_t i = 0; i < identity.size(); ++i) {
+                identity[i] = static_cast<uint32_t>(i);
+            }
+            permuteSplats(splats, identity, ordered, options.ply.threadCount);
+            reorderSceneRows(ordered, options);
+            splats = ordered.view();
+        } else if (options.mortonOrder) {
+            const std::vector<uint32_t> order = mortonOrder(splats, options.mortonPrecision,
+                                                            options.ply.threadCount);
+            permuteSplats(splats, order, ordered, options.ply.threadCount);
+            splats = ordered.view();
+        }
+        if (!copyIntoStaging(splats)) {
+            std::cerr << "Failed to convert splat cache: " << cachePath.string() << std::endl;
+            return;
+        }
+        auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Splat cache mapped: " << splats.count << " splats in " << loadTime << "ms" << std::endl;
+
+        if (options.retainHostCopy && reorder) {
+            splatSet = std::make_unique<SplatSet>(std::move(ordered));
+            splatSet->truncateShDegree(options.ply.maxShDegree);
+        } else if (options.retainHostCopy) {
+            const size_t n = splats.count;
+            splatSet = std::make_unique<SplatSet>();
+            splatSet->positions.assign(splats.positions, splats.positions + n * 3);
+            splatSet->f_dc.assign(splats.f_dc, splats.f_dc + n * 3);
+            splatSet->f_rest.assign(splats.f_rest, splats.f_rest + n * splats.fRestPerSplat);
+            splatSet->opacity.assign(splats.opacity, splats.opacity + n);
+            splatSet->scale.assign(splats.scale, splats.scale + n * 3);
+            splatSet->rotation.assign(splats.rotation, splats.rotation + n * 4);
+            splatSet->truncateShDegree(options.ply.maxShDegree);
+        }
+    } else if (options.useCache || options.retainHostCopy || splatFile || reorder ||
+               options.inputFormat != ProjectionPass::InputFormat::Float32) {
+        splatSet = std::make_unique<SplatSet>();
+        if (!loadSplatScene(filename, *splatSet, options.ply)) {
+            std::cerr << "Failed to load PLY: " << filename << std::endl;
+            return;
+        }
+        if (options.useCache && writeSplatCache(cachePath, *splatSet, filename)) {
+            std::cout << "Splat cache written: " << cachePath.string() << std::endl;
+        }
+        if (reorder) {
+            reorderSceneRows(*splatSet, options);
+        }
+        if (!copyIntoStaging(splatSet->view())) {
+            std::cerr << "Failed to convert PLY: " << filename << std::endl;
+            return;
+        }
+    } else {
+        // f_rest는 아직 업로드하지 않으므로 target을 두지 않아 추출 자체를 생략
+        bool hasScale = false;
+        bool loaded = loadPly(filename, [&](const PlyInfo& info, SplatTargets& targets) {
+            count    = info.count;
+            hasScale = info.hasScale;
+            staging = createInputStaging(count, ProjectionPass::InputFormat::Float32);
+            auto target = [](const Buffer& buf, bool present) {
+                return present ? static_cast<float*>(buf.GetMappedData()) : nullptr;
+            };
+            targets.positions = target(*staging.positions, info.hasPositions);
+            targets.f_dc      = target(*staging.sh,        info.hasFDc);
+            targets.opacity   = target(*staging.opacity,   info.hasOpacity);
+            targets.scale     = target(*staging.scale,     info.hasScale);
+            targets.rotation  = target(*staging.rotation,  info.hasRotation);
+            return true;
+        }, options.ply);
+        if (!loaded) {
+            std::cerr << "Failed to load PLY: " << filename << std::endl;
+            return;
+        }
+        SplatView rows;
+        rows.count     = count;
+        rows.positions = static_cast<const float*>(staging.positions->GetMappedData());
+        rows.scale     = hasScale ? static_cast<const float*>(staging.scale->GetMappedData()) : nullptr;
+        writeClusterBounds(staging, rows, 0, count);
+    }
+
+    // 업로드 전에 호스트 사본을 먼저 놓아 peak RSS를 낮춤
+    cache.reset();
+    if (!options.retainHostCopy) {
+        splatSet.reset();
+    }
+    gaussianCount_ = count;
+
+    // ─── SOA 입력 버퍼 업로드 (staging은 이 함수 끝에서 해제) ───
+    uploadInputs(staging);
+
+    // ─── Per-frame 출력 버퍼 + descriptor ───
+    ensureProjectionPass(staging.format);
+    if (!createFrameResources(gaussianCount_)) {
+        gaussianCount_ = 0;
+        return;
+    }
+
+    if (options.retainHostCopy) {
+        splatSet_ = std::move(splatSet);
+    }
+}
+
+void App::reorderSceneRows(SplatSet& splats, const SceneLoadOptions& options) {
+    if (options.prune) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        PruneOptions prune = options.pruneOptions;
+        if (prune.threadCount == 0) {
+            prune.threadCount = options.ply.threadCount;
+        }
+        PruneStats stats;
+        pruneSplats(splats, prune, stats);
+        auto pruneTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        printPruneStats(stats);
+        std::cout << "Prune pass: " << pruneTime << "ms" << std::endl;
+    }
+    if (options.mortonOrder) {
+        reorderMorton(splats, options.mortonPrecision, options.ply.threadCount);
+    }
+}
+
+bool App::loadQuantizedScene(const std::filesystem::path& path, const PlyLoadOptions& ply) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    QuantizedSplatSet quantized;
+    const bool loaded = path.extension() == ".gsq" ? readQuantizedSplats(path, quantized)
+                                                   : loadCompressedPly(path, quantized, ply);
+    if (!loaded) {
+        std::cerr << "Failed to load quantized scene: " << path.string() << std::endl;
+        return false;
+    }
+
+    // 파일 배열이 곧 GPU 레이아웃 → 변환 없이 staging으로 복사
+    InputStaging staging = createInputStaging(quantized.size(), ProjectionPass::InputFormat::Quantized);
+    auto copy = [](const Buffer& dst, const auto& src) {
+        memcpy(dst.GetMappedData(), src.data(), src.size() * sizeof(src[0]));
+    };
+    copy(*staging.opacity,   quantized.chunks);
+    copy(*staging.positions, quantized.position);
+    copy(*staging.sh,        quantized.color);
+    copy(*staging.scale,     quantized.scale);
+    copy(*staging.rotation,  quantized.rotation);
+    computeClusterBounds(quantized, static_cast<float*>(staging.clusters->GetMappedData()));
+    gaussianCount_ = quantized.size();
+
+    uploadInputs(staging);
+    ensureProjectionPass(staging.format);
+    if (!createFrameResources(gaussianCount_)) {
+        gaussianCount_ = 0;
+        return false;
+    }
+
+    auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "Quantized scene loaded: " << quantized.size() << " splats, "
+              << quantized.byteSize() / (1024 * 1024) << " MiB in " << loadTime << "ms" << std::endl;
+    return true;
+}
+
+bool App::loadStreamingScene(const std::filesystem::path& path, const SceneLoadOptions& options) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // .gsc를 직접 받으면 그대로, 아니면 원본 옆의 .gsc (없거나 오래됐으면 Morton 순서로 생성)
+    std::unique_ptr<ChunkedScene> scene;
+    if (isChunkedScene(path)) {
+        scene = std::make_unique<ChunkedScene>(path, std::filesystem::path());
+    } else {
+        const std::filesystem::path chunkedPath = chunkedScenePath(path);
+        scene = std::make_unique<ChunkedScene>(chunkedPath, path);
+        if (!scene->valid()) {
+            SplatSet splats;
+            if (!loadSplatScene(path, splats, options.ply)) {
+                std::cerr << "Failed to load PLY: " << path.string() << std::endl;
+                return false;
+            }
+            reorderMorton(splats, options.mortonPrecision, options.ply.threadCount);
+            if (!writeChunkedScene(chunkedPath, splats, path, kDefaultSceneChunkRows, options.ply.threadCount)) {
+                return false;
+            }
+            std::cout << "Chunked scene written: " << chunkedPath.string() << std::endl;
+            scene = std::make_unique<ChunkedScene>(chunkedPath, path);
+        }
+    }
+    if (!scene->valid()) {
+        std::cerr << "Failed to open chunked scene: " << path.string() << std::endl;
+        return false;
+    }
+
+    // pool은 Float32 입력 형식 (chunk block을 변환 없이 그대로 복사)
+    ensureProjectionPass(ProjectionPass::InputFormat::Float32);
+    const uint32_t slots   = SceneStreamer::PoolSlots(*scene, options.stream);
+    const size_t capacity  = static_cast<size_t>(slots) * scene->chunkRows();
+    auto makePool = [&](vk::DeviceSize bytesPerSplat) {
+        return std::make_unique<Buffer>(
+            Buffer::CreateDeviceLocal(*context_,
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst,
+                bytesPerSplat * capacity));
+    };
+    positionBuffer_ = makePool(3 * sizeof(float));
+    shBuffer_       = makePool(3 * sizeof(float));
+    opacityBuffer_  = makePool(1 * sizeof(float));
+    scaleBuffer_    = makePool(3 * sizeof(float));
+    rotationBuffer_ = makePool(4 * sizeof(float));
+    if (!createFrameResources(capacity)) {
+        return false;
+    }
+
+    const size_t sceneRows  = scene->size();
+    const size_t chunkCount = scene->chunkCount();
+    SceneStreamer::Targets targets{positionBuffer_.get(), shBuffer_.get(), opacityBuffer_.get(),
+                                   scaleBuffer_.get(), rotationBuffer_.get()};
+    streamer_ = std::make_unique<SceneStreamer>(*uploadManager_, std::move(scene), targets, options.stream,
+                                                CommandManager::FRAMES_IN_FLIGHT);
+    gaussianCount_ = 0;
+
+    auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "Streaming scene: " << sceneRows << " splats in " << chunkCount << " chunks, GPU pool "
+              << slots << " chunks (" << capacity * kChunkBaseFloats * sizeof(float) / (1024 * 1024)
+              << " MiB), opened in " << loadTime << "ms" << std::endl;
+    return true;
+}
+
+bool App::loadLodScene(const std::filesystem::path& path, const SceneLoadOptions& options) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // .gsl을 직접 받으면 그대로, 아니면 원본 옆의 .gsl (없거나 오래됐으면 prune/Morton 후 계층 생성)
+    std::unique_ptr<LodScene> scene;
+    if (isLodScene(path)) {
+        scene = std::make_unique<LodScene>(path, std::filesystem::path());
+    } else {
+        const std::filesystem::path lodPath = lodScenePath(path);
+        scene = std::make_unique<LodScene>(lodPath, path);
+        if (!scene->valid()) {
+            SplatSet splats;
+            if (!loadSplatScene(path, splats, options.ply)) {
+                std::cerr << "Failed to load PLY: " << path.string() << std::endl;
+                return false;
+            }
+            // 계층은 연속한 행을 묶으므로 Morton 순서가 필요
+            SceneLoadOptions order = options;
+            order.mortonOrder = true;
+            reorderSceneRows(splats, order);
+
+            const size_t leafCount = splats.size();
+            std::vector<LodNode> nodes;
+            LodOptions lodOptions;
+            lodOptions.threadCount = options.ply.threadCount;
+            if (!buildLodHierarchy(splats, nodes, lodOptions) ||
+                !writeLodScene(lodPath, splats, leafCount, nodes, path)) {
+                return false;
+            }
+            std::cout << "LOD scene written: " << lodPath.string() << std::endl;
+            scene = std::make_unique<LodScene>(lodPath, path);
+        }
+    }
+    if (!scene->valid()) {
+        std::cerr << "Failed to open LOD scene: " << path.string() << std::endl;
+        return false;
     }
 
-    splatSet_ = std::move(splatSet);
+    // cut은 어느 행이든 고를 수 있어 입력 버퍼를 segment 없이 전체 binding (rotation이 가장 큼)
+    const SplatView& rows = scene->view();
+    const vk::DeviceSize maxRange = context_->PhysicalDevice().getProperties().limits.maxStorageBufferRange;
+    if (rows.count * 4 * sizeof(float) > maxRange) {
+        std::cerr << "LOD scene does not fit one storage buffer binding (" << rows.count << " rows)" << std::endl;
+        return false;
+    }
+    InputStaging staging = createInputStaging(rows.count, ProjectionPass::InputFormat::Float32);
+    if (!writeInputRows(staging, rows, 0, rows.count)) {
+        std::cerr << "Failed to convert LOD scene: " << path.string() << std::endl;
+        return false;
+    }
+    uploadInputs(staging);
+    clusterBoundsBuffer_.reset();  // cut 행은 연속한 cluster가 아니므로 culling 없음
+    ensureProjectionPass(ProjectionPass::InputFormat::Float32, true);
+
+    // 출력 버퍼는 장면 크기가 아니라 cut 용량만큼
+    LodCut::Options cutOptions = options.lodCut;
+    if (cutOptions.threadCount == 0) {
+        cutOptions.threadCount = options.ply.threadCount;
+    }
+    lodCut_ = std::make_unique<LodCut>(
+        std::vector<LodNode>(scene->nodes(), scene->nodes() + scene->nodeCount()), scene->leafCount(), cutOptions);
+    for (auto& buf : lodRowBuffers_) {
+        buf = std::make_unique<Buffer>(
+            Buffer::CreateHostVisible(*context_, vk::BufferUsageFlagBits::eStorageBuffer,
+                                      sizeof(uint32_t) * lodCut_->GetCapacity()));
+    }
+    lodRowVersions_.fill(0);
+    gaussianCount_ = 0;
+    if (!createFrameResources(lodCut_->GetCapacity())) {
+        lodCut_.reset();
+        return false;
+    }
+
+    auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    std::cout << "LOD scene loaded: " << scene->leafCount() << " splats + " << scene->nodeCount()
+              << " merged nodes, cut budget " << cutOptions.budget << " in " << loadTime << "ms" << std::endl;
+    return true;
+}
+
+void App::startAsyncLoad(const char* filename, const SceneLoadOptions& options) {
+    AsyncLoadOptions loadOptions;
+    loadOptions.useCache       = options.useCache;
+    loadOptions.retainHostCopy = options.retainHostCopy;
+    loadOptions.chunkRows      = options.chunkRows;
+    loadOptions.ply            = options.ply;
+    if (options.inputFormat == ProjectionPass::InputFormat::Quantized) {
+        // 청크마다 독립적으로 양자화하도록 공개 단위를 256개 청크 경계에 맞춤
+        loadOptions.chunkRows = (options.chunkRows + kQuantChunkSize - 1) / kQuantChunkSize * kQuantChunkSize;
+    }
+
+    // 헤더(또는 캐시)만 읽어 개수를 알아낸 뒤 모든 버퍼를 최종 크기로 미리 할당
+    PlyInfo info;
+    std::unique_ptr<SplatCache> cache = peekSplatCount(filename, loadOptions, info);
+    if (info.count == 0) {
+        std::cerr << "Failed to load PLY: " << filename << std::endl;
+        return;
+    }
+
+    sceneStaging_ = createInputStaging(info.count, options.inputFormat);
+    createInputBuffers(sceneStaging_);
+    ensureProjectionPass(options.inputFormat);
+    if (!createFrameResources(info.count)) {
+        sceneStaging_ = {};
+        return;
+    }
+
+    // f_rest는 아직 업로드하지 않으므로 target 없음
+    SplatTargets targets;
+    if (options.inputFormat == ProjectionPass::InputFormat::Float32) {
+        targets.positions = static_cast<float*>(sceneStaging_.positions->GetMappedData());
+        targets.f_dc      = static_cast<float*>(sceneStaging_.sh->GetMappedData());
+        targets.opacity   = static_cast<float*>(sceneStaging_.opacity->GetMappedData());
+        targets.scale     = static_cast<float*>(sceneStaging_.scale->GetMappedData());
+        targets.rotation  = static_cast<float*>(sceneStaging_.rotation->GetMappedData());
+    } else {
+        // 로더는 fp32로만 기록 → scratch에 받아 pumpSceneLoader에서 청크마다 변환.
+        // fp16은 positions가 그대로 fp32이므로 staging에 직접 기록
+        auto& scratch = sceneStaging_.scratch;
+        scratch = std::make_unique<SplatSet>();
+        scratch->f_dc.resize(info.count * 3);
+        scratch->opacity.resize(info.count);
+        scratch->scale.resize(info.count * 3);
+        scratch->rotation.resize(info.count * 4);
+        if (options.inputFormat == ProjectionPass::InputFormat::Quantized) {
+            scratch->positions.resize(info.count * 3);
+            targets.positions = scratch->positions.data();
+        } else {
+            targets.positions = static_cast<float*>(sceneStaging_.positions->GetMappedData());
+        }
+        targets.f_dc     = scratch->f_dc.data();
+        targets.opacity  = scratch->opacity.data();
+        targets.scale    = scratch->scale.data();
+        targets.rotation = scratch->rotation.data();
+    }
+
+    gaussianCount_ = 0;
+    streamedRows_.clear();
+    sceneLoader_ = std::make_unique<AsyncSplatLoader>(filename, targets, info.count,
+                                                      loadOptions, std::move(cache));
+}
+
+void App::pumpSceneLoader() {
+    if (sceneLoader_) {
+        // 도착한 청크를 transfer 큐로 한 번에 제출 (렌더링과 겹쳐 실행)
+        SplatChunk chunk;
+        size_t lastRow = 0;
+        while (sceneLoader_->popChunk(chunk)) {
+            // cluster bounds는 fp32 positions / scale에서: scratch에 있으면 거기서, 아니면 staging
+            SplatView fp32;
+            fp32.count     = sceneStaging_.capacity;
+            fp32.positions = static_cast<const float*>(sceneStaging_.positions->GetMappedData());
+            fp32.scale     = static_cast<const float*>(sceneStaging_.scale->GetMappedData());
+            if (const SplatSet* scratch = sceneStaging_.scratch.get()) {
+                SplatView rows;
+                rows.count     = sceneStaging_.capacity;
+                rows.positions = scratch->positions.empty() ? nullptr : scratch->positions.data();
+                rows.f_dc      = scratch->f_dc.data();
+                rows.opacity   = scratch->opacity.data();
+                rows.scale     = scratch->scale.data();
+                rows.rotation  = scratch->rotation.data();
+                writeInputRows(sceneStaging_, rows, chunk.firstRow, chunk.lastRow);
+                if (rows.positions) fp32.positions = rows.positions;
+                fp32.scale = rows.scale;
+            }
+            writeClusterBounds(sceneStaging_, fp32, chunk.firstRow, chunk.lastRow);
+            enqueueInputRows(sceneStaging_, chunk.firstRow, chunk.lastRow);
+            lastRow = chunk.lastRow;
+        }
+        if (lastRow > 0) {
+            streamedRows_.push_back({uploadManager_->Flush(), lastRow});
+        }
+
+        if (sceneLoader_->finished()) {
+            if (!sceneLoader_->succeeded()) {
+                std::cerr << "Scene load incomplete" << std::endl;
+            } else if (auto hostCopy = sceneLoader_->takeHostCopy()) {
+                splatSet_ = std::move(hostCopy);
+            }
+            sceneLoader_.reset();
+        }
+    }
+
+    // 전송이 끝난 행만 그림 → 프레임이 진행 중인 전송을 기다리지 않음
+    while (!streamedRows_.empty() && uploadManager_->IsComplete(streamedRows_.front().ticket)) {
+        gaussianCount_ = streamedRows_.front().lastRow;
+        streamedRows_.pop_front();
+    }
+
+    // 로더 종료 + 모든 전송 완료 → staging 해제
+    if (!sceneLoader_ && streamedRows_.empty()) {
+        sceneStaging_ = {};
+    }
 }
 
 void App::mainLoop() {
@@ -225,26 +1028,70 @@ void App::mainLoop() {
 
         // Wait for current frame's fence before writing UBO
         renderer_->WaitForCurrentFrame(*context_);
+        if (timingLog_) {
+            logPassTimings();
+        }
 
         // Update camera UBO for current frame (safe: fence guarantees GPU is done)
         uint32_t frameIdx = renderer_->GetCurrentFrame();
         CameraUBOData uboData = camera_.GetUBOData();
         uboStaging_[frameIdx]->Upload(&uboData, sizeof(uboData));
 
+        // Async load: 새 청크를 transfer 큐로 제출, 전송 끝난 행까지 gaussianCount_ 증가
+        if (sceneStaging_.positions) {
+            pumpSceneLoader();
+        }
+        // Streaming: 완료된 chunk 반영 + 보이는 chunk 읽기 요청, 채워진 slot까지 dispatch
+        if (streamer_) {
+            streamer_->Update(uboData);
+            gaussianCount_ = streamer_->GetActiveRows();
+        }
+        // LOD: 카메라가 바뀌면 cut을 다시 고르고, 이 프레임의 행 버퍼가 이전 cut이면 갱신
+        if (lodCut_) {
+            lodCut_->Update(uboData);
+            if (lodRowVersions_[frameIdx] != lodCut_->GetVersion()) {
+                const std::vector<uint32_t>& rows = lodCut_->GetRows();
+                lodRowBuffers_[frameIdx]->Upload(rows.data(), rows.size() * sizeof(uint32_t));
+                lodRowVersions_[frameIdx] = lodCut_->GetVersion();
+            }
+            gaussianCount_ = lodCut_->GetRows().size();
+        }
+
         // Set up projection pass for current frame
         if (gaussianCount_ > 0) {
             projPass_->SetFrameIndex(frameIdx);
 
-            uint32_t tileWidth  = (swapchain_->GetExtent().width  + 15) / 16;
-            uint32_t tileHeight = (swapchain_->GetExtent().height + 15) / 16;
-            projPass_->SetPushConstants({gaussianCount_, tileWidth, tileHeight});
+            const vk::Extent2D tileGrid = TileRangePass::TileGrid(swapchain_->GetExtent());
+            uint32_t tileWidth  = tileGrid.width;
+            uint32_t tileHeight = tileGrid.height;
+            projPass_->SetPushConstants(gaussianCount_, tileWidth, tileHeight);
+            projPass_->SetFrustum(FrustumPlanes(uboData));
+
+            // 키 = 32비트 depth + tile id 비트. 이 슬롯의 키 버퍼가 지난번에 넘쳤으면 먼저 키움
+            growTileKeyBuffers(frameIdx);
+            binPass_->SetFrameIndex(frameIdx);
+            binPass_->SetPushConstants(gaussianCount_, tileWidth, tileHeight);
+            uint32_t tileBits = 1;
+            while ((uint64_t{1} << tileBits) < uint64_t{tileWidth} * tileHeight) {
+                tileBits++;
+            }
+            sortPass_->SetFrameIndex(frameIdx);
+            sortPass_->SetKeyBits(32 + tileBits);
+            rangePass_->SetFrameIndex(frameIdx);
+            rangePass_->SetResultIndex(sortPass_->GetResultIndex());
+            rastPass_->SetFrameIndex(frameIdx);
+            rastPass_->SetResultIndex(sortPass_->GetResultIndex());
         }
 
         bool needsRecreation = renderer_->DrawFrame(
-            *context_, *swapchain_, *pipeline_, *commandManager_,
-            uboStaging_[frameIdx].get(), uboDevice_[frameIdx].get(),
+            *context_, *swapchain_, *commandManager_,
+            uboStaging_[frameIdx].get(), uboDevice_[frameIdx].get(), uploadManager_.get(),
             gaussianCount_ > 0 ? projPass_.get() : nullptr,
-            sortPass_.get(), rastPass_.get()
+            gaussianCount_ > 0 ? binPass_.get() : nullptr,
+            gaussianCount_ > 0 ? sortPass_.get() : nullptr,
+            gaussianCount_ > 0 ? rangePass_.get() : nullptr,
+            gaussianCount_ > 0 ? rastPass_.get() : nullptr,
+            rasterImages_[frameIdx].get()
         );
 
         if (needsRecreation || framebufferResized_) {
@@ -260,6 +1107,41 @@ void App::mainLoop() {
 // recreateSwapchain
 // ---------------------------------------------------------------------------
 
+void App::logPassTimings() {
+    const Renderer::PassTimings& timings = renderer_->GetPassTimings();
+    if (!timings.valid || gaussianCount_ == 0) {
+        return;
+    }
+    timingSum_.projMs   += timings.projMs;
+    timingSum_.binMs    += timings.binMs;
+    timingSum_.sortMs   += timings.sortMs;
+    timingSum_.rangesMs += timings.rangesMs;
+    timingSum_.rasterMs += timings.rasterMs;
+    if (++timingFrames_ < TIMING_LOG_FRAMES) {
+        return;
+    }
+
+    const double projMs = timingSum_.projMs / timingFrames_;
+    std::cout << "GPU (avg of " << timingFrames_ << " frames): proj " << projMs << " ms ("
+              << gaussianCount_ / (projMs * 1e3) << " Msplats/s), binning "
+              << timingSum_.binMs / timingFrames_ << " ms, sort "
+              << timingSum_.sortMs / timingFrames_ << " ms, tile ranges "
+              << timingSum_.rangesMs / timingFrames_ << " ms, raster "
+              << timingSum_.rasterMs / timingFrames_ << " ms" << std::endl;
+    if (streamer_) {
+        const SceneStreamer::Stats& stats = streamer_->GetStats();
+        std::cout << "Streaming: " << stats.residentChunks << " resident, " << stats.pendingChunks
+                  << " pending, " << stats.wantedChunks << " wanted chunks; " << stats.uploadedChunks
+                  << " uploaded, " << stats.evictedChunks << " evicted" << std::endl;
+    }
+    if (lodCut_) {
+        std::cout << "LOD cut: " << lodCut_->GetRows().size() << " rows, threshold "
+                  << lodCut_->GetThreshold() << " px" << std::endl;
+    }
+    timingSum_    = {};
+    timingFrames_ = 0;
+}
+
 void App::recreateSwapchain() {
     int width = 0, height = 0;
     glfwGetFramebufferSize(window_, &width, &height);
@@ -270,8 +1152,15 @@ void App::recreateSwapchain() {
 
     context_->Device().waitIdle();
     swapchain_->Recreate(*context_, window_);
-    renderer_->RecreateFramebuffers(*context_, *swapchain_, *pipeline_);
+    renderer_->RecreateSwapchainResources(*context_, *swapchain_);
     camera_.SetScreenSize(swapchain_->GetExtent().width, swapchain_->GetExtent().height);
+
+    // tile 격자가 바뀌므로 tile 구간 버퍼 / raster 이미지도 새 크기로 (장면이 있을 때만)
+    for (uint32_t i = 0; i < CommandManager::FRAMES_IN_FLIGHT; i++) {
+        if (tileKeyBuffers_[i].keyCapacity > 0) {
+            createScreenResources(i);
+        }
+    }
 }
 
 // ---------------------------------------------------------------------------
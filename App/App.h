@@ -2,18 +2,63 @@
 #include "Core.h"
 #include "../Vulkan/Context.h"
 #include "../Vulkan/Swapchain.h"
-#include "../Vulkan/Pipeline.h"
 #include "../Vulkan/Buffer.h"
+#include "../Vulkan/Image.h"
 #include "../Vulkan/CommandManager.h"
+#include "../Vulkan/UploadManager.h"
 #include "../Vulkan/Renderer.h"
 #include "../Vulkan/Vertex.h"
 #include "PlyLoader.h"
+#include "SplatCache.h"
+#include "AsyncSplatLoader.h"
+#include "HalfFloat.h"
+#include "QuantizedSplats.h"
+#include "SplatFormats.h"
+#include "MortonOrder.h"
+#include "SplatPrune.h"
+#include "Covariance.h"
+#include "SplatClusters.h"
 #include "Camera.h"
+#include "SceneStreamer.h"
+#include "LodCut.h"
+#include "SortBenchmark.h"
+#include "../Vulkan/ProjectionPass.h"
 
-class ProjectionPass;
+class BinningPass;
 class SortPass;
+class TileRangePass;
 class RasterPass;
 
+struct SceneLoadOptions {
+    bool useCache       = true;   // .gsbin 캐시를 매핑/기록 (첫 로드는 호스트 SplatSet 경유)
+    bool retainHostCopy = false;  // 업로드 후에도 splatSet_ 유지
+    bool async          = false;  // 백그라운드 스레드에서 로드, 청크 단위로 점진 업로드
+    size_t chunkRows    = 64 * 1024;  // async: 한 번에 공개되는 행 수
+    // GPU 입력 형식: Float16은 positions 외 fp16, Quantized는 256개 청크 양자화 (~4배 작음),
+    // Covariance는 3D 공분산 + 활성화된 opacity를 로드 시 미리 계산
+    ProjectionPass::InputFormat inputFormat = ProjectionPass::InputFormat::Float32;
+    // 로드 후 Morton 순서로 재배열 (동기 경로만 — async면 동기로 전환, 양자화 장면은 파일 순서 유지)
+    bool mortonOrder = false;
+    MortonPrecision mortonPrecision = MortonPrecision::Bits30;
+    // 업로드 전에 NaN/zero-norm 회전/투명/거대 splat 제거 (SplatPrune.h, Morton 재배열보다 먼저).
+    // mortonOrder와 마찬가지로 동기 경로만, 양자화 장면에는 적용 안 함
+    bool prune = false;
+    PruneOptions pruneOptions;
+    // Out-of-core: 장면을 .gsc chunk로 (없으면 한 번 만들어) 두고 카메라 근처 chunk만 고정 크기
+    // GPU pool에 유지. .gsc 파일을 직접 열면 항상 이 경로 (Float32 입력, f_rest 없음)
+    bool streaming = false;
+    SceneStreamer::Options stream;
+    // LOD: 병합된 Gaussian 계층(.gsl, 없으면 한 번 만듦)을 전부 올리고 매 프레임 화면 크기로 고른
+    // cut만 projection. .gsl 파일을 직접 열면 항상 이 경로 (Float32 입력, f_rest 없음)
+    bool lod = false;
+    LodCut::Options lodCut;
+    // 256개 행 cluster의 bounding sphere로 frustum 밖 cluster를 GPU에서 건너뜀 (ClusterCullPass).
+    // 행이 공간적으로 모여 있을수록(mortonOrder, 양자화 장면) 효과가 큼. streaming / LOD 장면은 제외
+    bool clusterCulling = true;
+    // 뷰어는 SH band를 아직 셰이딩하지 않으므로 f_rest를 추출하지 않음 (호스트 SplatSet, .gsbin 캐시에도 없음)
+    PlyLoadOptions ply = {.maxShDegree = 0};
+};
+
 class App {
 public:
     App(uint32_t width, uint32_t height, const char* title);
@@ -23,7 +68,13 @@ public:
     App& operator=(const App&) = delete;
 
     void Run();
-    void InitializePLY(const char* filename);
+    void InitializePLY(const char* filename, const SceneLoadOptions& options = {});
+
+    // 주기적으로 compute pass GPU 시간과 projection 처리량을 출력
+    void SetTimingLog(bool enabled) { timingLog_ = enabled; }
+
+    // 장면 없이 SortPass만 합성 키로 측정 (SortBenchmark.h)
+    void RunSortBenchmark(const SortBenchmarkOptions& options);
 
 private:
     GLFWwindow* window_ = nullptr;
@@ -31,10 +82,10 @@ private:
     // Declaration order matters for destruction (reverse order)
     std::unique_ptr<Context> context_;
     std::unique_ptr<Swapchain> swapchain_;
-    std::unique_ptr<Pipeline> pipeline_;
     std::unique_ptr<CommandManager> commandManager_;
+    std::unique_ptr<UploadManager> uploadManager_;
     std::unique_ptr<Renderer> renderer_;
-    std::unique_ptr<SplatSet> splatSet_;
+    std::unique_ptr<SplatSet> splatSet_;  // SceneLoadOptions::retainHostCopy일 때만 유지
     Camera camera_{glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f};
 
     // UBO (per-frame)
@@ -43,7 +94,9 @@ private:
 
     // Compute passes (각 pass가 자기 ComputePipeline을 소유)
     std::unique_ptr<ProjectionPass> projPass_;
+    std::unique_ptr<BinningPass> binPass_;
     std::unique_ptr<SortPass> sortPass_;
+    std::unique_ptr<TileRangePass> rangePass_;
     std::unique_ptr<RasterPass> rastPass_;
 
     // GPU buffers — Gaussian 입력 (SOA)
@@ -52,13 +105,64 @@ private:
     std::unique_ptr<Buffer> opacityBuffer_;
     std::unique_ptr<Buffer> scaleBuffer_;
     std::unique_ptr<Buffer> rotationBuffer_;
+    std::unique_ptr<Buffer> clusterBoundsBuffer_;  // cluster마다 vec4 (center, radius), culling 없으면 null
+    std::unique_ptr<SceneStreamer> streamer_;  // streaming 장면: 위 입력 버퍼가 chunk pool (먼저 파괴)
+    std::unique_ptr<LodCut> lodCut_;           // LOD 장면: 위 입력 버퍼가 leaf + node 행 전체
 
     // GPU buffers — Projection 출력 (per-frame)
     std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> projected2DBuffers_;
     std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> visibilityBuffers_;
     std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> tileCountBuffers_;
+    // LOD cut 행 (HOST_VISIBLE, projection binding 9). fence 대기 후 cut이 바뀐 프레임에만 기록
+    std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> lodRowBuffers_;
+    std::array<uint64_t, CommandManager::FRAMES_IN_FLIGHT> lodRowVersions_{};
+    // cluster culling 출력: 보이는 cluster 목록 + segment별 indirect dispatch 인자
+    std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> visibleClusterBuffers_;
+    std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> dispatchArgsBuffers_;
+    bool clusterCulling_ = true;  // SceneLoadOptions::clusterCulling
+    size_t frameCapacity_ = 0;    // 위 per-frame 출력 버퍼의 splat 수
+
+    // Tile binning → 정렬 (per-frame). keys/values[0] = binning 출력 = 정렬 입력.
+    // 필요한 키 수는 GPU가 stats에 기록하므로 그 프레임 슬롯의 fence 뒤에 읽어 넘쳤으면 그 슬롯만 키움
+    struct TileKeyBuffers {
+        std::array<std::unique_ptr<Buffer>, 2> keys, values;
+        std::unique_ptr<Buffer> keyCount;      // SortPass count (binning이 기록)
+        std::unique_ptr<Buffer> histograms;    // SortPass::HistogramBytes(keyCapacity)
+        std::unique_ptr<Buffer> blockOffsets;  // BinningPass::BlockOffsetBytes(frameCapacity_)
+        std::unique_ptr<Buffer> stats;         // HOST_VISIBLE: 잘리기 전 전체 키 수
+        uint64_t keyCapacity = 0;
+    };
+    std::array<TileKeyBuffers, CommandManager::FRAMES_IN_FLIGHT> tileKeyBuffers_;
+    // 정렬된 키의 tile별 [start, end) (uvec2 × tile 격자) + raster 출력 이미지 (per-frame,
+    // swapchain에 직접 쓰지 못할 때만). swapchain 크기가 바뀌면 다시 만듦
+    std::array<std::unique_ptr<Buffer>, CommandManager::FRAMES_IN_FLIGHT> tileRangeBuffers_;
+    std::array<std::unique_ptr<Image>, CommandManager::FRAMES_IN_FLIGHT> rasterImages_;
+    static constexpr uint64_t MIN_TILE_KEYS = 1 << 20;
 
-    uint32_t gaussianCount_ = 0;
+    size_t gaussianCount_ = 0;  // 64비트: GPU에서는 ProjectionPass가 segment로 나눔
+
+    // SetTimingLog: TIMING_LOG_FRAMES 프레임마다 평균 출력
+    static constexpr uint32_t TIMING_LOG_FRAMES = 240;
+    bool timingLog_ = false;
+    Renderer::PassTimings timingSum_;
+    uint32_t timingFrames_ = 0;
+
+    // Async scene loading (SceneLoadOptions::async) — 로더 스레드가 sceneStaging_에 기록,
+    // 청크마다 uploadManager_로 복사를 제출하고, 전송이 끝난 행까지 gaussianCount_가 증가
+    struct InputStaging {
+        std::unique_ptr<Buffer> positions, sh, opacity, scale, rotation;
+        std::unique_ptr<Buffer> clusters;   // cluster bounds (SplatClusters.h), cluster마다 float 4개
+        size_t capacity = 0;  // splat 수
+        ProjectionPass::InputFormat format = ProjectionPass::InputFormat::Float32;
+        std::unique_ptr<SplatSet> scratch;  // async + fp32 외 형식: 로더가 쓰는 fp32, 청크마다 변환
+    };
+    struct StreamedRows {
+        uint64_t ticket;   // uploadManager_ timeline 값
+        size_t lastRow;
+    };
+    InputStaging sceneStaging_;
+    std::unique_ptr<AsyncSplatLoader> sceneLoader_;  // sceneStaging_보다 먼저 파괴 (스레드 join)
+    std::deque<StreamedRows> streamedRows_;
 
     // Input state
     bool leftMouseDown_  = false;
@@ -72,6 +176,51 @@ private:
     void initVulkan();
     void mainLoop();
     void recreateSwapchain();
+    void logPassTimings();
+
+    // SOA 입력 업로드: staging(HOST_VISIBLE, 매핑) → device-local, UploadManager로 한 번의 submit
+    // Quantized에서 positions/sh/opacity/scale/rotation 버퍼는 ProjectionPass::InputFormat의 binding 순서
+    InputStaging createInputStaging(size_t count, ProjectionPass::InputFormat format);
+    void createInputBuffers(const InputStaging& staging);
+    // splats의 [first, last) 행을 staging 형식으로 기록 (null 스트림은 건너뜀).
+    // Quantized는 first/last가 256개 청크 경계여야 함 (last == capacity 제외)
+    static bool writeInputRows(const InputStaging& staging, const SplatView& splats,
+                               size_t first, size_t last);
+    // [first, last) 행이 걸친 cluster의 bounds를 staging에 기록. first가 속한 cluster부터 다시
+    // 계산하므로 청크 단위로 불러도 경계에 걸친 cluster가 앞 행까지 포함 (positions 필요, scale 선택)
+    static void writeClusterBounds(const InputStaging& staging, const SplatView& splats,
+                                   size_t first, size_t last);
+    // staging의 [first, last) 행에 해당하는 구간을 device 버퍼로 복사 예약 (Flush는 호출자)
+    void enqueueInputRows(const InputStaging& staging, size_t first, size_t last);
+    // 입력 형식이나 행 indirection이 바뀌면 specialization이 다른 projection pipeline으로 교체
+    void ensureProjectionPass(ProjectionPass::InputFormat format, bool indexedInput = false);
+    // .gsq (writeQuantizedSplats) 또는 PlayCanvas compressed.ply 장면: 배열을 그대로 staging에 복사해 업로드
+    bool loadQuantizedScene(const std::filesystem::path& path, const PlyLoadOptions& ply);
+    // .gsc를 열고(없거나 오래됐으면 원본에서 Morton 순서로 생성) chunk pool + SceneStreamer 생성
+    bool loadStreamingScene(const std::filesystem::path& path, const SceneLoadOptions& options);
+    // .gsl을 열고(없거나 오래됐으면 원본에서 Morton 순서 → 계층 생성) 모든 행 업로드 + LodCut 생성
+    bool loadLodScene(const std::filesystem::path& path, const SceneLoadOptions& options);
+    // options에 따라 prune 후 Morton 재배열
+    void reorderSceneRows(SplatSet& splats, const SceneLoadOptions& options);
+    void uploadInputs(const InputStaging& staging);
+
+    // Projection 출력 버퍼(capacity개) 생성 + per-frame descriptor 갱신.
+    // clusterBoundsBuffer_가 있으면 cluster culling 버퍼도 함께. raster pass를 projected2D segment 수에
+    // 맞춰 다시 만들고, segment 수가 descriptor 한도를 넘으면 아무것도 만들지 않고 false
+    bool createFrameResources(size_t capacity);
+    // frame 슬롯의 키/값/정렬 버퍼를 keyCapacity개로 다시 만들고 binning + sort descriptor 갱신
+    // (그 슬롯의 fence 대기 후에만 — 다른 슬롯의 프레임은 계속 진행)
+    void createTileKeyBuffers(uint32_t frame, uint64_t keyCapacity);
+    // 이 슬롯이 지난번에 센 키 수가 capacity를 넘었으면 여유를 두고 키움
+    void growTileKeyBuffers(uint32_t frame);
+    // frame 슬롯의 tileRanges / raster 출력 이미지를 현재 swapchain 크기로 다시 만들고
+    // tile range + raster descriptor 갱신
+    void createScreenResources(uint32_t frame);
+    // 키 수 한도: 정렬 개수가 32비트이고 키 버퍼(8 B/키) 전체를 binding하므로 maxStorageBufferRange / 8
+    uint64_t maxTileKeys() const;
+
+    void startAsyncLoad(const char* filename, const SceneLoadOptions& options);
+    void pumpSceneLoader();
 
     static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
@@ -51,6 +51,20 @@ void Camera::SetScreenSize(uint32_t width, uint32_t height) {
     }
 }
 
+std::array<glm::vec4, 6> FrustumPlanes(const CameraUBOData& camera) {
+    // Gribb-Hartmann (깊이 [0,1]): 왼/오/아래/위 = r3 ± r0/r1, near = r2, far = r3 - r2
+    const glm::mat4 viewProj = camera.projMatrix * camera.viewMatrix;
+    glm::vec4 r[4];
+    for (int i = 0; i < 4; i++) {
+        r[i] = glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    }
+    std::array<glm::vec4, 6> planes = {r[3] + r[0], r[3] - r[0], r[3] + r[1], r[3] - r[1], r[2], r[3] - r[2]};
+    for (glm::vec4& plane : planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return planes;
+}
+
 CameraUBOData Camera::GetUBOData() const {
     CameraUBOData data{};
 
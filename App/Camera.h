@@ -2,6 +2,7 @@
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <cmath>
 #include <cstdint>
 
@@ -18,6 +19,10 @@ struct CameraUBOData {
 };
 static_assert(sizeof(CameraUBOData) == 168, "CameraUBOData must match std140 layout");
 
+// projMatrix * viewMatrix의 frustum 평면 6개 (왼/오/아래/위/near/far), 법선은 안쪽·단위 길이.
+// dot(plane.xyz, p) + plane.w < 0이면 p는 평면 밖 (구 판정은 < -radius)
+std::array<glm::vec4, 6> FrustumPlanes(const CameraUBOData& camera);
+
 class Camera {
 public:
     Camera(float fovYRadians, float aspect, float zNear, float zFar);
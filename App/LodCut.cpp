@@ -0,0 +1,113 @@
+#include "LodCut.h"
+#include "ParallelFor.h"
+
+// 이 수만큼 node가 쌓일 때까지 메인 스레드에서 펼친 뒤, 나머지 subtree를 스레드로 나눔
+static constexpr size_t kParallelFrontier = 256;
+
+LodCut::LodCut(std::vector<LodNode> nodes, size_t leafCount, const Options& options)
+    : nodes_(std::move(nodes)), leafCount_(leafCount), options_(options),
+      threshold_(options.pixelThreshold) {
+    // budget을 조금 넘는 cut은 그대로 쓰고 다음 프레임에 threshold로 줄임
+    capacity_ = std::min<size_t>(static_cast<size_t>(options_.budget) + options_.budget / 4,
+                                 leafCount_ + nodes_.size());
+}
+
+bool LodCut::Update(const CameraUBOData& camera) {
+    if (!dirty_ && memcmp(&camera, &lastCamera_, sizeof(camera)) == 0) {
+        return false;
+    }
+    lastCamera_ = camera;
+
+    View view{};
+    view.planes        = FrustumPlanes(camera);
+    view.eye           = glm::vec3(camera.camPos);
+    view.pixelsPerUnit = 0.5f * static_cast<float>(camera.screenSize.y) / camera.fovY;
+    view.zNear         = camera.zNear;
+    view.threshold     = threshold_;
+    select(view);
+
+    // 버퍼에 넘치면 이번 프레임 안에서 threshold를 올려 다시 고름 (cut 크기 ∝ 1/threshold²).
+    // 화면보다 큰 threshold는 의미 없으므로 거기서 멈추고, 그래도 넘치면 (카메라를 감싸는 node만으로
+    // 넘치는 경우) 잘라냄
+    const float budget       = static_cast<float>(options_.budget);
+    const float maxThreshold = std::max(options_.pixelThreshold, static_cast<float>(camera.screenSize.y));
+    while (rows_.size() > capacity_ && threshold_ < maxThreshold) {
+        const float overflow = static_cast<float>(rows_.size()) / budget;
+        threshold_ = std::min(maxThreshold, threshold_ * 1.1f * std::sqrt(overflow));
+        view.threshold = threshold_;
+        select(view);
+    }
+    if (rows_.size() > capacity_) {
+        rows_.resize(capacity_);
+    }
+
+    // budget 근처([0.8, 1.0])로 수렴하도록 조정. 넘으면 크게, 모자라면 조금씩 (진동 방지)
+    const float ratio = std::max(static_cast<float>(rows_.size()), 1.0f) / budget;
+    float next = threshold_;
+    if (ratio > 1.0f) {
+        next = std::min(maxThreshold, threshold_ * ratio);
+    } else if (ratio < 0.8f) {
+        next = std::max(options_.pixelThreshold, threshold_ * std::pow(ratio, 0.25f));
+    }
+    dirty_     = std::abs(next - threshold_) > 0.01f * threshold_;
+    threshold_ = next;
+
+    version_++;
+    return true;
+}
+
+void LodCut::visit(const View& view, uint32_t node, std::vector<uint32_t>& rows,
+                   std::vector<uint32_t>& children) const {
+    const LodNode& n = nodes_[node];
+    const glm::vec3 center(n.center[0], n.center[1], n.center[2]);
+    for (const glm::vec4& plane : view.planes) {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -n.radius) {
+            return;
+        }
+    }
+
+    // 카메라가 sphere 안(또는 near 앞)이면 크기가 무한대 → 항상 펼침
+    const float distance = glm::length(center - view.eye) - n.radius;
+    if (distance > view.zNear && n.radius * view.pixelsPerUnit <= view.threshold * distance) {
+        rows.push_back(static_cast<uint32_t>(leafCount_ + node));
+    } else if (n.level == 1) {
+        for (uint32_t c = 0; c < n.childCount; c++) {
+            rows.push_back(n.firstChild + c);
+        }
+    } else {
+        const uint32_t first = n.firstChild - static_cast<uint32_t>(leafCount_);
+        for (uint32_t c = 0; c < n.childCount; c++) {
+            children.push_back(first + c);
+        }
+    }
+}
+
+void LodCut::select(const View& view) {
+    rows_.clear();
+    std::vector<uint32_t> frontier{static_cast<uint32_t>(nodes_.size() - 1)};
+    std::vector<uint32_t> next;
+    while (!frontier.empty() && frontier.size() < kParallelFrontier) {
+        next.clear();
+        for (uint32_t node : frontier) {
+            visit(view, node, rows_, next);
+        }
+        frontier.swap(next);
+    }
+
+    // 남은 subtree마다 깊이 우선으로 펼쳐 각자의 목록에 모은 뒤 순서대로 이어 붙임
+    std::vector<std::vector<uint32_t>> subtreeRows(frontier.size());
+    parallelFor(frontier.size(), options_.threadCount, 16, [&](size_t begin, size_t end) {
+        std::vector<uint32_t> stack;
+        for (size_t i = begin; i < end; i++) {
+            stack.assign(1, frontier[i]);
+            while (!stack.empty()) {
+                const uint32_t node = stack.back();
+                stack.pop_back();
+                visit(view, node, subtreeRows[i], stack);
+            }
+        }
+    });
+    for (const std::vector<uint32_t>& rows : subtreeRows) {
+        rows_.insert(rows_.end(), rows.begin(), rows.end());
+    }
+}
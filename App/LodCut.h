@@ -0,0 +1,64 @@
+#pragma once
+#include "Core.h"
+#include "SplatLod.h"
+#include "Camera.h"
+
+// LOD 계층(SplatLod.h)에서 매 프레임 projection에 넣을 행 집합(cut)을 고른다.
+//
+// 루트에서 내려가며 frustum 밖 node는 통째로 버리고, 화면에 투영된 bounding sphere
+// 반지름이 threshold 픽셀 이하인 node는 병합된 Gaussian 한 행으로, 그보다 크면 자식으로
+// 내려간다 (level 1 node의 자식은 원본 splat 행). threshold는 cut 크기가 budget 근처에
+// 머물도록 프레임마다 조정되므로, 장면이 아무리 커도 projection되는 splat 수는 대략 일정.
+// 카메라와 threshold가 그대로면 cut을 다시 계산하지 않음.
+//
+// Usage:
+//   LodCut cut(std::move(nodes), leafCount, options);
+//   // 매 프레임
+//   if (cut.Update(camera.GetUBOData())) upload(cut.GetRows());
+//   projPass.SetPushConstants(cut.GetRows().size(), tileWidth, tileHeight);
+class LodCut {
+public:
+    struct Options {
+        uint32_t budget      = 2'000'000;  // 목표 cut 크기 (projection되는 splat 수)
+        float pixelThreshold = 1.0f;       // 이보다 작은 node는 budget이 남아도 펼치지 않음
+        uint32_t threadCount = 0;          // 0 = hardware concurrency
+    };
+
+    LodCut(std::vector<LodNode> nodes, size_t leafCount, const Options& options);
+
+    // cut 행 버퍼 크기: 한 프레임의 cut은 이 수를 넘지 않음 (넘으면 threshold를 올려 다시 고름)
+    size_t GetCapacity() const { return capacity_; }
+
+    // cut이 바뀌었으면 true
+    bool Update(const CameraUBOData& camera);
+
+    const std::vector<uint32_t>& GetRows() const { return rows_; }
+    uint64_t GetVersion() const { return version_; }  // cut이 바뀔 때마다 증가
+    float GetThreshold() const { return threshold_; }
+
+private:
+    std::vector<LodNode> nodes_;
+    size_t leafCount_;
+    Options options_;
+    size_t capacity_;
+
+    std::vector<uint32_t> rows_;
+    uint64_t version_  = 0;
+    float threshold_;
+    bool dirty_        = true;  // threshold가 바뀌어 다음 Update에서 다시 골라야 함
+    CameraUBOData lastCamera_{};
+
+    // 한 번의 선택에 쓰는 카메라 상수
+    struct View {
+        std::array<glm::vec4, 6> planes;
+        glm::vec3 eye;
+        float pixelsPerUnit;  // 거리 1에서 월드 길이 1의 화면 픽셀 수
+        float zNear;
+        float threshold;
+    };
+
+    void select(const View& view);
+    // node 하나를 판정: 행을 rows에 추가하거나 펼칠 자식 node index를 children에 추가
+    void visit(const View& view, uint32_t node, std::vector<uint32_t>& rows,
+               std::vector<uint32_t>& children) const;
+};
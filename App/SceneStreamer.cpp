@@ -0,0 +1,277 @@
+#include "SceneStreamer.h"
+#include "../Vulkan/Buffer.h"
+#include "../Vulkan/UploadManager.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <limits>
+
+// Float32 입력 binding 1-5의 splat당 float 수 (chunk block의 배열 순서와 같음)
+static constexpr uint32_t kAttributeFloats[5] = {3, 3, 1, 3, 4};
+
+SceneStreamer::SceneStreamer(UploadManager& uploads, std::unique_ptr<ChunkedScene> scene,
+                             const Targets& targets, const Options& options, uint32_t framesInFlight)
+    : uploads_(uploads), scene_(std::move(scene)), targets_(targets), options_(options),
+      framesInFlight_(framesInFlight) {
+    slots_.resize(PoolSlots(*scene_, options_));
+    chunkSlot_.assign(scene_->chunkCount(), -1);
+    maskRows_.assign(scene_->chunkRows(), -std::numeric_limits<float>::infinity());
+
+    nearDistance_ = options_.nearDistance;
+    if (nearDistance_ <= 0.0f) {
+        double diagonal = 0.0;
+        for (size_t c = 0; c < scene_->chunkCount(); c++) {
+            const SceneChunkInfo& info = scene_->chunk(c);
+            diagonal += glm::length(glm::make_vec3(info.boundsMax) - glm::make_vec3(info.boundsMin));
+        }
+        nearDistance_ = static_cast<float>(2.0 * diagonal / static_cast<double>(scene_->chunkCount()));
+    }
+
+    worker_ = std::thread(&SceneStreamer::readLoop, this);
+}
+
+SceneStreamer::~SceneStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+uint32_t SceneStreamer::PoolSlots(const ChunkedScene& scene, const Options& options) {
+    return static_cast<uint32_t>(std::max<size_t>(1, std::min<size_t>(options.poolChunks, scene.chunkCount())));
+}
+
+void SceneStreamer::Update(const CameraUBOData& camera) {
+    frame_++;
+    collectReads();
+    advanceUploads();
+    selectWanted(camera);
+    requestReads();
+
+    stats_.residentChunks = 0;
+    for (const Slot& slot : slots_) {
+        stats_.residentChunks += slot.state == SlotState::Resident;
+    }
+    stats_.pendingChunks = pendingReads_;
+    stats_.wantedChunks  = static_cast<uint32_t>(wanted_.size());
+}
+
+void SceneStreamer::readLoop() {
+    const size_t floats = kChunkBaseFloats * scene_->chunkRows();
+    for (;;) {
+        ReadRequest request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stop_ || !requests_.empty(); });
+            if (stop_) {
+                return;
+            }
+            request = requests_.front();
+            requests_.pop_front();
+        }
+
+        // 디스크 읽기(page fault)는 여기서만 발생, 복사 후 page는 working set에서 내림
+        ReadResult result{request.slot, std::vector<float>(floats)};
+        memcpy(result.data.data(), scene_->chunkData(request.chunk), floats * sizeof(float));
+        scene_->discardChunk(request.chunk);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_.push_back(std::move(result));
+    }
+}
+
+void SceneStreamer::collectReads() {
+    std::deque<ReadResult> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done.swap(results_);
+    }
+    // Reading 중인 slot은 빼앗기지 않으므로 slot의 chunk는 요청 때와 같음. 전송은 advanceUploads에서
+    for (ReadResult& result : done) {
+        slots_[result.slot].data = std::move(result.data);
+    }
+}
+
+void SceneStreamer::advanceUploads() {
+    const Buffer* targets[5] = {targets_.positions, targets_.sh, targets_.opacity,
+                                targets_.scale, targets_.rotation};
+    static constexpr uint32_t kOpacity = 2;
+    const vk::DeviceSize rows = scene_->chunkRows();
+
+    // chunk block의 속성 i를 slot 위치로 전송 예약
+    auto enqueue = [&](uint32_t index, const Slot& slot, uint32_t i) {
+        size_t offset = 0;
+        for (uint32_t k = 0; k < i; k++) {
+            offset += rows * kAttributeFloats[k];
+        }
+        const vk::DeviceSize bytes = rows * kAttributeFloats[i] * sizeof(float);
+        uploads_.Enqueue(*targets[i], slot.data.data() + offset, bytes, index * bytes);
+    };
+
+    std::vector<uint32_t> submitted;
+    for (uint32_t index = 0; index < slots_.size(); index++) {
+        Slot& slot = slots_[index];
+        if (slot.state == SlotState::Free || slot.state == SlotState::Resident) {
+            continue;
+        }
+        // 전송 완료를 본 이 Update부터 기록되는 프레임은 그 결과를 봄 (RecordAcquires).
+        // 그 전에 기록된 프레임(in flight)이 모두 끝난 뒤에만 다음 단계를 씀
+        if (slot.ticket > 0) {
+            if (!uploads_.IsComplete(slot.ticket)) {
+                continue;
+            }
+            slot.ticket     = 0;
+            slot.readyFrame = frame_ + framesInFlight_ - 1;
+        }
+        if (slot.state == SlotState::Publishing) {
+            slot.state = SlotState::Resident;
+            pendingReads_--;
+            stats_.uploadedChunks++;
+            continue;
+        }
+        if (frame_ < slot.readyFrame) {
+            continue;
+        }
+
+        if (slot.state == SlotState::Reading && !slot.data.empty()) {
+            // 가린 slot: opacity는 -inf로 둔 채 나머지만 (그리는 프레임은 이 행을 컬링).
+            // 한 번도 그려지지 않은 slot은 한 번에 전부
+            for (uint32_t i = 0; i < 5; i++) {
+                if (i != kOpacity || !slot.masked) {
+                    enqueue(index, slot, i);
+                }
+            }
+            slot.state = slot.masked ? SlotState::Uploading : SlotState::Publishing;
+        } else if (slot.state == SlotState::Uploading) {
+            // 마지막으로 opacity: 이제 그리는 프레임은 행마다 -inf 또는 새 행 전체를 봄
+            enqueue(index, slot, kOpacity);
+            slot.state = SlotState::Publishing;
+        } else {
+            continue;
+        }
+        if (slot.state == SlotState::Publishing) {
+            slot.data = {};
+        }
+        submitted.push_back(index);
+    }
+    if (!submitted.empty()) {
+        const uint64_t ticket = uploads_.Flush();
+        for (uint32_t index : submitted) {
+            slots_[index].ticket = ticket;
+        }
+    }
+
+    // 빈 slot은 앞에서부터 배정되므로 처음 채워지는 slot도 앞에서부터 완료됨
+    while (filledSlots_ < slots_.size() && slots_[filledSlots_].state == SlotState::Resident) {
+        filledSlots_++;
+    }
+}
+
+void SceneStreamer::selectWanted(const CameraUBOData& camera) {
+    const std::array<glm::vec4, 6> planes = FrustumPlanes(camera);
+    const glm::vec3 eye(camera.camPos);
+
+    wanted_.clear();
+    for (size_t c = 0; c < scene_->chunkCount(); c++) {
+        const SceneChunkInfo& info = scene_->chunk(c);
+        const glm::vec3 lo = glm::make_vec3(info.boundsMin);
+        const glm::vec3 hi = glm::make_vec3(info.boundsMax);
+
+        // 평면 법선 방향으로 가장 먼 꼭짓점이 평면 뒤면 bounds 전체가 밖
+        bool inside = true;
+        for (const glm::vec4& plane : planes) {
+            const glm::vec3 farCorner = glm::mix(lo, hi, glm::greaterThanEqual(glm::vec3(plane), glm::vec3(0.0f)));
+            if (glm::dot(glm::vec3(plane), farCorner) + plane.w < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        const float distance = glm::length(glm::max(glm::max(lo - eye, eye - hi), glm::vec3(0.0f)));
+        if (inside || distance < nearDistance_) {
+            wanted_.push_back({!inside, distance, static_cast<uint32_t>(c)});
+        }
+    }
+
+    // frustum 안 → 근처 순, 각각 가까운 순. pool에 들어가는 만큼만 원함 (원하는 chunk끼리 밀어내지 않음)
+    auto priority = [](const WantedChunk& a, const WantedChunk& b) {
+        return a.outside != b.outside ? b.outside : a.distance < b.distance;
+    };
+    if (wanted_.size() > slots_.size()) {
+        std::nth_element(wanted_.begin(), wanted_.begin() + slots_.size(), wanted_.end(), priority);
+        wanted_.resize(slots_.size());
+    }
+    std::sort(wanted_.begin(), wanted_.end(), priority);
+
+    for (const WantedChunk& wanted : wanted_) {
+        if (chunkSlot_[wanted.chunk] >= 0) {
+            slots_[chunkSlot_[wanted.chunk]].lastUsed = frame_;
+        }
+    }
+}
+
+int32_t SceneStreamer::findSlot() const {
+    // 빈 slot (앞에서부터) → 이번에 원하지 않는 resident slot 중 LRU
+    int32_t victim = -1;
+    for (uint32_t i = 0; i < slots_.size(); i++) {
+        const Slot& slot = slots_[i];
+        if (slot.state == SlotState::Free) {
+            return static_cast<int32_t>(i);
+        }
+        if (slot.state == SlotState::Resident && slot.lastUsed < frame_ &&
+            (victim < 0 || slot.lastUsed < slots_[victim].lastUsed)) {
+            victim = static_cast<int32_t>(i);
+        }
+    }
+    return victim;
+}
+
+void SceneStreamer::requestReads() {
+    std::vector<ReadRequest> batch;
+    std::vector<uint32_t> masked;
+    for (const WantedChunk& wanted : wanted_) {
+        if (pendingReads_ >= options_.maxPendingReads) {
+            break;
+        }
+        if (chunkSlot_[wanted.chunk] >= 0) {
+            continue;
+        }
+        const int32_t index = findSlot();
+        if (index < 0) {
+            break;
+        }
+
+        // 빼앗는 slot은 dispatch 범위 안에 남으므로 opacity를 먼저 -inf로 가림 (chunk padding 행과 같음).
+        // 그 사이 그리는 프레임은 행마다 이전 opacity 또는 -inf를 볼 뿐 다른 속성은 이전 chunk 그대로
+        Slot& slot = slots_[index];
+        slot.masked = slot.chunk >= 0;
+        if (slot.masked) {
+            chunkSlot_[slot.chunk] = -1;
+            const vk::DeviceSize bytes = maskRows_.size() * sizeof(float);
+            uploads_.Enqueue(*targets_.opacity, maskRows_.data(), bytes, index * bytes);
+            masked.push_back(static_cast<uint32_t>(index));
+            stats_.evictedChunks++;
+        }
+        slot.state      = SlotState::Reading;
+        slot.chunk      = wanted.chunk;
+        slot.lastUsed   = frame_;
+        slot.readyFrame = 0;
+        chunkSlot_[wanted.chunk] = index;
+        pendingReads_++;
+        batch.push_back({static_cast<uint32_t>(index), wanted.chunk});
+    }
+
+    if (!masked.empty()) {
+        const uint64_t ticket = uploads_.Flush();
+        for (uint32_t index : masked) {
+            slots_[index].ticket = ticket;
+        }
+    }
+
+    if (!batch.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            requests_.insert(requests_.end(), batch.begin(), batch.end());
+        }
+        cv_.notify_one();
+    }
+}
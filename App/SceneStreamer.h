@@ -0,0 +1,138 @@
+#pragma once
+#include "Core.h"
+#include "ChunkedScene.h"
+#include "Camera.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class Buffer;
+class UploadManager;
+
+// Out-of-core 장면의 GPU residency 관리자.
+//
+// ChunkedScene(.gsc)의 chunk를 고정 크기 GPU pool의 slot(chunkRows개 행)에 올린다.
+// 매 Update마다 frustum 안 또는 카메라 근처의 chunk를 (frustum 안 우선, 가까운 순으로)
+// 원하고, 없는 chunk는 비어 있는 slot이나 이번에 원하지 않는 slot 중 가장 오래 쓰이지
+// 않은 것(LRU)을 빼앗아 올린다. 파일 읽기는 worker 스레드, GPU 복사는 UploadManager의
+// transfer 제출이라 렌더 스레드는 디스크나 전송을 기다리지 않는다.
+//
+// pool 버퍼는 Float32 입력 형식(ProjectionPass binding 1-5)이며 chunk의 padding 행은
+// opacity -inf라 projection에서 컬링된다. GetActiveRows()까지의 slot만 dispatch하면 됨.
+//
+// 빼앗은 slot도 dispatch 범위 안에 남으므로 전송 중인 행이 그려지지 않게 단계를 나눈다:
+// 먼저 opacity를 -inf로 가리고, 가리기 전 프레임이 모두 끝나면 opacity 외 속성을, 그 전송 전
+// 프레임이 모두 끝나면 마지막으로 opacity를 쓴다. 프레임이 끝났는지는 Update 번호로 판단하므로
+// Update는 매 프레임 그 frame 슬롯의 fence를 기다린 뒤 한 번씩 호출해야 함.
+//
+// Usage:
+//   SceneStreamer streamer(uploads, std::move(scene), targets, options, framesInFlight);
+//   // 매 프레임 (Renderer::WaitForCurrentFrame 뒤)
+//   streamer.Update(camera.GetUBOData());
+//   projPass.SetPushConstants(streamer.GetActiveRows(), tileWidth, tileHeight);
+class SceneStreamer {
+public:
+    struct Options {
+        uint32_t poolChunks      = 256;   // GPU pool slot 수 (chunk 64K행 기준 slot당 ~3.5 MiB)
+        uint32_t maxPendingReads = 8;     // 동시에 읽거나 전송 중인 chunk 수
+        float nearDistance       = 0.0f;  // frustum 밖이어도 유지할 거리, 0 = chunk 대각선 평균의 2배
+    };
+
+    // pool 버퍼: 각각 poolChunks × chunkRows 행 (positions/f_dc/scale 12 B, opacity 4 B, rotation 16 B)
+    struct Targets {
+        const Buffer* positions = nullptr;
+        const Buffer* sh        = nullptr;
+        const Buffer* opacity   = nullptr;
+        const Buffer* scale     = nullptr;
+        const Buffer* rotation  = nullptr;
+    };
+
+    struct Stats {
+        uint32_t residentChunks = 0;
+        uint32_t pendingChunks  = 0;
+        uint32_t wantedChunks   = 0;
+        uint64_t uploadedChunks = 0;  // 누적
+        uint64_t evictedChunks  = 0;  // 누적
+    };
+
+    SceneStreamer(UploadManager& uploads, std::unique_ptr<ChunkedScene> scene,
+                  const Targets& targets, const Options& options, uint32_t framesInFlight);
+    ~SceneStreamer();
+
+    SceneStreamer(const SceneStreamer&) = delete;
+    SceneStreamer& operator=(const SceneStreamer&) = delete;
+
+    // pool 크기(행)에 맞춘 slot 수. 장면이 pool보다 작으면 chunk 수.
+    static uint32_t PoolSlots(const ChunkedScene& scene, const Options& options);
+
+    // 완료된 읽기/전송 반영 → 원하는 chunk 집합 갱신 → 새 읽기 요청
+    void Update(const CameraUBOData& camera);
+
+    // 한 번이라도 채워진 앞쪽 slot들의 행 수 (projection dispatch 범위)
+    size_t GetActiveRows() const { return filledSlots_ * scene_->chunkRows(); }
+    const Stats& GetStats() const { return stats_; }
+
+private:
+    // Reading: 파일 읽기 (빼앗은 slot이면 opacity 가리기 전송도 함께)
+    // Uploading: opacity 외 속성 전송 (가린 slot만) → Publishing: 나머지 전송 → Resident
+    enum class SlotState { Free, Reading, Uploading, Publishing, Resident };
+
+    struct Slot {
+        SlotState state     = SlotState::Free;
+        int64_t chunk       = -1;
+        bool masked         = false;  // 이전 chunk를 그리던 slot → opacity를 가린 뒤 두 단계로 채움
+        uint64_t ticket     = 0;      // 진행 중인 전송의 uploads_ timeline 값 (0 = 없음)
+        uint64_t readyFrame = 0;      // 이 Update 번호부터 다음 전송 가능
+        uint64_t lastUsed   = 0;      // 마지막으로 원해진 Update 번호 (LRU)
+        std::vector<float> data;      // 읽은 chunk block, opacity까지 전송하면 해제
+    };
+
+    struct ReadRequest {
+        uint32_t slot;
+        int64_t chunk;
+    };
+
+    struct ReadResult {
+        uint32_t slot;
+        std::vector<float> data;  // chunk block 중 f_rest 앞부분 (kChunkBaseFloats × chunkRows)
+    };
+
+    UploadManager& uploads_;
+    std::unique_ptr<ChunkedScene> scene_;
+    Targets targets_;
+    Options options_;
+    uint32_t framesInFlight_;
+    std::vector<float> maskRows_;  // chunkRows개의 -inf (빼앗은 slot의 opacity 가리기)
+
+    std::vector<Slot> slots_;
+    std::vector<int32_t> chunkSlot_;  // chunk → slot, 없으면 -1
+    size_t filledSlots_ = 0;
+    uint64_t frame_     = 0;
+    uint32_t pendingReads_ = 0;
+    Stats stats_;
+
+    // 가시성 판정용 (장면 상수)
+    float nearDistance_ = 0.0f;
+    struct WantedChunk {
+        bool outside;    // frustum 밖 (근처라서 원함) → frustum 안 chunk 뒤로
+        float distance;  // 카메라에서 chunk bounds까지
+        uint32_t chunk;
+    };
+    std::vector<WantedChunk> wanted_;  // 우선순위 순, 최대 slot 수. Update마다 재사용
+
+    // 읽기 worker: requests_ → 파일에서 복사 → results_
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<ReadRequest> requests_;
+    std::deque<ReadResult> results_;
+    bool stop_ = false;
+
+    void readLoop();
+    void collectReads();
+    void advanceUploads();
+    void selectWanted(const CameraUBOData& camera);
+    void requestReads();
+    int32_t findSlot() const;
+};
@@ -0,0 +1,153 @@
+#include "SortBenchmark.h"
+#include "../Vulkan/Context.h"
+#include "../Vulkan/CommandManager.h"
+#include "../Vulkan/UploadManager.h"
+#include "../Vulkan/Buffer.h"
+#include "../Vulkan/SortPass.h"
+#include <numeric>
+#include <random>
+
+// GPU 결과를 읽어 정렬 순서, 키-값 짝(값 = 원래 index), 같은 키 사이의 순서(안정성)를 확인
+static bool verifySorted(const std::vector<uint64_t>& keys, const uint64_t* sortedKeys,
+                         const uint32_t* sortedValues) {
+    std::vector<uint8_t> seen(keys.size(), 0);
+    for (size_t i = 0; i < keys.size(); i++) {
+        const uint32_t value = sortedValues[i];
+        if (value >= keys.size() || seen[value] || keys[value] != sortedKeys[i]) {
+            return false;
+        }
+        seen[value] = 1;
+        if (i > 0 && (sortedKeys[i] < sortedKeys[i - 1] ||
+                      (sortedKeys[i] == sortedKeys[i - 1] && value < sortedValues[i - 1]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void benchmarkCount(Context& context, CommandManager& commands, UploadManager& uploads,
+                           SortPass& sort, vk::raii::QueryPool& queryPool, double timestampPeriodNs,
+                           uint64_t count, const SortBenchmarkOptions& options) {
+    // 키: 하위 keyBits 비트만 무작위 (tile id 상위 비트가 비어 있는 실제 키와 같은 분포)
+    const uint64_t mask = options.keyBits >= 64 ? ~uint64_t{0} : (uint64_t{1} << options.keyBits) - 1;
+    std::vector<uint64_t> keys(count);
+    std::mt19937_64 rng(count);
+    for (uint64_t& key : keys) {
+        key = rng() & mask;
+    }
+    std::vector<uint32_t> values(count);
+    std::iota(values.begin(), values.end(), 0u);
+    const uint32_t keyCount = static_cast<uint32_t>(count);
+
+    const vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eStorageBuffer |
+                                       vk::BufferUsageFlagBits::eTransferSrc |
+                                       vk::BufferUsageFlagBits::eTransferDst;
+    auto makeDevice = [&](vk::DeviceSize size) {
+        return Buffer::CreateDeviceLocal(context, usage, size);
+    };
+    Buffer source     = makeDevice(sizeof(uint64_t) * count);  // 반복마다 keys[0]으로 복사
+    Buffer keys0      = makeDevice(sizeof(uint64_t) * count);
+    Buffer keys1      = makeDevice(sizeof(uint64_t) * count);
+    Buffer values0    = makeDevice(sizeof(uint32_t) * count);
+    Buffer values1    = makeDevice(sizeof(uint32_t) * count);
+    Buffer countBuf   = makeDevice(sizeof(uint32_t));
+    Buffer histograms = makeDevice(SortPass::HistogramBytes(count));
+
+    uploads.Enqueue(source, keys.data(), source.GetSize());
+    uploads.Enqueue(countBuf, &keyCount, sizeof(keyCount));
+
+    SortPass::Buffers buffers{
+        {keys0.GetHandle(), keys1.GetHandle()},
+        {values0.GetHandle(), values1.GetHandle()},
+        countBuf.GetHandle(),
+        histograms.GetHandle(),
+    };
+    sort.UpdateDescriptors(context, 0, buffers, count);
+
+    // 한 번의 정렬을 timestamp 사이에 기록 (bottom-of-pipe: 앞의 키 복사가 끝난 뒤부터)
+    auto runSort = [&]() {
+        commands.ImmediateSubmit(context, [&](vk::CommandBuffer cmd) {
+            uploads.RecordAcquires(cmd);  // transfer 큐 업로드의 소유권 (호스트에서 이미 대기함)
+            cmd.copyBuffer(source.GetHandle(), keys0.GetHandle(), vk::BufferCopy{0, 0, source.GetSize()});
+
+            vk::MemoryBarrier copyBarrier{};
+            copyBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+            copyBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+            cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                vk::PipelineStageFlagBits::eComputeShader,
+                                {}, copyBarrier, {}, {});
+
+            cmd.resetQueryPool(*queryPool, 0, 2);
+            cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *queryPool, 0);
+            sort.Record(cmd);
+            cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *queryPool, 1);
+        });
+        auto [result, ticks] = queryPool.getResults<uint64_t>(
+            0, 2, 2 * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+        return result == vk::Result::eSuccess
+                   ? static_cast<double>(ticks[1] - ticks[0]) * timestampPeriodNs * 1e-6 : 0.0;
+    };
+
+    // 값은 정렬할 때마다 섞이지만 시간에는 영향이 없으므로 검증하는 마지막 반복 전에만 다시 채움
+    uploads.Enqueue(values0, values.data(), values0.GetSize());
+    uploads.Wait(uploads.Flush());
+    runSort();  // warm-up
+    std::vector<double> times;
+    for (uint32_t i = 0; i + 1 < options.iterations; i++) {
+        times.push_back(runSort());
+    }
+    uploads.Enqueue(values0, values.data(), values0.GetSize());
+    uploads.Wait(uploads.Flush());
+    times.push_back(runSort());
+
+    // 결과 읽기 → 검증
+    const bool alternate = sort.GetResultIndex() == 1;
+    Buffer readKeys   = Buffer::CreateHostVisible(context, vk::BufferUsageFlagBits::eTransferDst, keys0.GetSize());
+    Buffer readValues = Buffer::CreateHostVisible(context, vk::BufferUsageFlagBits::eTransferDst, values0.GetSize());
+    commands.ImmediateSubmit(context, [&](vk::CommandBuffer cmd) {
+        (alternate ? keys1 : keys0).RecordCopy(cmd, readKeys);
+        (alternate ? values1 : values0).RecordCopy(cmd, readValues);
+    });
+    const bool verified = verifySorted(keys, static_cast<const uint64_t*>(readKeys.GetMappedData()),
+                                       static_cast<const uint32_t*>(readValues.GetMappedData()));
+
+    std::sort(times.begin(), times.end());
+    const double median = times[times.size() / 2];
+    std::cout << "Sort " << count << " keys (" << options.keyBits << " bits, " << sort.GetPassCount()
+              << " passes): median " << median << " ms, best " << times.front() << " ms, "
+              << (median > 0.0 ? static_cast<double>(count) / (median * 1e-3) * 1e-6 : 0.0) << " Mkeys/s, "
+              << (verified ? "verified" : "WRONG ORDER") << std::endl;
+}
+
+void RunSortBenchmark(Context& context, CommandManager& commands, UploadManager& uploads,
+                      const SortBenchmarkOptions& options) {
+    const auto properties = context.PhysicalDevice().getProperties();
+    const auto families   = context.PhysicalDevice().getQueueFamilyProperties();
+    if (families[context.GetGraphicsQueueFamily()].timestampValidBits == 0 ||
+        properties.limits.timestampPeriod == 0.0f) {
+        std::cerr << "Sort benchmark needs timestamp queries on the graphics queue" << std::endl;
+        return;
+    }
+    vk::QueryPoolCreateInfo poolInfo{};
+    poolInfo.setQueryType(vk::QueryType::eTimestamp);
+    poolInfo.setQueryCount(2);
+    vk::raii::QueryPool queryPool = context.Device().createQueryPool(poolInfo);
+
+    SortPass sort(context, "Shaders/sort.comp.spv", 1);
+    sort.SetKeyBits(options.keyBits);
+    std::cout << "GPU radix sort benchmark: " << properties.deviceName.data() << std::endl;
+
+    for (uint64_t count : options.counts) {
+        if (count == 0 || count > std::numeric_limits<uint32_t>::max()) {
+            std::cerr << "Sort benchmark: key count must be 1 to 2^32-1 (" << count << ")" << std::endl;
+            continue;
+        }
+        try {
+            benchmarkCount(context, commands, uploads, sort, queryPool,
+                           properties.limits.timestampPeriod, count, options);
+        } catch (const std::exception& e) {
+            std::cerr << "Sort benchmark skipped " << count << " keys: " << e.what() << std::endl;
+        }
+        context.Device().waitIdle();
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "Core.h"
+
+class Context;
+class CommandManager;
+class UploadManager;
+
+// SortPass 단독 벤치마크: 합성 키(하위 keyBits 비트만 무작위)를 count개 만들어 GPU에서 정렬하고
+// timestamp로 잰 정렬 시간의 중앙값과 초당 키 수를 출력. 마지막 반복의 결과는 읽어와서
+// 정렬 순서 / 키-값 짝 / 안정성을 검사함.
+//
+// Usage:
+//   GaussianSplatting --sort-bench [count ...]   // 기본 1M, 10M, 100M
+struct SortBenchmarkOptions {
+    std::vector<uint64_t> counts = {1'000'000, 10'000'000, 100'000'000};
+    uint32_t keyBits    = 48;  // 32비트 depth + 16비트 tile id (1600×900에서 tile 5,600개)
+    uint32_t iterations = 10;  // 측정 반복 (앞에 warm-up 한 번)
+};
+
+// count마다 키 32 B(원본 + ping-pong 키 / 값)의 device 메모리가 필요. 할당에 실패한 count는 건너뜀
+void RunSortBenchmark(Context& context, CommandManager& commands, UploadManager& uploads,
+                      const SortBenchmarkOptions& options = {});
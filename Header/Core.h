@@ -13,6 +13,8 @@
 #include <set>
 #include <limits>
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
 
 #include <vulkan/vulkan_raii.hpp>
 
@@ -0,0 +1,215 @@
+#include "AsyncSplatLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+// Copies rows [first, last) of one SOA array of `width` floats per splat.
+void copyRows(const float* src, float* dst, size_t width, size_t first, size_t last)
+{
+    if (src && dst)
+        std::memcpy(dst + first * width, src + first * width, (last - first) * width * sizeof(float));
+}
+
+// f_rest rows of 3 channels × coefficients; keeps the first dstWidth / 3 of each
+// channel when the cache holds more SH bands than were requested.
+void copyShRows(const float* src, float* dst, size_t srcWidth, size_t dstWidth, size_t first, size_t last)
+{
+    if (srcWidth == dstWidth)
+        return copyRows(src, dst, srcWidth, first, last);
+    if (!src || !dst)
+        return;
+    const size_t srcCoeffs = srcWidth / 3;
+    const size_t dstCoeffs = dstWidth / 3;
+    for (size_t i = first * 3; i < last * 3; ++i)
+        std::memcpy(dst + i * dstCoeffs, src + i * srcCoeffs, dstCoeffs * sizeof(float));
+}
+
+void copyRows(const SplatView& src, const SplatTargets& dst, size_t fRestPerSplat, size_t first, size_t last)
+{
+    copyRows(src.positions, dst.positions, 3, first, last);
+    copyRows(src.f_dc, dst.f_dc, 3, first, last);
+    copyShRows(src.f_rest, dst.f_rest, src.fRestPerSplat, fRestPerSplat, first, last);
+    copyRows(src.opacity, dst.opacity, 1, first, last);
+    copyRows(src.scale, dst.scale, 3, first, last);
+    copyRows(src.rotation, dst.rotation, 4, first, last);
+}
+
+} // namespace
+
+std::unique_ptr<SplatCache> peekSplatCount(const std::filesystem::path& filename,
+                                           const AsyncLoadOptions& options, PlyInfo& info)
+{
+    info = {};
+    if (options.useCache)
+    {
+        auto cache = std::make_unique<SplatCache>(splatCachePath(filename), filename);
+        if (cache->valid() && cache->coversShDegree(options.ply.maxShDegree, filename))
+        {
+            info.count         = cache->size();
+            info.fRestPerSplat = shRestFloatsForDegree(cache->view().fRestPerSplat, options.ply.maxShDegree);
+            info.hasPositions  = true;
+            info.hasFDc        = true;
+            info.hasOpacity    = true;
+            info.hasScale      = true;
+            info.hasRotation   = true;
+            return cache;
+        }
+    }
+
+    if (!readPlyInfo(filename, info))
+    {
+        std::cerr << "Error: failed to read PLY header: " << filename << std::endl;
+        info = {};
+    }
+    return nullptr;
+}
+
+AsyncSplatLoader::AsyncSplatLoader(const std::filesystem::path& filename, const SplatTargets& targets,
+                                   size_t count, const AsyncLoadOptions& options,
+                                   std::unique_ptr<SplatCache> cache)
+    : filename_(filename), targets_(targets), count_(count), options_(options), cache_(std::move(cache))
+{
+    thread_ = std::thread([this] { run(); });
+}
+
+AsyncSplatLoader::~AsyncSplatLoader()
+{
+    cancelled_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable())
+        thread_.join();
+}
+
+bool AsyncSplatLoader::popChunk(SplatChunk& chunk)
+{
+    return chunks_.tryPop(chunk);
+}
+
+bool AsyncSplatLoader::finished() const
+{
+    // done_ is stored after the last push, so an empty queue seen afterwards is final.
+    return done_.load(std::memory_order_acquire) && chunks_.empty();
+}
+
+bool AsyncSplatLoader::publish(size_t firstRow, size_t lastRow)
+{
+    while (!chunks_.tryPush({firstRow, lastRow}))
+    {
+        if (cancelled_.load(std::memory_order_relaxed))
+            return false;
+        std::this_thread::yield();
+    }
+    return !cancelled_.load(std::memory_order_relaxed);
+}
+
+void AsyncSplatLoader::run()
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    bool ok;
+    if (cache_ && cache_->valid())
+        ok = streamFromCache();
+    else if (options_.useCache || options_.retainHostCopy)
+        ok = loadIntoHostCopy();
+    else
+        ok = loadDirect();
+
+    if (ok)
+    {
+        long long loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << "Scene streamed: " << count_ << " splats in " << loadTime << "ms" << std::endl;
+    }
+    else if (!cancelled_.load(std::memory_order_relaxed))
+    {
+        std::cerr << "Error: background load failed: " << filename_ << std::endl;
+    }
+
+    succeeded_.store(ok, std::memory_order_release);
+    done_.store(true, std::memory_order_release);
+}
+
+bool AsyncSplatLoader::streamFromCache()
+{
+    const SplatView& view = cache_->view();
+    if (view.count != count_)
+        return false;
+    const size_t fRestPerSplat = shRestFloatsForDegree(view.fRestPerSplat, options_.ply.maxShDegree);
+
+    for (size_t first = 0; first < count_; first += options_.chunkRows)
+    {
+        const size_t last = std::min(count_, first + options_.chunkRows);
+        copyRows(view, targets_, fRestPerSplat, first, last);
+        if (!publish(first, last))
+            return false;
+    }
+
+    if (options_.retainHostCopy)
+    {
+        hostCopy_ = std::make_unique<SplatSet>();
+        hostCopy_->positions.assign(view.positions, view.positions + count_ * 3);
+        hostCopy_->f_dc.assign(view.f_dc, view.f_dc + count_ * 3);
+        hostCopy_->f_rest.assign(view.f_rest, view.f_rest + count_ * view.fRestPerSplat);
+        hostCopy_->opacity.assign(view.opacity, view.opacity + count_);
+        hostCopy_->scale.assign(view.scale, view.scale + count_ * 3);
+        hostCopy_->rotation.assign(view.rotation, view.rotation + count_ * 4);
+        hostCopy_->truncateShDegree(options_.ply.maxShDegree);
+    }
+    cache_.reset();
+    return true;
+}
+
+bool AsyncSplatLoader::loadIntoHostCopy()
+{
+    // Parse into a SplatSet (needed for the cache), forwarding each chunk to the targets.
+    auto splats = std::make_unique<SplatSet>();
+
+    PlyLoadOptions ply = options_.ply;
+    ply.chunkRows      = options_.chunkRows;
+    ply.onRowsLoaded   = [&](size_t first, size_t last)
+    {
+        if (splats->size() != count_)
+            return false;
+        const SplatView view = splats->view();
+        copyRows(view, targets_, view.fRestPerSplat, first, last);
+        return publish(first, last);
+    };
+    if (!loadPly(filename_, *splats, ply))
+        return false;
+
+    if (options_.useCache && !cancelled_.load(std::memory_order_relaxed))
+    {
+        const std::filesystem::path cachePath = splatCachePath(filename_);
+        if (writeSplatCache(cachePath, *splats, filename_))
+            std::cout << "Splat cache written: " << cachePath.string() << std::endl;
+    }
+
+    if (options_.retainHostCopy)
+        hostCopy_ = std::move(splats);
+    return true;
+}
+
+bool AsyncSplatLoader::loadDirect()
+{
+    PlyLoadOptions ply = options_.ply;
+    ply.chunkRows      = options_.chunkRows;
+    ply.onRowsLoaded   = [this](size_t first, size_t last) { return publish(first, last); };
+
+    return loadPly(filename_, [this](const PlyInfo& info, SplatTargets& targets)
+    {
+        if (info.count != count_)
+            return false;
+        auto present = [](float* target, bool has) { return has ? target : nullptr; };
+        targets.positions = present(targets_.positions, info.hasPositions);
+        targets.f_dc      = present(targets_.f_dc, info.hasFDc);
+        targets.f_rest    = present(targets_.f_rest, info.fRestPerSplat > 0);
+        targets.opacity   = present(targets_.opacity, info.hasOpacity);
+        targets.scale     = present(targets_.scale, info.hasScale);
+        targets.rotation  = present(targets_.rotation, info.hasRotation);
+        return true;
+    }, ply);
+}
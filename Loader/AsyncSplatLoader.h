@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include "PlyLoader.h"
+#include "SplatCache.h"
+#include "SpscQueue.h"
+
+// Range of splats [firstRow, lastRow) that has been fully written to the targets.
+struct SplatChunk
+{
+    size_t firstRow = 0;
+    size_t lastRow  = 0;
+};
+
+struct AsyncLoadOptions
+{
+    bool           useCache       = true;       // stream from / write the .gsbin cache
+    bool           retainHostCopy = false;      // keep a SplatSet for takeHostCopy()
+    size_t         chunkRows      = 64 * 1024;  // rows published per chunk
+    PlyLoadOptions ply;
+};
+
+// Loads a scene on a background thread into caller-provided SOA targets (e.g.
+// mapped staging buffers sized up front with peekSplatCount) and publishes each
+// finished row range through a single-producer/single-consumer queue, so a render
+// thread can upload and draw the scene while it is still loading.
+//
+// Chunks arrive in row order. The targets must stay valid until finished() is
+// true or the loader is destroyed; the destructor cancels and joins.
+//
+// Usage:
+//   PlyInfo info;
+//   auto cache = peekSplatCount("scene.ply", options, info);  // header only
+//   ... allocate targets for info.count splats ...
+//   AsyncSplatLoader loader("scene.ply", targets, info.count, options, std::move(cache));
+//   SplatChunk chunk;
+//   while (loader.popChunk(chunk))          // render thread, once per frame
+//       upload(chunk.firstRow, chunk.lastRow);
+class AsyncSplatLoader
+{
+public:
+    AsyncSplatLoader(const std::filesystem::path& filename, const SplatTargets& targets, size_t count,
+                     const AsyncLoadOptions& options, std::unique_ptr<SplatCache> cache = nullptr);
+    ~AsyncSplatLoader();
+
+    AsyncSplatLoader(const AsyncSplatLoader&)            = delete;
+    AsyncSplatLoader& operator=(const AsyncSplatLoader&) = delete;
+
+    // Consumer side: pops the next published chunk, false if none is ready yet.
+    bool popChunk(SplatChunk& chunk);
+
+    // True once the loader thread has exited and every chunk has been popped.
+    bool finished() const;
+    bool succeeded() const { return succeeded_.load(std::memory_order_acquire); }
+
+    // Host-side copy of the scene (retainHostCopy only); valid after finished().
+    std::unique_ptr<SplatSet> takeHostCopy() { return std::move(hostCopy_); }
+
+private:
+    void run();
+    bool streamFromCache();
+    bool loadIntoHostCopy();
+    bool loadDirect();
+
+    // Producer side: blocks (yielding) while the queue is full; false if cancelled.
+    bool publish(size_t firstRow, size_t lastRow);
+
+    std::filesystem::path       filename_;
+    SplatTargets                targets_;
+    size_t                      count_;
+    AsyncLoadOptions            options_;
+    std::unique_ptr<SplatCache> cache_;
+    std::unique_ptr<SplatSet>   hostCopy_;
+
+    SpscQueue<SplatChunk> chunks_{256};
+    std::atomic<bool>     cancelled_{false};
+    std::atomic<bool>     done_{false};
+    std::atomic<bool>     succeeded_{false};
+    std::thread           thread_;
+};
+
+// Finds the splat count before loading: opens the cache when options.useCache is
+// set (returned if valid, to be handed to AsyncSplatLoader), otherwise parses the
+// PLY header. Returns nullptr with info.count == 0 when the file cannot be read.
+std::unique_ptr<SplatCache> peekSplatCount(const std::filesystem::path& filename,
+                                           const AsyncLoadOptions& options, PlyInfo& info);
@@ -0,0 +1,287 @@
+#include "ChunkedScene.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <system_error>
+
+namespace
+{
+
+constexpr char     kMagic[8]   = {'G', 'S', 'C', 'H', 'U', 'N', 'K', 0};
+constexpr uint32_t kVersion    = 1;
+constexpr uint64_t kTableAlign = 256;
+constexpr uint64_t kDataAlign  = 4096; // chunk blocks start on a page so discardChunk frees whole pages
+
+struct ChunkedHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t count;
+    uint64_t chunkRows;
+    uint64_t chunkCount;
+    uint32_t fRestPerSplat;
+    uint32_t reserved;
+    uint64_t sourceSize; // size of the source file in bytes (0 = no source)
+    int64_t  sourceTime; // last_write_time of the source file, in file clock ticks
+    uint64_t dataOffset; // first chunk block; the chunk table starts at kTableAlign
+    uint64_t headerChecksum;
+};
+static_assert(sizeof(ChunkedHeader) <= kTableAlign, "chunked scene header must fit before the chunk table");
+static_assert(sizeof(SceneChunkInfo) == 32, "chunk table entries are written as-is");
+
+uint64_t headerChecksum(const ChunkedHeader& header)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&header);
+    uint64_t    hash  = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < offsetof(ChunkedHeader, headerChecksum); ++i)
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool sourceStamp(const std::filesystem::path& sourcePath, uint64_t& size, int64_t& time)
+{
+    std::error_code ec;
+    size = std::filesystem::file_size(sourcePath, ec);
+    if (ec)
+        return false;
+    time = std::filesystem::last_write_time(sourcePath, ec).time_since_epoch().count();
+    return !ec;
+}
+
+// Copies rows [first, first + rows) of `splats` into one padded chunk block.
+void fillBlock(const SplatView& splats, size_t first, size_t rows, size_t chunkRows, float* block)
+{
+    const size_t fRest = splats.fRestPerSplat;
+    float*       positions = block;
+    float*       f_dc      = positions + chunkRows * 3;
+    float*       opacity   = f_dc + chunkRows * 3;
+    float*       scale     = opacity + chunkRows;
+    float*       rotation  = scale + chunkRows * 3;
+    float*       f_rest    = rotation + chunkRows * 4;
+
+    std::memcpy(positions, splats.positions + first * 3, rows * 3 * sizeof(float));
+    std::memcpy(f_dc, splats.f_dc + first * 3, rows * 3 * sizeof(float));
+    std::memcpy(opacity, splats.opacity + first, rows * sizeof(float));
+    std::memcpy(scale, splats.scale + first * 3, rows * 3 * sizeof(float));
+    std::memcpy(rotation, splats.rotation + first * 4, rows * 4 * sizeof(float));
+    if (fRest > 0)
+        std::memcpy(f_rest, splats.f_rest + first * fRest, rows * fRest * sizeof(float));
+
+    // Padding rows: identity rotation, zero everything else, and opacity -inf so
+    // sigmoid() is exactly 0 and the projection pass culls them.
+    std::fill(positions + rows * 3, positions + chunkRows * 3, 0.0f);
+    std::fill(f_dc + rows * 3, f_dc + chunkRows * 3, 0.0f);
+    std::fill(opacity + rows, opacity + chunkRows, -std::numeric_limits<float>::infinity());
+    std::fill(scale + rows * 3, scale + chunkRows * 3, 0.0f);
+    for (size_t r = rows; r < chunkRows; ++r)
+    {
+        rotation[r * 4]     = 1.0f;
+        rotation[r * 4 + 1] = 0.0f;
+        rotation[r * 4 + 2] = 0.0f;
+        rotation[r * 4 + 3] = 0.0f;
+    }
+    std::fill(f_rest + rows * fRest, f_rest + chunkRows * fRest, 0.0f);
+}
+
+} // namespace
+
+std::filesystem::path chunkedScenePath(const std::filesystem::path& sourcePath)
+{
+    std::filesystem::path path = sourcePath;
+    path.replace_extension(".gsc");
+    return path;
+}
+
+bool isChunkedScene(const std::filesystem::path& path)
+{
+    return path.extension() == ".gsc";
+}
+
+bool writeChunkedScene(const std::filesystem::path& path, const SplatSet& splats,
+                       const std::filesystem::path& sourcePath, size_t chunkRows, uint32_t threadCount)
+{
+    const SplatView view  = splats.view();
+    const size_t    count = view.count;
+    if (count == 0 || chunkRows == 0 || splats.f_dc.size() != count * 3 || splats.opacity.size() != count ||
+        splats.scale.size() != count * 3 || splats.rotation.size() != count * 4)
+    {
+        std::cerr << "Error: chunked scenes need positions, f_dc, opacity, scale and rotation" << std::endl;
+        return false;
+    }
+
+    ChunkedHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.headerSize    = sizeof(ChunkedHeader);
+    header.count         = count;
+    header.chunkRows     = chunkRows;
+    header.chunkCount    = (count + chunkRows - 1) / chunkRows;
+    header.fRestPerSplat = static_cast<uint32_t>(view.fRestPerSplat);
+    if (!sourcePath.empty() && !sourceStamp(sourcePath, header.sourceSize, header.sourceTime))
+    {
+        std::cerr << "Warning: cannot stat " << sourcePath << ", not writing chunked scene" << std::endl;
+        return false;
+    }
+    header.dataOffset     = alignUp(kTableAlign + header.chunkCount * sizeof(SceneChunkInfo), kDataAlign);
+    header.headerChecksum = headerChecksum(header);
+
+    // Position bounds per chunk (the padding rows are not part of them).
+    std::vector<SceneChunkInfo> chunks(header.chunkCount);
+    parallelFor(chunks.size(), threadCount, 16, [&](size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            const size_t    first = c * chunkRows;
+            const size_t    rows  = std::min(chunkRows, count - first);
+            SceneChunkInfo& info  = chunks[c];
+            info.rowCount         = static_cast<uint32_t>(rows);
+            info.reserved         = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                info.boundsMin[i] = std::numeric_limits<float>::max();
+                info.boundsMax[i] = std::numeric_limits<float>::lowest();
+            }
+            for (size_t r = first; r < first + rows; ++r)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    info.boundsMin[i] = std::min(info.boundsMin[i], view.positions[r * 3 + i]);
+                    info.boundsMax[i] = std::max(info.boundsMax[i], view.positions[r * 3 + i]);
+                }
+            }
+        }
+    });
+
+    // Write to a temporary name first so a crash never leaves a truncated file behind.
+    std::filesystem::path tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Warning: cannot create chunked scene " << tmpPath << std::endl;
+            return false;
+        }
+
+        static constexpr char kPadding[kDataAlign] = {};
+        const uint64_t        tableBytes = chunks.size() * sizeof(SceneChunkInfo);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(kPadding, kTableAlign - sizeof(header));
+        out.write(reinterpret_cast<const char*>(chunks.data()), static_cast<std::streamsize>(tableBytes));
+        out.write(kPadding, static_cast<std::streamsize>(header.dataOffset - kTableAlign - tableBytes));
+
+        std::vector<float> block(chunkRows * (kChunkBaseFloats + view.fRestPerSplat));
+        for (size_t c = 0; c < chunks.size() && out; ++c)
+        {
+            fillBlock(view, c * chunkRows, chunks[c].rowCount, chunkRows, block.data());
+            out.write(reinterpret_cast<const char*>(block.data()),
+                      static_cast<std::streamsize>(block.size() * sizeof(float)));
+        }
+
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(tmpPath);
+            std::cerr << "Warning: failed to write chunked scene " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        std::cerr << "Warning: failed to move chunked scene into place: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ChunkedScene::ChunkedScene(const std::filesystem::path& path, const std::filesystem::path& sourcePath)
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec))
+        return;
+
+    file_ = std::make_unique<MappedFile>(path);
+    if (!file_->valid() || file_->size() < kTableAlign)
+        return;
+
+    ChunkedHeader header;
+    std::memcpy(&header, file_->data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.headerSize != sizeof(ChunkedHeader) || header.headerChecksum != headerChecksum(header))
+    {
+        std::cerr << "Warning: ignoring corrupt chunked scene " << path << std::endl;
+        return;
+    }
+
+    if (!sourcePath.empty() && header.sourceSize != 0)
+    {
+        uint64_t sourceSize = 0;
+        int64_t  sourceTime = 0;
+        if (!sourceStamp(sourcePath, sourceSize, sourceTime) ||
+            sourceSize != header.sourceSize || sourceTime != header.sourceTime)
+        {
+            std::cout << "Chunked scene is stale, rebuilding: " << path << std::endl;
+            return;
+        }
+    }
+
+    const uint64_t blockBytes = header.chunkRows * (kChunkBaseFloats + header.fRestPerSplat) * sizeof(float);
+    if (header.chunkRows == 0 || header.chunkCount != (header.count + header.chunkRows - 1) / header.chunkRows ||
+        header.dataOffset < kTableAlign + header.chunkCount * sizeof(SceneChunkInfo) ||
+        header.dataOffset > file_->size() || (file_->size() - header.dataOffset) / blockBytes < header.chunkCount)
+    {
+        std::cerr << "Warning: ignoring truncated chunked scene " << path << std::endl;
+        return;
+    }
+
+    chunks_        = reinterpret_cast<const SceneChunkInfo*>(file_->data() + kTableAlign);
+    dataOffset_    = header.dataOffset;
+    count_         = header.count;
+    chunkRows_     = header.chunkRows;
+    chunkCount_    = header.chunkCount;
+    fRestPerSplat_ = header.fRestPerSplat;
+    valid_         = true;
+}
+
+ChunkedScene::~ChunkedScene() = default;
+
+const float* ChunkedScene::chunkData(size_t index) const
+{
+    return reinterpret_cast<const float*>(file_->data() + dataOffset_ + index * chunkBytes());
+}
+
+SplatView ChunkedScene::chunkView(size_t index) const
+{
+    const float* block = chunkData(index);
+    SplatView    view;
+    view.count         = chunks_[index].rowCount;
+    view.fRestPerSplat = fRestPerSplat_;
+    view.positions     = block;
+    view.f_dc          = view.positions + chunkRows_ * 3;
+    view.opacity       = view.f_dc + chunkRows_ * 3;
+    view.scale         = view.opacity + chunkRows_;
+    view.rotation      = view.scale + chunkRows_ * 3;
+    view.f_rest        = fRestPerSplat_ > 0 ? view.rotation + chunkRows_ * 4 : nullptr;
+    return view;
+}
+
+void ChunkedScene::discardChunk(size_t index) const
+{
+    file_->discard(dataOffset_ + index * chunkBytes(), chunkBytes());
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include "SplatSet.h"
+
+class MappedFile;
+
+// Streamable on-disk scene split into spatial chunks (.gsc), for out-of-core rendering.
+//
+// The splats are expected in Morton order (reorderMorton), so every run of
+// `chunkRows` consecutive rows is a compact region of space. Each chunk is stored
+// as one contiguous block holding its rows SOA (positions, f_dc, opacity, scale,
+// rotation, then f_rest), padded to exactly `chunkRows` rows with invisible splats
+// (opacity -inf), so a chunk is always read and uploaded as a fixed-size block
+// into a fixed-size GPU slot. A table of per-chunk position bounds follows the
+// header, so residency decisions never touch the chunk data itself.
+//
+// Usage:
+//   SplatSet splats;
+//   loadSplatScene("scene.ply", splats);
+//   reorderMorton(splats);
+//   writeChunkedScene(chunkedScenePath("scene.ply"), splats, "scene.ply");
+//
+//   ChunkedScene scene(chunkedScenePath("scene.ply"), "scene.ply");
+//   for (size_t c = 0; c < scene.chunkCount(); ++c)
+//       if (visible(scene.chunk(c))) upload(scene.chunkData(c), scene.chunkBytes());
+
+inline constexpr size_t kDefaultSceneChunkRows = 64 * 1024;
+
+// Floats per row in a chunk block before f_rest: 3 + 3 + 1 + 3 + 4.
+inline constexpr size_t kChunkBaseFloats = 14;
+
+struct SceneChunkInfo
+{
+    float    boundsMin[3];
+    float    boundsMax[3];
+    uint32_t rowCount; // real rows; the block is padded to chunkRows
+    uint32_t reserved;
+};
+
+// Chunked scene location for a source file: same directory, ".gsc" extension.
+std::filesystem::path chunkedScenePath(const std::filesystem::path& sourcePath);
+
+bool isChunkedScene(const std::filesystem::path& path);
+
+// Writes `splats` (spatially ordered) as chunks of `chunkRows` rows. `sourcePath` is
+// recorded so stale files are rejected after the source changes (empty = none).
+bool writeChunkedScene(const std::filesystem::path& path, const SplatSet& splats,
+                       const std::filesystem::path& sourcePath, size_t chunkRows = kDefaultSceneChunkRows,
+                       uint32_t threadCount = 0);
+
+class ChunkedScene
+{
+public:
+    // Maps `path` read-only; invalid if missing, corrupt or stale against `sourcePath`.
+    ChunkedScene(const std::filesystem::path& path, const std::filesystem::path& sourcePath);
+    ~ChunkedScene();
+
+    ChunkedScene(const ChunkedScene&)            = delete;
+    ChunkedScene& operator=(const ChunkedScene&) = delete;
+
+    bool   valid() const { return valid_; }
+    size_t size() const { return count_; }
+    size_t chunkRows() const { return chunkRows_; }
+    size_t chunkCount() const { return chunkCount_; }
+    size_t fRestPerSplat() const { return fRestPerSplat_; }
+
+    const SceneChunkInfo& chunk(size_t index) const { return chunks_[index]; }
+
+    // Whole block of chunk `index`: chunkRows() rows of each array, in the order
+    // positions, f_dc, opacity, scale, rotation, f_rest. Faults pages in on access.
+    const float* chunkData(size_t index) const;
+    size_t       chunkBytes() const { return chunkRows_ * (kChunkBaseFloats + fRestPerSplat_) * sizeof(float); }
+
+    // Real rows of chunk `index` as a view into the mapping.
+    SplatView chunkView(size_t index) const;
+
+    // Drops the pages of chunk `index` from the working set once it has been copied out.
+    void discardChunk(size_t index) const;
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    const SceneChunkInfo*       chunks_        = nullptr;
+    uint64_t                    dataOffset_    = 0;
+    size_t                      count_         = 0;
+    size_t                      chunkRows_     = 0;
+    size_t                      chunkCount_    = 0;
+    size_t                      fRestPerSplat_ = 0;
+    bool                        valid_         = false;
+};
@@ -0,0 +1,71 @@
+#include "Covariance.h"
+#include "ParallelFor.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+constexpr size_t kMinRowsPerTask = 64 * 1024;
+
+} // namespace
+
+void computeCovariance(const float* logScale, const float* rotation, float* covariance)
+{
+    // Quaternion (w, x, y, z); unnormalized files are common, so normalize like 3DGS training does.
+    float       w = rotation[0], x = rotation[1], y = rotation[2], z = rotation[3];
+    const float length = std::sqrt(w * w + x * x + y * y + z * z);
+    if (length > 0.0f)
+    {
+        w /= length;
+        x /= length;
+        y /= length;
+        z /= length;
+    }
+    else
+    {
+        w = 1.0f;
+    }
+
+    const float r[3][3] = {
+        {1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y)},
+        {2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x)},
+        {2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y)},
+    };
+
+    // M = R·S, so Σ = M·Mᵀ and Σij = Σk Rik·Rjk·sk².
+    const float s2[3] = {std::exp(2.0f * logScale[0]), std::exp(2.0f * logScale[1]), std::exp(2.0f * logScale[2])};
+    auto sigma = [&](int i, int j)
+    {
+        return r[i][0] * r[j][0] * s2[0] + r[i][1] * r[j][1] * s2[1] + r[i][2] * r[j][2] * s2[2];
+    };
+    covariance[0] = sigma(0, 0);
+    covariance[1] = sigma(0, 1);
+    covariance[2] = sigma(0, 2);
+    covariance[3] = sigma(1, 1);
+    covariance[4] = sigma(1, 2);
+    covariance[5] = sigma(2, 2);
+}
+
+bool precomputeSplatRows(const SplatView& splats, size_t firstRow, size_t lastRow,
+                         float* covariance, float* opacity, uint32_t threadCount)
+{
+    if ((covariance && (!splats.scale || !splats.rotation)) || (opacity && !splats.opacity))
+    {
+        std::cerr << "Error: covariance precompute needs scale, rotation and opacity" << std::endl;
+        return false;
+    }
+
+    parallelFor(lastRow - firstRow, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t r = firstRow + begin; r < firstRow + end; ++r)
+        {
+            if (covariance)
+                computeCovariance(splats.scale + r * 3, splats.rotation + r * 4, covariance + r * kCovarianceFloats);
+            if (opacity)
+                opacity[r] = 1.0f / (1.0f + std::exp(-splats.opacity[r]));
+        }
+    });
+    return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "SplatSet.h"
+
+// Static per-splat terms of the projection, evaluated once at load instead of on
+// every frame by proj.comp:
+//   covariance  upper triangle of Σ = R·S·Sᵀ·Rᵀ, 6 floats (xx, xy, xz, yy, yz, zz),
+//               with S = diag(exp(scale)) and R from the normalized rotation
+//   opacity     sigmoid(opacity)
+// 7 floats per splat instead of the 8 of scale + rotation + raw opacity, and no
+// exp / quaternion / matrix products left in the per-frame shader.
+//
+// Usage:
+//   std::vector<float> covariance(count * kCovarianceFloats), alpha(count);
+//   precomputeSplatRows(splats.view(), 0, count, covariance.data(), alpha.data());
+
+inline constexpr size_t kCovarianceFloats = 6;
+
+void computeCovariance(const float* logScale, const float* rotation, float* covariance);
+
+// Rows [firstRow, lastRow) of `splats` (scale, rotation and opacity must be present)
+// into `covariance` / `opacity`, indexed by absolute row; either target may be null.
+// Split across `threadCount` workers (0 = hardware concurrency).
+bool precomputeSplatRows(const SplatView& splats, size_t firstRow, size_t lastRow,
+                         float* covariance, float* opacity, uint32_t threadCount = 0);
@@ -0,0 +1,174 @@
+#include "HalfFloat.h"
+#include "ParallelFor.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GS_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define GS_TARGET_F16C
+#else
+#define GS_TARGET_F16C __attribute__((target("avx,f16c")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+constexpr size_t kMinPerTask = 256 * 1024;
+
+void packScalar(const float* src, uint16_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = floatToHalf(src[i]);
+}
+
+#ifdef GS_SIMD_X86
+GS_TARGET_F16C void packF16c(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+    packScalar(src + i, dst + i, count - i);
+}
+
+bool cpuHasF16c()
+{
+    // F16C uses the VEX encoding, so it also needs the OS AVX state check done for AVX2.
+    if (detectSimdLevel() != SimdLevel::Avx2)
+        return false;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 29)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("f16c");
+#endif
+}
+#endif
+
+#ifdef GS_SIMD_NEON
+void packNeon(const float* src, uint16_t* dst, size_t count)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    packScalar(src + i, dst + i, count - i);
+}
+#endif
+
+} // namespace
+
+uint16_t floatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t absBits = bits & 0x7fffffffu;
+
+    if (absBits >= 0x7f800000u) // inf / NaN (quiet, keep the top mantissa bits)
+        return static_cast<uint16_t>(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x0200u | ((absBits >> 13) & 0x3ffu) : 0u));
+    if (absBits >= 0x477ff000u) // rounds past 65504
+        return static_cast<uint16_t>(sign | 0x7c00u);
+
+    if (absBits < 0x38800000u) // below the smallest normal half: denormal or zero
+    {
+        if (absBits < 0x33000000u) // < 2^-25 rounds to zero
+            return static_cast<uint16_t>(sign);
+        const uint32_t exponent = absBits >> 23;
+        const uint32_t mantissa = (absBits & 0x7fffffu) | 0x800000u;
+        const uint32_t shift    = 126 - exponent; // 14..24
+        uint32_t       half     = mantissa >> shift;
+        const uint32_t rest     = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway  = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u)))
+            ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    // Normal: rebias the exponent, then round the 13 dropped mantissa bits to nearest even.
+    uint32_t half = ((absBits - 0x38000000u) >> 13);
+    const uint32_t rest = absBits & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u)))
+        ++half; // a carry into the exponent is still the correctly rounded value
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t half)
+{
+    const uint32_t sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1fu;
+    uint32_t       mantissa = half & 0x3ffu;
+
+    uint32_t bits;
+    if (exponent == 0x1f)
+    {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    else if (mantissa == 0)
+    {
+        bits = sign;
+    }
+    else
+    {
+        // Denormal half → normal float.
+        uint32_t e = 113;
+        while ((mantissa & 0x400u) == 0)
+        {
+            mantissa <<= 1;
+            --e;
+        }
+        bits = sign | (e << 23) | ((mantissa & 0x3ffu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void packHalf(const float* src, uint16_t* dst, size_t count, uint32_t threadCount, SimdLevel level)
+{
+#ifdef GS_SIMD_X86
+    static const bool hasF16c = cpuHasF16c();
+    const bool useF16c = level == SimdLevel::Avx2 && hasF16c;
+#endif
+
+    parallelFor(count, threadCount, kMinPerTask, [&](size_t first, size_t last)
+    {
+        switch (level)
+        {
+#ifdef GS_SIMD_X86
+        case SimdLevel::Avx2:
+            if (useF16c)
+            {
+                packF16c(src + first, dst + first, last - first);
+                break;
+            }
+            packScalar(src + first, dst + first, last - first);
+            break;
+#endif
+#ifdef GS_SIMD_NEON
+        case SimdLevel::Neon:
+            packNeon(src + first, dst + first, last - first);
+            break;
+#endif
+        default:
+            packScalar(src + first, dst + first, last - first);
+            break;
+        }
+    });
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "SignFlip.h"
+
+// fp32 → IEEE 754 binary16 packing for GPU storage.
+//
+// Halves are stored tightly (element i at byte 2*i), so a GLSL shader reading the
+// buffer as uint[] finds element i in unpackHalf2x16(words[i >> 1])[i & 1].
+// Rounding is to nearest even, matching F16C / NEON, so every kernel produces the
+// same bits. Values beyond the half range become ±inf.
+//
+// Usage:
+//   std::vector<uint16_t> halves(count * 3);
+//   packHalf(scales, halves.data(), count * 3, threadCount);
+
+uint16_t floatToHalf(float value);
+float    halfToFloat(uint16_t half);
+
+// dst[i] = floatToHalf(src[i]) for i < count, split across `threadCount` workers
+// (0 = hardware concurrency). `dst` may point into mapped upload memory.
+void packHalf(const float* src, uint16_t* dst, size_t count, uint32_t threadCount,
+              SimdLevel level = detectSimdLevel());
+
+// Bytes needed for `count` tightly packed halves, rounded up to whole 32-bit words.
+inline size_t packedHalfBytes(size_t count)
+{
+    return (count + 1) / 2 * 4;
+}
@@ -0,0 +1,126 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::filesystem::path& filename)
+{
+    HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    file_    = file;
+    mapping_ = mapping;
+    data_    = static_cast<const uint8_t*>(view);
+    size_    = static_cast<size_t>(fileSize.QuadPart);
+}
+
+void MappedFile::discard(size_t offset, size_t size) const
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    const size_t page  = info.dwPageSize;
+    const size_t begin = (offset + page - 1) / page * page;
+    const size_t end   = (offset + size) / page * page;
+    if (data_ && begin < end)
+    {
+        // On a range that is not locked, VirtualUnlock trims the pages from the working set.
+        VirtualUnlock(const_cast<uint8_t*>(data_) + begin, end - begin);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    if (file_)
+        CloseHandle(static_cast<HANDLE>(file_));
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        close(fd);
+        return;
+    }
+
+    // Rows are consumed front to back; let the kernel read ahead aggressively.
+    madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+    fd_   = fd;
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+}
+
+void MappedFile::discard(size_t offset, size_t size) const
+{
+    const size_t page  = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = (offset + page - 1) / page * page;
+    const size_t end   = (offset + size) / page * page;
+    if (data_ && begin < end)
+        madvise(const_cast<uint8_t*>(data_) + begin, end - begin, MADV_DONTNEED);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_)
+        munmap(const_cast<uint8_t*>(data_), size_);
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file.
+// Pages are faulted in on first access, so parsing straight from data()
+// avoids staging the file contents in an intermediate heap buffer.
+//
+// Usage:
+//   MappedFile file("scene.ply");
+//   if (file.valid()) {
+//       const uint8_t* bytes = file.data(); // file.size() bytes
+//   }
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool           valid() const { return data_ != nullptr; }
+    const uint8_t* data() const { return data_; }
+    size_t         size() const { return size_; }
+
+    // Hints that [offset, offset + size) will not be read again, so its pages can
+    // leave the working set now instead of when the mapping is closed. Only whole
+    // pages inside the range are affected; the data stays readable.
+    void discard(size_t offset, size_t size) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t         size_ = 0;
+
+#ifdef _WIN32
+    void* file_    = nullptr; // HANDLE
+    void* mapping_ = nullptr; // HANDLE
+#else
+    int fd_ = -1;
+#endif
+};
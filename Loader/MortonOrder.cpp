@@ -0,0 +1,240 @@
+#include "MortonOrder.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+
+constexpr size_t kMinRowsPerTask = 64 * 1024;
+
+// Spreads the low 10 bits of v so there are two zero bits between each.
+uint32_t spreadBits10(uint32_t v)
+{
+    v &= 0x3ffu;
+    v = (v | (v << 16)) & 0x030000ffu;
+    v = (v | (v << 8)) & 0x0300f00fu;
+    v = (v | (v << 4)) & 0x030c30c3u;
+    v = (v | (v << 2)) & 0x09249249u;
+    return v;
+}
+
+// Same for the low 21 bits, into 63 bits.
+uint64_t spreadBits21(uint64_t v)
+{
+    v &= 0x1fffffull;
+    v = (v | (v << 32)) & 0x001f00000000ffffull;
+    v = (v | (v << 16)) & 0x001f0000ff0000ffull;
+    v = (v | (v << 8)) & 0x100f00f00f00f00full;
+    v = (v | (v << 4)) & 0x10c30c30c30c30c3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+
+struct Bounds
+{
+    float minValue[3] = {INFINITY, INFINITY, INFINITY};
+    float maxValue[3] = {-INFINITY, -INFINITY, -INFINITY};
+};
+
+Bounds positionBounds(const SplatView& splats, uint32_t threadCount)
+{
+    Bounds     bounds;
+    std::mutex mutex;
+    parallelFor(splats.count, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+    {
+        Bounds local;
+        for (size_t r = begin; r < end; ++r)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                const float v = splats.positions[r * 3 + i];
+                if (std::isfinite(v))
+                {
+                    local.minValue[i] = std::min(local.minValue[i], v);
+                    local.maxValue[i] = std::max(local.maxValue[i], v);
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int i = 0; i < 3; ++i)
+        {
+            bounds.minValue[i] = std::min(bounds.minValue[i], local.minValue[i]);
+            bounds.maxValue[i] = std::max(bounds.maxValue[i], local.maxValue[i]);
+        }
+    });
+    return bounds;
+}
+
+// Maps positions onto a (maxCell + 1)^3 grid over the bounds; non-finite values go to cell 0.
+struct CellGrid
+{
+    float    origin[3];
+    float    scale[3];
+    uint32_t maxCell;
+
+    CellGrid(const Bounds& bounds, uint32_t maxCellIndex) : maxCell(maxCellIndex)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const float extent = bounds.maxValue[i] - bounds.minValue[i];
+            origin[i]          = std::isfinite(bounds.minValue[i]) ? bounds.minValue[i] : 0.0f;
+            scale[i]           = extent > 0.0f ? static_cast<float>(maxCell + 1) / extent : 0.0f;
+        }
+    }
+
+    uint32_t cell(const float* position, int axis) const
+    {
+        const float v = (position[axis] - origin[axis]) * scale[axis];
+        return v >= 0.0f ? std::min(maxCell, static_cast<uint32_t>(v)) : 0u;
+    }
+};
+
+struct WideKey
+{
+    uint64_t code;
+    uint32_t row;
+
+    bool operator<(const WideKey& other) const
+    {
+        return code != other.code ? code < other.code : row < other.row;
+    }
+};
+
+// Sorts runs in parallel, then merges neighbouring runs pairwise until one is left.
+template <class Key>
+void parallelSort(std::vector<Key>& keys, uint32_t threadCount)
+{
+    const size_t count   = keys.size();
+    const size_t runs    = std::min<size_t>(resolveThreadCount(threadCount),
+                                             std::max<size_t>(1, count / kMinRowsPerTask));
+    const size_t runSize = (count + runs - 1) / runs;
+
+    parallelFor(runs, static_cast<uint32_t>(runs), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t r = begin; r < end; ++r)
+            std::sort(keys.begin() + r * runSize, keys.begin() + std::min(count, (r + 1) * runSize));
+    });
+
+    for (size_t width = runSize; width < count; width *= 2)
+    {
+        const size_t pairs = (count + 2 * width - 1) / (2 * width);
+        parallelFor(pairs, threadCount, 1, [&](size_t begin, size_t end)
+        {
+            for (size_t p = begin; p < end; ++p)
+            {
+                const size_t first = p * 2 * width;
+                const size_t mid   = std::min(count, first + width);
+                const size_t last  = std::min(count, first + 2 * width);
+                if (mid < last)
+                    std::inplace_merge(keys.begin() + first, keys.begin() + mid, keys.begin() + last);
+            }
+        });
+    }
+}
+
+} // namespace
+
+uint32_t mortonCode30(uint32_t x, uint32_t y, uint32_t z)
+{
+    return spreadBits10(x) | spreadBits10(y) << 1 | spreadBits10(z) << 2;
+}
+
+uint64_t mortonCode63(uint32_t x, uint32_t y, uint32_t z)
+{
+    return spreadBits21(x) | spreadBits21(y) << 1 | spreadBits21(z) << 2;
+}
+
+std::vector<uint32_t> mortonOrder(const SplatView& splats, MortonPrecision precision, uint32_t threadCount)
+{
+    const size_t          count = splats.count;
+    std::vector<uint32_t> order(count);
+    if (count == 0 || !splats.positions)
+    {
+        for (size_t r = 0; r < count; ++r)
+            order[r] = static_cast<uint32_t>(r);
+        return order;
+    }
+
+    const Bounds bounds = positionBounds(splats, threadCount);
+
+    if (precision == MortonPrecision::Bits30)
+    {
+        // code << 32 | row: one integer compare per key, and ties keep file order.
+        const CellGrid        grid(bounds, 1023);
+        std::vector<uint64_t> keys(count);
+        parallelFor(count, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+        {
+            for (size_t r = begin; r < end; ++r)
+            {
+                const float* p = splats.positions + r * 3;
+                keys[r] = static_cast<uint64_t>(mortonCode30(grid.cell(p, 0), grid.cell(p, 1), grid.cell(p, 2))) << 32 | r;
+            }
+        });
+        parallelSort(keys, threadCount);
+        parallelFor(count, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+        {
+            for (size_t r = begin; r < end; ++r)
+                order[r] = static_cast<uint32_t>(keys[r]);
+        });
+    }
+    else
+    {
+        const CellGrid       grid(bounds, (1u << 21) - 1);
+        std::vector<WideKey> keys(count);
+        parallelFor(count, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+        {
+            for (size_t r = begin; r < end; ++r)
+            {
+                const float* p = splats.positions + r * 3;
+                keys[r] = {mortonCode63(grid.cell(p, 0), grid.cell(p, 1), grid.cell(p, 2)), static_cast<uint32_t>(r)};
+            }
+        });
+        parallelSort(keys, threadCount);
+        parallelFor(count, threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+        {
+            for (size_t r = begin; r < end; ++r)
+                order[r] = keys[r].row;
+        });
+    }
+    return order;
+}
+
+void permuteRows(const float* src, size_t width, const std::vector<uint32_t>& order, float* dst,
+                 uint32_t threadCount)
+{
+    parallelFor(order.size(), threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t r = begin; r < end; ++r)
+            std::memcpy(dst + r * width, src + static_cast<size_t>(order[r]) * width, width * sizeof(float));
+    });
+}
+
+void permuteSplats(const SplatView& src, const std::vector<uint32_t>& order, SplatSet& dst, uint32_t threadCount)
+{
+    const size_t count = order.size();
+    auto gather = [&](const float* source, size_t width, std::vector<float>& out)
+    {
+        out.resize(source ? count * width : 0);
+        if (source && width > 0)
+            permuteRows(source, width, order, out.data(), threadCount);
+    };
+    gather(src.positions, 3, dst.positions);
+    gather(src.f_dc, 3, dst.f_dc);
+    gather(src.f_rest, src.fRestPerSplat, dst.f_rest);
+    gather(src.opacity, 1, dst.opacity);
+    gather(src.scale, 3, dst.scale);
+    gather(src.rotation, 4, dst.rotation);
+}
+
+std::vector<uint32_t> reorderMorton(SplatSet& splats, MortonPrecision precision, uint32_t threadCount)
+{
+    std::vector<uint32_t> order = mortonOrder(splats.view(), precision, threadCount);
+    SplatSet              ordered;
+    permuteSplats(splats.view(), order, ordered, threadCount);
+    splats = std::move(ordered);
+    return order;
+}
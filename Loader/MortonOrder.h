@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include "SplatSet.h"
+
+// Load-time spatial reordering of splats along a Morton (Z-order) curve.
+//
+// Positions are normalized to the scene bounds and quantized to 10 bits per axis
+// (30-bit codes) or 21 bits per axis (63-bit codes, for large scenes where 1024
+// cells per axis put many splats into the same cell). Splats are then sorted by
+// code, so neighbouring rows are neighbours in space: the projection shader reads
+// and writes coherent memory, and each workgroup's splats land in few tiles.
+//
+// The permutation is exposed so splats that cannot be reordered in place (a
+// read-only mapped .gsbin cache) can be gathered into a copy, and extra per-row
+// arrays can follow the same order: output row i holds source row order[i].
+//
+// Usage:
+//   reorderMorton(splats);                                  // SplatSet now in Morton order
+//   std::vector<uint32_t> order = mortonOrder(cache->view());
+//   permuteSplats(cache->view(), order, ordered);           // mapped view → ordered copy
+
+enum class MortonPrecision
+{
+    Bits30, // 10 bits per axis, keys sort as one uint64 (code << 32 | row)
+    Bits63, // 21 bits per axis
+};
+
+// Interleaves the low 10 (30-bit) or 21 (63-bit) bits of x, y and z as ...zyxzyx.
+uint32_t mortonCode30(uint32_t x, uint32_t y, uint32_t z);
+uint64_t mortonCode63(uint32_t x, uint32_t y, uint32_t z);
+
+// Sorted-by-code row order of `splats` (ties keep file order). Codes, sorting and
+// the bounds reduction are split across `threadCount` workers (0 = hardware concurrency).
+std::vector<uint32_t> mortonOrder(const SplatView& splats, MortonPrecision precision = MortonPrecision::Bits30,
+                                  uint32_t threadCount = 0);
+
+// dst row i = src row order[i], `width` floats per row.
+void permuteRows(const float* src, size_t width, const std::vector<uint32_t>& order, float* dst,
+                 uint32_t threadCount = 0);
+
+// Gathers every present array of `src` into `dst` in the given order.
+void permuteSplats(const SplatView& src, const std::vector<uint32_t>& order, SplatSet& dst,
+                   uint32_t threadCount = 0);
+
+// mortonOrder + permuteSplats in place; returns the permutation.
+std::vector<uint32_t> reorderMorton(SplatSet& splats, MortonPrecision precision = MortonPrecision::Bits30,
+                                    uint32_t threadCount = 0);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Resolves a requested worker count: 0 means one worker per hardware thread.
+inline uint32_t resolveThreadCount(uint32_t threadCount)
+{
+    if (threadCount != 0)
+        return threadCount;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Splits [0, count) into contiguous ranges and runs fn(begin, end) for each range
+// on its own worker thread. The calling thread takes the first range, so a single
+// range (small inputs or threadCount == 1) runs inline without spawning anything.
+// Ranges are never smaller than `minRangeSize` items.
+template <class Fn>
+void parallelFor(size_t count, uint32_t threadCount, size_t minRangeSize, Fn&& fn)
+{
+    if (count == 0)
+        return;
+
+    const size_t maxRanges  = std::max<size_t>(1, count / std::max<size_t>(1, minRangeSize));
+    const size_t rangeCount = std::min<size_t>(resolveThreadCount(threadCount), maxRanges);
+    const size_t rangeSize  = (count + rangeCount - 1) / rangeCount;
+
+    std::vector<std::thread> workers;
+    workers.reserve(rangeCount - 1);
+    for (size_t r = 1; r < rangeCount; ++r)
+    {
+        const size_t begin = r * rangeSize;
+        const size_t end   = std::min(count, begin + rangeSize);
+        if (begin >= end)
+            break;
+        workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+    }
+
+    fn(size_t{0}, std::min(count, rangeSize));
+
+    for (auto& worker : workers)
+        worker.join();
+}
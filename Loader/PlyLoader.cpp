@@ -1,88 +1,483 @@
 #include "PlyLoader.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "SignFlip.h"
 #include "miniply.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
 
-bool loadPly(const std::filesystem::path& filename, SplatSet& output, bool convertToRub)
+namespace
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
 
-    // Open the PLY file
-    miniply::PLYReader reader(filename.string().c_str());
-    if (!reader.valid())
+// Property indices of the INRIA 3DGS vertex layout within a PLY vertex element.
+struct SplatProperties
+{
+    uint32_t fRest[45];
+    uint32_t fRestCoeffs = 0; // selected coefficients per color channel (0, 3, 8 or 15)
+    uint32_t fRestCount  = 0; // fRestCoeffs * 3
+    uint32_t position[3];
+    uint32_t opacity[1];
+    uint32_t scale[3];
+    uint32_t rotation[4];
+    uint32_t fDc[3];
+
+    bool hasFRest    = false;
+    bool hasPosition = false;
+    bool hasOpacity  = false;
+    bool hasScale    = false;
+    bool hasRotation = false;
+    bool hasFDc      = false;
+};
+
+SplatProperties findSplatProperties(const miniply::PLYElement& elem, int32_t maxShDegree)
+{
+    SplatProperties props;
+
+    // Spherical harmonics: f_rest_0 .. f_rest_{3k-1}, channel-major (k coefficients of R,
+    // then G, then B) with k = 3, 8 or 15 for degree 1, 2 or 3. Only the first
+    // kShCoeffsPerChannel[maxShDegree] coefficients of each channel are selected, so
+    // higher bands are never read from the file.
+    uint32_t fileCount = 0;
+    char     name[16];
+    for (; fileCount < 45; ++fileCount)
     {
-        std::cerr << "Error: failed to open PLY file: " << filename << std::endl;
+        std::snprintf(name, sizeof(name), "f_rest_%u", fileCount);
+        if (elem.find_property(name) == miniply::kInvalidIndex)
+            break;
+    }
+
+    const uint32_t fileStride = fileCount / 3;
+    const uint32_t maxKeep    = kShCoeffsPerChannel[std::clamp(maxShDegree, 0, 3)];
+    uint32_t       keep       = 0;
+    for (uint32_t coeffs : kShCoeffsPerChannel)
+    {
+        if (coeffs <= fileStride && coeffs <= maxKeep)
+            keep = coeffs;
+    }
+
+    for (uint32_t c = 0; c < 3 && keep > 0; ++c)
+    {
+        for (uint32_t j = 0; j < keep; ++j)
+        {
+            std::snprintf(name, sizeof(name), "f_rest_%u", c * fileStride + j);
+            props.fRest[c * keep + j] = elem.find_property(name);
+        }
+    }
+    props.fRestCoeffs = keep;
+    props.fRestCount  = keep * 3;
+    props.hasFRest    = keep > 0;
+
+    props.hasPosition = elem.find_properties(props.position, 3, "x", "y", "z");
+    props.hasOpacity  = elem.find_properties(props.opacity, 1, "opacity");
+    props.hasScale    = elem.find_properties(props.scale, 3, "scale_0", "scale_1", "scale_2");
+    props.hasRotation = elem.find_properties(props.rotation, 4, "rot_0", "rot_1", "rot_2", "rot_3");
+    props.hasFDc      = elem.find_properties(props.fDc, 3, "f_dc_0", "f_dc_1", "f_dc_2");
+
+    return props;
+}
+
+bool allFloat(const miniply::PLYElement& elem, const uint32_t propIdxs[], uint32_t numProps)
+{
+    for (uint32_t i = 0; i < numProps; ++i)
+    {
+        if (elem.properties[propIdxs[i]].type != miniply::PLYPropertyType::Float)
+            return false;
+    }
+    return true;
+}
+
+// The mapped path reads rows in place, so every property we extract must
+// already be a little-endian float in the file.
+bool canReadInPlace(const miniply::PLYElement& elem, const SplatProperties& props)
+{
+    if constexpr (std::endian::native != std::endian::little)
         return false;
+
+    if (!elem.fixedSize)
+        return false;
+
+    return (!props.hasFRest    || allFloat(elem, props.fRest, props.fRestCount)) &&
+           (!props.hasPosition || allFloat(elem, props.position, 3)) &&
+           (!props.hasOpacity  || allFloat(elem, props.opacity, 1)) &&
+           (!props.hasScale    || allFloat(elem, props.scale, 3)) &&
+           (!props.hasRotation || allFloat(elem, props.rotation, 4)) &&
+           (!props.hasFDc      || allFloat(elem, props.fDc, 3));
+}
+
+// Returns the byte offset of the first data row (just past the "end_header" line), or 0 if
+// not found. Walks the header line by line and stops at the first "end_header" line, so only
+// the header's pages are touched. Trailing spaces / tabs / '\r' are accepted like miniply does
+// (CRLF headers). Gives up after kMaxHeaderBytes instead of scanning into the data.
+size_t findDataOffset(const uint8_t* data, size_t size)
+{
+    static constexpr char   kEndHeader[]    = "end_header";
+    static constexpr size_t kEndHeaderLen   = sizeof(kEndHeader) - 1;
+    static constexpr size_t kMaxHeaderBytes = 1 << 20;
+
+    const size_t limit = std::min(size, kMaxHeaderBytes);
+    size_t       line  = 0;
+    while (line < limit)
+    {
+        const auto* newline = static_cast<const uint8_t*>(std::memchr(data + line, '\n', limit - line));
+        if (newline == nullptr)
+            return 0;
+        const size_t lineEnd = static_cast<size_t>(newline - data);
+
+        if (lineEnd - line >= kEndHeaderLen && std::memcmp(data + line, kEndHeader, kEndHeaderLen) == 0)
+        {
+            size_t i = line + kEndHeaderLen;
+            while (i < lineEnd && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r'))
+                ++i;
+            if (i == lineEnd)
+                return lineEnd + 1;
+        }
+        line = lineEnd + 1;
     }
+    return 0;
+}
 
-    uint32_t indices[45];
-    bool     gsFound = false;
+// One destination array of the fused row scatter: `width` floats per splat,
+// gathered from the given byte offsets within a PLY row. `signMasks` are XORed
+// into the raw bits, which applies the RDF → RUB axis flips during the copy.
+struct FieldGroup
+{
+    float*   dest       = nullptr;
+    uint32_t width      = 0;
+    uint32_t srcOffsets[45];
+    uint32_t signMasks[45];
+    bool     contiguous = false; // consecutive floats in the row → one memcpy per row
+    bool     flips      = false; // any non-zero sign mask
+};
 
-    while (reader.has_element() && !gsFound)
+// Offset table for scattering a whole PLY row into every target array in one pass.
+// Built once from the PLYElement property layout, then shared by all workers.
+struct RowScatterTable
+{
+    std::array<FieldGroup, 6> groups;
+    uint32_t                  groupCount = 0;
+
+    // `flipIdx` lists the components (within the group) whose sign changes under RDF → RUB.
+    void add(const miniply::PLYElement& elem, const uint32_t propIdxs[], uint32_t numProps,
+             float* dest, std::initializer_list<uint32_t> flipIdx = {})
     {
-        if (reader.element_is(miniply::kPLYVertexElement) && reader.load_element())
+        if (dest == nullptr)
+            return;
+
+        FieldGroup& group = groups[groupCount++];
+        group.dest        = dest;
+        group.width       = numProps;
+        group.contiguous  = true;
+        for (uint32_t i = 0; i < numProps; ++i)
         {
-            const uint32_t numVerts = reader.num_rows();
-            if (numVerts == 0)
+            group.srcOffsets[i] = elem.properties[propIdxs[i]].offset;
+            group.signMasks[i]  = 0;
+            if (i > 0 && group.srcOffsets[i] != group.srcOffsets[i - 1] + sizeof(float))
+                group.contiguous = false;
+        }
+        for (uint32_t i : flipIdx)
+        {
+            group.signMasks[i] = kSignBit;
+            group.flips        = true;
+        }
+    }
+
+    // Visit groups in file order so each row is read front to back.
+    void sortBySourceOffset()
+    {
+        for (uint32_t i = 1; i < groupCount; ++i)
+        {
+            for (uint32_t j = i; j > 0 && groups[j].srcOffsets[0] < groups[j - 1].srcOffsets[0]; --j)
+                std::swap(groups[j], groups[j - 1]);
+        }
+    }
+};
+
+RowScatterTable buildScatterTable(const miniply::PLYElement& elem, const SplatProperties& props,
+                                  const SplatTargets& targets, bool convertToRub)
+{
+    RowScatterTable table;
+    if (props.hasFRest)
+    {
+        table.add(elem, props.fRest, props.fRestCount, targets.f_rest);
+        if (convertToRub && targets.f_rest)
+        {
+            // f_rest is channel-major: fRestCoeffs coefficients of R, then G, then B.
+            FieldGroup& group = table.groups[table.groupCount - 1];
+            for (uint32_t i = 0; i < props.fRestCount; ++i)
+                group.signMasks[i] = kRdfToRubShFlip[i % props.fRestCoeffs] < 0.0f ? kSignBit : 0u;
+            group.flips = true;
+        }
+    }
+    if (props.hasPosition)
+        table.add(elem, props.position, 3, targets.positions, convertToRub ? std::initializer_list<uint32_t>{1, 2}
+                                                                            : std::initializer_list<uint32_t>{});
+    if (props.hasOpacity)
+        table.add(elem, props.opacity, 1, targets.opacity);
+    if (props.hasScale)
+        table.add(elem, props.scale, 3, targets.scale);
+    if (props.hasRotation) // w, x, y, z: flip qY and qZ
+        table.add(elem, props.rotation, 4, targets.rotation, convertToRub ? std::initializer_list<uint32_t>{2, 3}
+                                                                          : std::initializer_list<uint32_t>{});
+    if (props.hasFDc)
+        table.add(elem, props.fDc, 3, targets.f_dc);
+    table.sortBySourceOffset();
+    return table;
+}
+
+// Reads each row of [firstRow, lastRow) once and scatters all of its fields
+// into their destination arrays while the row is still in cache. Destinations
+// are only ever written, never read, so they may be write-combined upload memory.
+void scatterRows(const uint8_t* rows, uint32_t rowStride, size_t firstRow, size_t lastRow,
+                 const RowScatterTable& table)
+{
+    uint32_t bits[45];
+
+    for (size_t row = firstRow; row < lastRow; ++row)
+    {
+        const uint8_t* src = rows + row * rowStride;
+        for (uint32_t g = 0; g < table.groupCount; ++g)
+        {
+            const FieldGroup& group = table.groups[g];
+            float*            dst   = group.dest + row * group.width;
+            if (group.contiguous && !group.flips)
             {
-                std::cout << "Warning: skipping empty PLY vertex element" << std::endl;
-                reader.next_element();
+                std::memcpy(dst, src + group.srcOffsets[0], group.width * sizeof(float));
                 continue;
             }
 
-            // Spherical harmonics (f_rest_0 .. f_rest_44)
-            if (reader.find_properties(indices, 45,
-                "f_rest_0",  "f_rest_1",  "f_rest_2",  "f_rest_3",  "f_rest_4",
-                "f_rest_5",  "f_rest_6",  "f_rest_7",  "f_rest_8",  "f_rest_9",
-                "f_rest_10", "f_rest_11", "f_rest_12", "f_rest_13", "f_rest_14",
-                "f_rest_15", "f_rest_16", "f_rest_17", "f_rest_18", "f_rest_19",
-                "f_rest_20", "f_rest_21", "f_rest_22", "f_rest_23", "f_rest_24",
-                "f_rest_25", "f_rest_26", "f_rest_27", "f_rest_28", "f_rest_29",
-                "f_rest_30", "f_rest_31", "f_rest_32", "f_rest_33", "f_rest_34",
-                "f_rest_35", "f_rest_36", "f_rest_37", "f_rest_38", "f_rest_39",
-                "f_rest_40", "f_rest_41", "f_rest_42", "f_rest_43", "f_rest_44"))
+            if (group.contiguous)
             {
-                output.f_rest.resize(numVerts * 45);
-                reader.extract_properties(indices, 45, miniply::PLYPropertyType::Float, output.f_rest.data());
+                std::memcpy(bits, src + group.srcOffsets[0], group.width * sizeof(float));
             }
-
-            // Positions (x, y, z)
-            if (reader.find_properties(indices, 3, "x", "y", "z"))
+            else
             {
-                output.positions.resize(numVerts * 3);
-                reader.extract_properties(indices, 3, miniply::PLYPropertyType::Float, output.positions.data());
+                for (uint32_t i = 0; i < group.width; ++i)
+                    std::memcpy(&bits[i], src + group.srcOffsets[i], sizeof(float));
             }
+            for (uint32_t i = 0; i < group.width; ++i)
+                bits[i] ^= group.signMasks[i];
+            std::memcpy(dst, bits, group.width * sizeof(float));
+        }
+    }
+}
 
-            // Opacity
-            if (reader.find_properties(indices, 1, "opacity"))
-            {
-                output.opacity.resize(numVerts);
-                reader.extract_properties(indices, 1, miniply::PLYPropertyType::Float, output.opacity.data());
-            }
+// Deinterleaves the vertex element straight from the mapped file pages into the
+// targets, skipping miniply's intermediate row buffer. Rows are independent, so the
+// row range is split across worker threads that each scatter their slice of every array.
+// Consumed rows are discarded in blocks so the mapped file never sits in the working
+// set all at once next to the destination arrays.
+bool extractMapped(const MappedFile& file, size_t elementOffset, const miniply::PLYElement& elem,
+                   const SplatProperties& props, const SplatTargets& targets, const PlyLoadOptions& options)
+{
+    // Below this many rows per worker, thread start-up outweighs the copy.
+    static constexpr size_t kMinRowsPerThread = 16 * 1024;
+    static constexpr size_t kRowsPerBlock     = 16 * 1024;
 
-            // Scale (scale_0, scale_1, scale_2)
-            if (reader.find_properties(indices, 3, "scale_0", "scale_1", "scale_2"))
+    const RowScatterTable table     = buildScatterTable(elem, props, targets, options.convertToRub);
+    const uint8_t*        rows      = file.data() + elementOffset;
+    const uint32_t        rowStride = elem.rowStride;
+    const size_t          numRows   = elem.count;
+    const size_t          chunkRows = options.chunkRows ? options.chunkRows : numRows;
+
+    // Chunks are published in row order; the workers split each chunk between them.
+    for (size_t chunk = 0; chunk < numRows; chunk += chunkRows)
+    {
+        const size_t chunkEnd = std::min(numRows, chunk + chunkRows);
+        parallelFor(chunkEnd - chunk, options.threadCount, kMinRowsPerThread, [&](size_t first, size_t last)
+        {
+            for (size_t block = chunk + first; block < chunk + last; block += kRowsPerBlock)
             {
-                output.scale.resize(numVerts * 3);
-                reader.extract_properties(indices, 3, miniply::PLYPropertyType::Float, output.scale.data());
+                const size_t blockEnd = std::min(chunk + last, block + kRowsPerBlock);
+                scatterRows(rows, rowStride, block, blockEnd, table);
+                file.discard(elementOffset + block * rowStride, (blockEnd - block) * rowStride);
             }
+        });
+
+        if (options.onRowsLoaded && !options.onRowsLoaded(chunk, chunkEnd))
+            return false;
+    }
+    return true;
+}
+
+// Loads the current element through miniply's buffered reader (ASCII, big-endian
+// or non-float properties).
+bool extractBuffered(miniply::PLYReader& reader, const SplatProperties& props, SplatSet& output)
+{
+    if (!reader.load_element())
+        return false;
+
+    // 64-bit element counts: numVerts * 45 overflows 32 bits past ~95M splats
+    const size_t numVerts = reader.num_rows();
+
+    if (props.hasFRest)
+    {
+        output.f_rest.resize(numVerts * props.fRestCount);
+        reader.extract_properties(props.fRest, props.fRestCount, miniply::PLYPropertyType::Float,
+                                  output.f_rest.data());
+    }
+    if (props.hasPosition)
+    {
+        output.positions.resize(numVerts * 3);
+        reader.extract_properties(props.position, 3, miniply::PLYPropertyType::Float, output.positions.data());
+    }
+    if (props.hasOpacity)
+    {
+        output.opacity.resize(numVerts);
+        reader.extract_properties(props.opacity, 1, miniply::PLYPropertyType::Float, output.opacity.data());
+    }
+    if (props.hasScale)
+    {
+        output.scale.resize(numVerts * 3);
+        reader.extract_properties(props.scale, 3, miniply::PLYPropertyType::Float, output.scale.data());
+    }
+    if (props.hasRotation)
+    {
+        output.rotation.resize(numVerts * 4);
+        reader.extract_properties(props.rotation, 4, miniply::PLYPropertyType::Float, output.rotation.data());
+    }
+    if (props.hasFDc)
+    {
+        output.f_dc.resize(numVerts * 3);
+        reader.extract_properties(props.fDc, 3, miniply::PLYPropertyType::Float, output.f_dc.data());
+    }
+    return true;
+}
+
+void copyToTarget(const std::vector<float>& src, float* dest)
+{
+    if (dest && !src.empty())
+        std::memcpy(dest, src.data(), src.size() * sizeof(float));
+}
+
+PlyInfo makeInfo(const miniply::PLYElement& elem, const SplatProperties& props)
+{
+    PlyInfo info;
+    info.count         = elem.count;
+    info.fRestPerSplat = props.fRestCount;
+    info.hasPositions  = props.hasPosition;
+    info.hasFDc        = props.hasFDc;
+    info.hasOpacity    = props.hasOpacity;
+    info.hasScale      = props.hasScale;
+    info.hasRotation   = props.hasRotation;
+    return info;
+}
+
+} // namespace
+
+bool readPlyInfo(const std::filesystem::path& filename, PlyInfo& info)
+{
+    miniply::PLYReader reader(filename.string().c_str());
+    if (!reader.valid())
+        return false;
+
+    const uint32_t vertexIdx = reader.find_element(miniply::kPLYVertexElement);
+    if (vertexIdx == miniply::kInvalidIndex)
+        return false;
 
-            // Rotation quaternion (rot_0, rot_1, rot_2, rot_3)
-            if (reader.find_properties(indices, 4, "rot_0", "rot_1", "rot_2", "rot_3"))
+    const miniply::PLYElement& elem = *reader.get_element(vertexIdx);
+    info = makeInfo(elem, findSplatProperties(elem, 3));
+    return info.count > 0;
+}
+
+bool loadPly(const std::filesystem::path& filename, const SplatTargetAllocator& allocate,
+             const PlyLoadOptions& options)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Open the PLY file (miniply parses the header; rows are read separately)
+    miniply::PLYReader reader(filename.string().c_str());
+    if (!reader.valid())
+    {
+        std::cerr << "Error: failed to open PLY file: " << filename << std::endl;
+        return false;
+    }
+
+    // Binary little-endian files are deinterleaved in place from a read-only mapping.
+    // Rows of earlier elements are skipped by size, which requires them to be fixed-size.
+    std::unique_ptr<MappedFile> mapped;
+    size_t                      elementOffset = 0;
+    if (options.allowMapping && reader.file_type() == miniply::PLYFileType::Binary)
+    {
+        mapped = std::make_unique<MappedFile>(filename);
+        if (mapped->valid())
+            elementOffset = findDataOffset(mapped->data(), mapped->size());
+        if (elementOffset == 0)
+            mapped.reset();
+    }
+
+    bool    gsFound     = false;
+    bool    readInPlace = false;
+    PlyInfo info;
+
+    while (reader.has_element() && !gsFound)
+    {
+        const miniply::PLYElement& elem = *reader.element();
+
+        if (reader.element_is(miniply::kPLYVertexElement))
+        {
+            if (elem.count == 0)
             {
-                output.rotation.resize(numVerts * 4);
-                reader.extract_properties(indices, 4, miniply::PLYPropertyType::Float, output.rotation.data());
+                std::cout << "Warning: skipping empty PLY vertex element" << std::endl;
+                reader.next_element();
+                continue;
             }
 
-            // Base color (f_dc_0, f_dc_1, f_dc_2)
-            if (reader.find_properties(indices, 3, "f_dc_0", "f_dc_1", "f_dc_2"))
+            const SplatProperties props = findSplatProperties(elem, options.maxShDegree);
+            info = makeInfo(elem, props);
+
+            const size_t elementBytes = static_cast<size_t>(elem.count) * elem.rowStride;
+            if (mapped && canReadInPlace(elem, props) && elementOffset + elementBytes <= mapped->size())
             {
-                output.f_dc.resize(numVerts * 3);
-                reader.extract_properties(indices, 3, miniply::PLYPropertyType::Float, output.f_dc.data());
+                SplatTargets targets;
+                if (!allocate(info, targets))
+                    return false;
+                if (!extractMapped(*mapped, elementOffset, elem, props, targets, options))
+                    return false;
+                gsFound     = true;
+                readInPlace = true;
             }
+            else
+            {
+                // miniply converts types while extracting into its own arrays,
+                // so go through a temporary SplatSet and copy into the targets.
+                SplatSet staged;
+                gsFound = extractBuffered(reader, props, staged);
+                if (gsFound)
+                {
+                    if (options.convertToRub)
+                        staged.convertRdfToRub(options.threadCount);
+
+                    SplatTargets targets;
+                    if (!allocate(info, targets))
+                        return false;
+                    copyToTarget(staged.positions, targets.positions);
+                    copyToTarget(staged.f_dc, targets.f_dc);
+                    copyToTarget(staged.f_rest, targets.f_rest);
+                    copyToTarget(staged.opacity, targets.opacity);
+                    copyToTarget(staged.scale, targets.scale);
+                    copyToTarget(staged.rotation, targets.rotation);
 
-            gsFound = true;
+                    if (options.onRowsLoaded && !options.onRowsLoaded(0, info.count))
+                        return false;
+                }
+            }
+        }
+        else if (mapped)
+        {
+            if (!elem.fixedSize)
+                mapped.reset();
+            else
+                elementOffset += static_cast<size_t>(elem.count) * elem.rowStride;
         }
 
         reader.next_element();
@@ -90,14 +485,10 @@ bool loadPly(const std::filesystem::path& filename, SplatSet& output, bool conve
 
     if (gsFound)
     {
-        if (convertToRub)
-        {
-            output.convertRdfToRub();
-        }
-
         auto      endTime  = std::chrono::high_resolution_clock::now();
         long long loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
-        std::cout << "PLY loaded: " << output.size() << " splats in " << loadTime << "ms" << std::endl;
+        std::cout << "PLY loaded: " << info.count << " splats in " << loadTime << "ms"
+                  << (readInPlace ? " (mapped)" : "") << std::endl;
     }
     else
     {
@@ -106,3 +497,22 @@ bool loadPly(const std::filesystem::path& filename, SplatSet& output, bool conve
 
     return gsFound;
 }
+
+bool loadPly(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options)
+{
+    return loadPly(filename, [&output](const PlyInfo& info, SplatTargets& targets)
+    {
+        auto resize = [&info](std::vector<float>& array, bool present, size_t width) -> float*
+        {
+            array.assign(present ? info.count * width : 0, 0.0f);
+            return present ? array.data() : nullptr;
+        };
+        targets.positions = resize(output.positions, info.hasPositions, 3);
+        targets.f_dc      = resize(output.f_dc, info.hasFDc, 3);
+        targets.f_rest    = resize(output.f_rest, info.fRestPerSplat > 0, info.fRestPerSplat);
+        targets.opacity   = resize(output.opacity, info.hasOpacity, 1);
+        targets.scale     = resize(output.scale, info.hasScale, 3);
+        targets.rotation  = resize(output.rotation, info.hasRotation, 4);
+        return true;
+    }, options);
+}
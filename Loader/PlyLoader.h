@@ -1,15 +1,70 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 #include <string>
 #include "SplatSet.h"
 
+struct PlyLoadOptions
+{
+    bool     convertToRub = true; // RDF → RUB axis conversion after loading
+    uint32_t threadCount  = 0;    // workers for the mapped deinterleave (0 = hardware concurrency)
+    bool     allowMapping = true; // false forces miniply's buffered reader (benchmark baseline)
+    int32_t  maxShDegree  = 3;    // 0-3; f_rest bands above this are skipped during extraction
+
+    // Progressive loading: rows are written in order, `chunkRows` at a time, and
+    // onRowsLoaded(first, last) runs on the loading thread after each chunk lands
+    // in the targets. Returning false cancels the load (loadPly returns false).
+    size_t                                               chunkRows = 0; // 0 = whole element
+    std::function<bool(size_t firstRow, size_t lastRow)> onRowsLoaded;
+};
+
+// Vertex element summary, known as soon as the header has been parsed.
+struct PlyInfo
+{
+    size_t count         = 0;
+    size_t fRestPerSplat = 0; // 3 × coefficients per channel kept (0, 9, 24 or 45)
+    bool   hasPositions  = false;
+    bool   hasFDc        = false;
+    bool   hasOpacity    = false;
+    bool   hasScale      = false;
+    bool   hasRotation   = false;
+};
+
+// Where loadPly writes each attribute: `count * width` floats, SplatSet layout.
+// Null targets are skipped. Targets are only written, never read back, so they
+// may point into mapped (write-combined) upload memory.
+struct SplatTargets
+{
+    float* positions = nullptr; // 3 per splat
+    float* f_dc      = nullptr; // 3 per splat
+    float* f_rest    = nullptr; // PlyInfo::fRestPerSplat per splat
+    float* opacity   = nullptr; // 1 per splat
+    float* scale     = nullptr; // 3 per splat
+    float* rotation  = nullptr; // 4 per splat
+};
+
+// Called once with the parsed header; fills `targets` and returns false to abort.
+using SplatTargetAllocator = std::function<bool(const PlyInfo& info, SplatTargets& targets)>;
+
 // Synchronous PLY loader for 3D Gaussian Splatting files.
 // Uses miniply library (MIT license) for parsing.
+// Binary little-endian files are memory-mapped and each row is scattered into
+// all SplatSet arrays in a single pass; other encodings go through miniply's
+// buffered reader. The mapped rows are split across `options.threadCount` workers,
+// and the RDF → RUB flip is applied while copying.
 //
 // Usage:
 //   SplatSet splats;
 //   if (loadPly("scene.ply", splats)) {
 //       // splats.size() returns number of Gaussians
 //   }
-bool loadPly(const std::filesystem::path& filename, SplatSet& output, bool convertToRub = true);
+bool loadPly(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options = {});
+
+// Parses only the header: vertex count and which 3DGS attributes are present.
+bool readPlyInfo(const std::filesystem::path& filename, PlyInfo& info);
+
+// Same as loadPly(SplatSet), but writes into caller-provided memory (e.g. mapped staging buffers)
+// sized from the header, so no host-side SplatSet is needed.
+bool loadPly(const std::filesystem::path& filename, const SplatTargetAllocator& allocate,
+             const PlyLoadOptions& options = {});
@@ -0,0 +1,372 @@
+#include "QuantizedSplats.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+namespace
+{
+
+constexpr char     kMagic[8]         = {'G', 'S', 'Q', 'U', 'A', 'N', 'T', 0};
+constexpr uint32_t kVersion          = 1;
+constexpr size_t   kMinChunksPerTask = 64;
+
+constexpr float kShC0        = 0.28209479177387814f; // zeroth-order SH basis constant
+constexpr float kSqrt2       = 1.41421356237309505f;
+constexpr float kShRestSpan  = 8.0f;                 // f_rest bytes cover [-4, 4]
+constexpr float kMaxLogScale = 20.0f;
+
+struct FileHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t count;
+    uint32_t fRestPerSplat;
+    uint32_t chunkSize;
+};
+
+uint32_t quantize(float normalized, uint32_t maxValue)
+{
+    return static_cast<uint32_t>(std::clamp(normalized, 0.0f, 1.0f) * static_cast<float>(maxValue) + 0.5f);
+}
+
+float normalize(float value, float minValue, float maxValue)
+{
+    return maxValue > minValue ? (value - minValue) / (maxValue - minValue) : 0.0f;
+}
+
+uint32_t pack111011(const float* value, const float* minValue, const float* maxValue)
+{
+    return quantize(normalize(value[0], minValue[0], maxValue[0]), 2047) << 21 |
+           quantize(normalize(value[1], minValue[1], maxValue[1]), 1023) << 11 |
+           quantize(normalize(value[2], minValue[2], maxValue[2]), 2047);
+}
+
+void unpack111011(uint32_t packed, const float* minValue, const float* maxValue, float* value)
+{
+    const float normalized[3] = {static_cast<float>(packed >> 21) / 2047.0f,
+                                 static_cast<float>((packed >> 11) & 0x3ffu) / 1023.0f,
+                                 static_cast<float>(packed & 0x7ffu) / 2047.0f};
+    for (int i = 0; i < 3; ++i)
+        value[i] = minValue[i] + normalized[i] * (maxValue[i] - minValue[i]);
+}
+
+// Smallest-three: the largest |component| is dropped (and made positive), the other
+// three lie in [-1/√2, 1/√2] and get 10 bits each.
+uint32_t packRotation(const float* q)
+{
+    float       v[4]   = {q[0], q[1], q[2], q[3]};
+    const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3]);
+    if (!(length > 0.0f))
+    {
+        v[0] = 1.0f;
+        v[1] = v[2] = v[3] = 0.0f;
+    }
+    else
+    {
+        for (float& c : v)
+            c /= length;
+    }
+
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i)
+    {
+        if (std::fabs(v[i]) > std::fabs(v[largest]))
+            largest = i;
+    }
+    const float sign = v[largest] < 0.0f ? -1.0f : 1.0f;
+
+    uint32_t packed = largest << 30;
+    uint32_t shift  = 20;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        packed |= quantize(v[i] * sign * kSqrt2 * 0.5f + 0.5f, 1023) << shift;
+        shift -= 10;
+    }
+    return packed;
+}
+
+void unpackRotation(uint32_t packed, float* q)
+{
+    const uint32_t largest = packed >> 30;
+    float          sumSq   = 0.0f;
+    uint32_t       shift   = 20;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        q[i] = (static_cast<float>((packed >> shift) & 0x3ffu) / 1023.0f - 0.5f) * kSqrt2;
+        sumSq += q[i] * q[i];
+        shift -= 10;
+    }
+    q[largest] = std::sqrt(std::max(0.0f, 1.0f - sumSq));
+}
+
+float baseColor(float fDc)
+{
+    return 0.5f + kShC0 * fDc;
+}
+
+float clampedLogScale(float logScale)
+{
+    return std::clamp(logScale, -kMaxLogScale, kMaxLogScale);
+}
+
+void quantizeChunk(const SplatView& splats, size_t first, size_t last, const QuantizedTargets& targets)
+{
+    QuantizedChunk chunk;
+    for (int i = 0; i < 3; ++i)
+    {
+        chunk.minPosition[i] = chunk.minScale[i] = chunk.minColor[i] = INFINITY;
+        chunk.maxPosition[i] = chunk.maxScale[i] = chunk.maxColor[i] = -INFINITY;
+    }
+    for (size_t r = first; r < last; ++r)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const float position = splats.positions[r * 3 + i];
+            const float scale    = clampedLogScale(splats.scale[r * 3 + i]);
+            const float color    = baseColor(splats.f_dc[r * 3 + i]);
+            chunk.minPosition[i] = std::min(chunk.minPosition[i], position);
+            chunk.maxPosition[i] = std::max(chunk.maxPosition[i], position);
+            chunk.minScale[i]    = std::min(chunk.minScale[i], scale);
+            chunk.maxScale[i]    = std::max(chunk.maxScale[i], scale);
+            chunk.minColor[i]    = std::min(chunk.minColor[i], color);
+            chunk.maxColor[i]    = std::max(chunk.maxColor[i], color);
+        }
+    }
+    if (targets.chunks)
+        targets.chunks[first / kQuantChunkSize] = chunk;
+
+    for (size_t r = first; r < last; ++r)
+    {
+        if (targets.position)
+            targets.position[r] = pack111011(splats.positions + r * 3, chunk.minPosition, chunk.maxPosition);
+        if (targets.scale)
+        {
+            const float scale[3] = {clampedLogScale(splats.scale[r * 3]), clampedLogScale(splats.scale[r * 3 + 1]),
+                                    clampedLogScale(splats.scale[r * 3 + 2])};
+            targets.scale[r] = pack111011(scale, chunk.minScale, chunk.maxScale);
+        }
+        if (targets.rotation)
+            targets.rotation[r] = packRotation(splats.rotation + r * 4);
+        if (targets.color)
+        {
+            const float alpha  = 1.0f / (1.0f + std::exp(-splats.opacity[r]));
+            uint32_t    packed = 0;
+            for (int i = 0; i < 3; ++i)
+            {
+                const float color = baseColor(splats.f_dc[r * 3 + i]);
+                packed |= quantize(normalize(color, chunk.minColor[i], chunk.maxColor[i]), 255) << (24 - 8 * i);
+            }
+            targets.color[r] = packed | quantize(alpha, 255);
+        }
+    }
+
+    if (targets.f_rest && splats.f_rest && splats.fRestPerSplat > 0)
+    {
+        const size_t width = splats.fRestPerSplat;
+        quantizeShRest(splats.f_rest + first * width, targets.f_rest + first * width, (last - first) * width);
+    }
+}
+
+} // namespace
+
+QuantizedTargets QuantizedSplatSet::resize(size_t splatCount, size_t restPerSplat)
+{
+    count         = splatCount;
+    fRestPerSplat = restPerSplat;
+    chunks.resize(quantChunkCount(splatCount));
+    position.resize(splatCount);
+    rotation.resize(splatCount);
+    scale.resize(splatCount);
+    color.resize(splatCount);
+    f_rest.resize(splatCount * restPerSplat);
+
+    QuantizedTargets targets;
+    targets.chunks   = chunks.data();
+    targets.position = position.data();
+    targets.rotation = rotation.data();
+    targets.scale    = scale.data();
+    targets.color    = color.data();
+    targets.f_rest   = f_rest.empty() ? nullptr : f_rest.data();
+    return targets;
+}
+
+bool quantizeSplatRows(const SplatView& splats, size_t firstRow, size_t lastRow,
+                       const QuantizedTargets& targets, uint32_t threadCount)
+{
+    if (!splats.positions || !splats.f_dc || !splats.opacity || !splats.scale || !splats.rotation)
+    {
+        std::cerr << "Error: quantization needs positions, f_dc, opacity, scale and rotation" << std::endl;
+        return false;
+    }
+    if (firstRow % kQuantChunkSize != 0 || lastRow > splats.count ||
+        (lastRow % kQuantChunkSize != 0 && lastRow != splats.count) || firstRow > lastRow)
+    {
+        std::cerr << "Error: quantized rows must start and end on " << kQuantChunkSize << "-splat chunks" << std::endl;
+        return false;
+    }
+
+    const size_t firstChunk = firstRow / kQuantChunkSize;
+    parallelFor(quantChunkCount(lastRow) - firstChunk, threadCount, kMinChunksPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t c = firstChunk + begin; c < firstChunk + end; ++c)
+            quantizeChunk(splats, c * kQuantChunkSize, std::min(lastRow, (c + 1) * kQuantChunkSize), targets);
+    });
+    return true;
+}
+
+bool quantizeSplats(const SplatView& splats, QuantizedSplatSet& out, uint32_t threadCount)
+{
+    const QuantizedTargets targets = out.resize(splats.count, splats.f_rest ? splats.fRestPerSplat : 0);
+    return quantizeSplatRows(splats, 0, splats.count, targets, threadCount);
+}
+
+void dequantizeSplats(const QuantizedSplatSet& quantized, SplatSet& out, uint32_t threadCount)
+{
+    const size_t count = quantized.count;
+    out.positions.resize(count * 3);
+    out.f_dc.resize(count * 3);
+    out.opacity.resize(count);
+    out.scale.resize(count * 3);
+    out.rotation.resize(count * 4);
+    out.f_rest.resize(quantized.f_rest.size());
+
+    const size_t width = quantized.fRestPerSplat;
+    parallelFor(quantChunkCount(count), threadCount, kMinChunksPerTask, [&](size_t begin, size_t end)
+    {
+        const size_t last = std::min(count, end * kQuantChunkSize);
+        for (size_t r = begin * kQuantChunkSize; r < last; ++r)
+        {
+            const QuantizedChunk& chunk = quantized.chunks[r / kQuantChunkSize];
+            unpack111011(quantized.position[r], chunk.minPosition, chunk.maxPosition, out.positions.data() + r * 3);
+            unpack111011(quantized.scale[r], chunk.minScale, chunk.maxScale, out.scale.data() + r * 3);
+            unpackRotation(quantized.rotation[r], out.rotation.data() + r * 4);
+
+            const uint32_t packed = quantized.color[r];
+            for (int i = 0; i < 3; ++i)
+            {
+                const float normalized = static_cast<float>((packed >> (24 - 8 * i)) & 0xffu) / 255.0f;
+                const float color      = chunk.minColor[i] + normalized * (chunk.maxColor[i] - chunk.minColor[i]);
+                out.f_dc[r * 3 + i]    = (color - 0.5f) / kShC0;
+            }
+            // Keep the logit finite for fully transparent / opaque bytes.
+            const float alpha = std::clamp(static_cast<float>(packed & 0xffu) / 255.0f, 0.5f / 255.0f, 254.5f / 255.0f);
+            out.opacity[r]    = -std::log(1.0f / alpha - 1.0f);
+
+            for (size_t i = r * width; i < (r + 1) * width; ++i)
+                out.f_rest[i] = (static_cast<float>(quantized.f_rest[i]) / 255.0f - 0.5f) * kShRestSpan;
+        }
+    });
+}
+
+void quantizeShRest(const float* src, uint8_t* dst, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<uint8_t>(quantize(src[i] / kShRestSpan + 0.5f, 255));
+}
+
+std::filesystem::path quantizedSplatPath(const std::filesystem::path& plyPath)
+{
+    std::filesystem::path path = plyPath;
+    path.replace_extension(".gsq");
+    return path;
+}
+
+bool writeQuantizedSplats(const std::filesystem::path& path, const QuantizedSplatSet& quantized)
+{
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.headerSize    = sizeof(FileHeader);
+    header.count         = quantized.count;
+    header.fRestPerSplat = static_cast<uint32_t>(quantized.fRestPerSplat);
+    header.chunkSize     = static_cast<uint32_t>(kQuantChunkSize);
+
+    // Same temporary-then-rename scheme as the .gsbin cache.
+    std::filesystem::path tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Warning: cannot create " << tmpPath << std::endl;
+            return false;
+        }
+        auto write = [&](const void* data, size_t size)
+        {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        };
+        write(&header, sizeof(header));
+        write(quantized.chunks.data(), quantized.chunks.size() * sizeof(QuantizedChunk));
+        write(quantized.position.data(), quantized.position.size() * sizeof(uint32_t));
+        write(quantized.rotation.data(), quantized.rotation.size() * sizeof(uint32_t));
+        write(quantized.scale.data(), quantized.scale.size() * sizeof(uint32_t));
+        write(quantized.color.data(), quantized.color.size() * sizeof(uint32_t));
+        write(quantized.f_rest.data(), quantized.f_rest.size());
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(tmpPath);
+            std::cerr << "Warning: failed to write " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        std::cerr << "Warning: failed to move quantized splats into place: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool readQuantizedSplats(const std::filesystem::path& path, QuantizedSplatSet& quantized)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+        return false;
+    const uint64_t fileSize = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    FileHeader header;
+    if (fileSize < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.headerSize != sizeof(FileHeader) || header.chunkSize != kQuantChunkSize ||
+        header.fRestPerSplat > 45)
+    {
+        std::cerr << "Error: not a quantized splat file: " << path << std::endl;
+        return false;
+    }
+
+    const uint64_t expected = sizeof(header) + quantChunkCount(header.count) * sizeof(QuantizedChunk) +
+                              header.count * (4 * sizeof(uint32_t) + header.fRestPerSplat);
+    if (fileSize != expected)
+    {
+        std::cerr << "Error: truncated quantized splat file: " << path << std::endl;
+        return false;
+    }
+
+    quantized.resize(header.count, header.fRestPerSplat);
+    auto read = [&](void* data, size_t size)
+    {
+        return static_cast<bool>(in.read(static_cast<char*>(data), static_cast<std::streamsize>(size)));
+    };
+    return read(quantized.chunks.data(), quantized.chunks.size() * sizeof(QuantizedChunk)) &&
+           read(quantized.position.data(), quantized.position.size() * sizeof(uint32_t)) &&
+           read(quantized.rotation.data(), quantized.rotation.size() * sizeof(uint32_t)) &&
+           read(quantized.scale.data(), quantized.scale.size() * sizeof(uint32_t)) &&
+           read(quantized.color.data(), quantized.color.size() * sizeof(uint32_t)) &&
+           read(quantized.f_rest.data(), quantized.f_rest.size());
+}
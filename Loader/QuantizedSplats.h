@@ -0,0 +1,102 @@
+#pragma once
+
+#include <filesystem>
+#include "SplatSet.h"
+
+// Chunk-quantized splat storage (.gsq), modelled on the PlayCanvas compressed PLY.
+//
+// Splats are grouped in runs of kQuantChunkSize. Each chunk stores the min/max of
+// its positions, log-scales and base colors, and each splat stores
+//   position  11/10/11 bits, normalized within the chunk bounds
+//   rotation  smallest-three: 2-bit index of the largest |component| + 3 × 10 bits
+//   scale     11/10/11 bits of the log-scale, normalized within the chunk bounds
+//   color     8/8/8 base color (0.5 + SH_C0 · f_dc) within the chunk bounds,
+//             then 8 bits of sigmoid(opacity)
+// plus one byte per f_rest coefficient over [-4, 4]. That is 16 bytes per splat
+// (+0.28 for the chunk table) instead of 56 for the fp32 SOA arrays, and 1 byte per
+// SH coefficient instead of 4. The arrays are uploaded as-is and decoded by the
+// projection shader; dequantizeSplats is the matching CPU reference.
+//
+// Usage:
+//   QuantizedSplatSet quantized;
+//   quantizeSplats(splats.view(), quantized);
+//   writeQuantizedSplats(quantizedSplatPath("scene.ply"), quantized);   // scene.gsq
+
+inline constexpr size_t kQuantChunkSize = 256;
+
+inline size_t quantChunkCount(size_t count)
+{
+    return (count + kQuantChunkSize - 1) / kQuantChunkSize;
+}
+
+// Per-chunk dequantization bounds, 18 floats (std430-compatible, read as float[]).
+struct QuantizedChunk
+{
+    float minPosition[3];
+    float maxPosition[3];
+    float minScale[3];
+    float maxScale[3];
+    float minColor[3];
+    float maxColor[3];
+};
+static_assert(sizeof(QuantizedChunk) == 18 * sizeof(float), "QuantizedChunk is read as float[18] on the GPU");
+
+// Where quantizeSplatRows writes, indexed by absolute row (chunks by row / 256).
+// Null targets are skipped; they may point into mapped upload memory.
+struct QuantizedTargets
+{
+    QuantizedChunk* chunks   = nullptr;
+    uint32_t*       position = nullptr;
+    uint32_t*       rotation = nullptr;
+    uint32_t*       scale    = nullptr;
+    uint32_t*       color    = nullptr;
+    uint8_t*        f_rest   = nullptr; // fRestPerSplat bytes per splat
+};
+
+struct QuantizedSplatSet
+{
+    size_t count         = 0;
+    size_t fRestPerSplat = 0; // 0, 9, 24 or 45
+
+    std::vector<QuantizedChunk> chunks;
+    std::vector<uint32_t>       position;
+    std::vector<uint32_t>       rotation;
+    std::vector<uint32_t>       scale;
+    std::vector<uint32_t>       color;
+    std::vector<uint8_t>        f_rest;
+
+    size_t size() const { return count; }
+
+    // Sizes the arrays for `splatCount` splats and returns targets over all of them.
+    QuantizedTargets resize(size_t splatCount, size_t restPerSplat);
+
+    size_t byteSize() const
+    {
+        return chunks.size() * sizeof(QuantizedChunk) +
+               (position.size() + rotation.size() + scale.size() + color.size()) * sizeof(uint32_t) +
+               f_rest.size();
+    }
+};
+
+// Quantizes rows [firstRow, lastRow) of `splats`. Both ends must fall on chunk
+// boundaries (lastRow may also be splats.count), so a streaming loader can
+// quantize each published range on its own. Positions, f_dc, opacity, scale and
+// rotation must all be present; f_rest is written only if both sides have it.
+bool quantizeSplatRows(const SplatView& splats, size_t firstRow, size_t lastRow,
+                       const QuantizedTargets& targets, uint32_t threadCount = 0);
+
+// Whole-set convenience wrapper.
+bool quantizeSplats(const SplatView& splats, QuantizedSplatSet& out, uint32_t threadCount = 0);
+
+// CPU decode with the same math as proj.comp (opacity is returned as a logit again),
+// split across `threadCount` workers (0 = hardware concurrency).
+void dequantizeSplats(const QuantizedSplatSet& quantized, SplatSet& out, uint32_t threadCount = 0);
+
+// One byte per SH coefficient: round((v / 8 + 0.5) * 255), clamped.
+void quantizeShRest(const float* src, uint8_t* dst, size_t count);
+
+// .gsq file next to the source scene.
+std::filesystem::path quantizedSplatPath(const std::filesystem::path& plyPath);
+
+bool writeQuantizedSplats(const std::filesystem::path& path, const QuantizedSplatSet& quantized);
+bool readQuantizedSplats(const std::filesystem::path& path, QuantizedSplatSet& quantized);
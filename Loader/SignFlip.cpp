@@ -0,0 +1,147 @@
+#include "SignFlip.h"
+#include "ParallelFor.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GS_SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define GS_TARGET_AVX2
+#else
+#define GS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define GS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+
+// Eight rows per block: blockWords = rowFloats * 8 is a multiple of every vector width.
+constexpr size_t kRowsPerBlock   = 8;
+constexpr size_t kMaxRowFloats   = 64;
+constexpr size_t kMinRowsPerTask = 64 * 1024;
+
+void xorScalar(float* data, size_t count, const uint32_t* mask)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, data + i, sizeof(bits));
+        bits ^= mask[i];
+        std::memcpy(data + i, &bits, sizeof(bits));
+    }
+}
+
+#ifdef GS_SIMD_X86
+GS_TARGET_AVX2 void xorBlocksAvx2(float* data, size_t blocks, size_t blockWords, const uint32_t* mask)
+{
+    for (size_t b = 0; b < blocks; ++b, data += blockWords)
+    {
+        for (size_t i = 0; i < blockWords; i += 8)
+        {
+            const __m256i v = _mm256_castps_si256(_mm256_loadu_ps(data + i));
+            const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i));
+            _mm256_storeu_ps(data + i, _mm256_castsi256_ps(_mm256_xor_si256(v, m)));
+        }
+    }
+}
+
+bool cpuHasAvx2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) // XMM and YMM state saved by the OS
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#ifdef GS_SIMD_NEON
+void xorBlocksNeon(float* data, size_t blocks, size_t blockWords, const uint32_t* mask)
+{
+    for (size_t b = 0; b < blocks; ++b, data += blockWords)
+    {
+        for (size_t i = 0; i < blockWords; i += 4)
+        {
+            const uint32x4_t v = vreinterpretq_u32_f32(vld1q_f32(data + i));
+            vst1q_f32(data + i, vreinterpretq_f32_u32(veorq_u32(v, vld1q_u32(mask + i))));
+        }
+    }
+}
+#endif
+
+} // namespace
+
+SimdLevel detectSimdLevel()
+{
+#if defined(GS_SIMD_X86)
+    static const SimdLevel level = cpuHasAvx2() ? SimdLevel::Avx2 : SimdLevel::Scalar;
+    return level;
+#elif defined(GS_SIMD_NEON)
+    return SimdLevel::Neon; // mandatory on AArch64
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx2: return "AVX2";
+    case SimdLevel::Neon: return "NEON";
+    default:              return "scalar";
+    }
+}
+
+void xorRowSignMask(float* data, size_t rows, size_t rowFloats, const uint32_t* rowMask,
+                    uint32_t threadCount, SimdLevel level)
+{
+    if (rows == 0 || rowFloats == 0 || rowFloats > kMaxRowFloats)
+        return;
+
+    // Repeat the row mask over one block of eight rows.
+    const size_t blockWords = rowFloats * kRowsPerBlock;
+    uint32_t     blockMask[kMaxRowFloats * kRowsPerBlock];
+    for (size_t r = 0; r < kRowsPerBlock; ++r)
+        std::memcpy(blockMask + r * rowFloats, rowMask, rowFloats * sizeof(uint32_t));
+
+    const size_t blocks = rows / kRowsPerBlock;
+    parallelFor(blocks, threadCount, kMinRowsPerTask / kRowsPerBlock, [&](size_t first, size_t last)
+    {
+        float* begin = data + first * blockWords;
+        switch (level)
+        {
+#ifdef GS_SIMD_X86
+        case SimdLevel::Avx2:
+            xorBlocksAvx2(begin, last - first, blockWords, blockMask);
+            break;
+#endif
+#ifdef GS_SIMD_NEON
+        case SimdLevel::Neon:
+            xorBlocksNeon(begin, last - first, blockWords, blockMask);
+            break;
+#endif
+        default:
+            for (size_t b = first; b < last; ++b)
+                xorScalar(data + b * blockWords, blockWords, blockMask);
+            break;
+        }
+    });
+
+    // Trailing rows that do not fill a block.
+    for (size_t r = blocks * kRowsPerBlock; r < rows; ++r)
+        xorScalar(data + r * rowFloats, rowFloats, rowMask);
+}
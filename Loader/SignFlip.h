@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Sign-bit XOR kernels for axis flips over SOA rows.
+//
+// A flip is described per row as a mask of 0 or 0x80000000 words, one per
+// float; XORing it into the row negates exactly the flagged components. Rows are
+// processed in blocks of eight so the mask repeats on a vector boundary for any
+// row width, then handed to the widest kernel the CPU supports.
+//
+// Usage:
+//   const uint32_t mask[3] = {0, kSignBit, kSignBit}; // flip y and z
+//   xorRowSignMask(positions, count, 3, mask, threadCount);
+
+inline constexpr uint32_t kSignBit = 0x80000000u;
+
+enum class SimdLevel
+{
+    Scalar,
+    Avx2,
+    Neon,
+};
+
+// Widest kernel usable on this CPU (checked once, including OS AVX state support).
+SimdLevel   detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+// data[r * rowFloats + i] ^= rowMask[i] for every row r < rows, split across
+// `threadCount` workers (0 = hardware concurrency). rowFloats must be at most 64.
+void xorRowSignMask(float* data, size_t rows, size_t rowFloats, const uint32_t* rowMask,
+                    uint32_t threadCount, SimdLevel level = detectSimdLevel());
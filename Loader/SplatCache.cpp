@@ -0,0 +1,284 @@
+#include "SplatCache.h"
+#include "MappedFile.h"
+#include "PlyLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+
+constexpr char     kMagic[8]      = {'G', 'S', 'B', 'I', 'N', 0, 0, 0};
+constexpr uint32_t kVersion       = 1;
+constexpr uint64_t kSectionAlign  = 256;
+constexpr uint32_t kSectionCount  = 6;
+
+// Section order within the file (also the order of the arrays in SplatView).
+enum Section : uint32_t
+{
+    Positions,
+    FDc,
+    FRest,
+    Opacity,
+    Scale,
+    Rotation,
+};
+
+struct SectionEntry
+{
+    uint64_t offset; // from start of file, multiple of kSectionAlign
+    uint64_t size;   // in bytes
+};
+
+struct CacheHeader
+{
+    char         magic[8];
+    uint32_t     version;
+    uint32_t     headerSize;
+    uint64_t     count;
+    int32_t      shDegree;
+    uint32_t     fRestPerSplat;
+    uint64_t     sourceSize;  // size of the source PLY in bytes
+    int64_t      sourceTime;  // last_write_time of the source PLY, in file clock ticks
+    SectionEntry sections[kSectionCount];
+    uint64_t     payloadChecksum;
+    uint64_t     headerChecksum; // over all bytes before this field
+};
+static_assert(sizeof(CacheHeader) <= kSectionAlign, "cache header must fit before the first section");
+
+// Word-wise FNV-1a variant: one multiply per 8 bytes keeps writing a multi-GB cache cheap.
+uint64_t checksum64(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull)
+{
+    constexpr uint64_t kPrime = 0x100000001b3ull;
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    size_t      i     = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * kPrime;
+    }
+    for (; i < size; ++i)
+        hash = (hash ^ bytes[i]) * kPrime;
+    return hash;
+}
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+uint64_t headerChecksum(const CacheHeader& header)
+{
+    return checksum64(&header, offsetof(CacheHeader, headerChecksum));
+}
+
+bool sourceStamp(const std::filesystem::path& sourcePath, uint64_t& size, int64_t& time)
+{
+    std::error_code ec;
+    size = std::filesystem::file_size(sourcePath, ec);
+    if (ec)
+        return false;
+    time = std::filesystem::last_write_time(sourcePath, ec).time_since_epoch().count();
+    return !ec;
+}
+
+} // namespace
+
+std::filesystem::path splatCachePath(const std::filesystem::path& plyPath)
+{
+    std::filesystem::path cachePath = plyPath;
+    cachePath.replace_extension(".gsbin");
+    return cachePath;
+}
+
+bool writeSplatCache(const std::filesystem::path& cachePath, const SplatSet& splats,
+                     const std::filesystem::path& sourcePath)
+{
+    const SplatView view = splats.view();
+
+    const std::array<std::pair<const float*, size_t>, kSectionCount> arrays = {{
+        {view.positions, splats.positions.size()},
+        {view.f_dc,      splats.f_dc.size()},
+        {view.f_rest,    splats.f_rest.size()},
+        {view.opacity,   splats.opacity.size()},
+        {view.scale,     splats.scale.size()},
+        {view.rotation,  splats.rotation.size()},
+    }};
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.headerSize    = sizeof(CacheHeader);
+    header.count         = view.count;
+    header.shDegree      = splats.maxShDegree();
+    header.fRestPerSplat = static_cast<uint32_t>(view.fRestPerSplat);
+    if (!sourceStamp(sourcePath, header.sourceSize, header.sourceTime))
+    {
+        std::cerr << "Warning: cannot stat " << sourcePath << ", not writing splat cache" << std::endl;
+        return false;
+    }
+
+    uint64_t offset = kSectionAlign;
+    uint64_t payloadHash = checksum64(nullptr, 0);
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+    {
+        header.sections[s].offset = offset;
+        header.sections[s].size   = arrays[s].second * sizeof(float);
+        payloadHash = checksum64(arrays[s].first, header.sections[s].size, payloadHash);
+        offset      = alignUp(offset + header.sections[s].size);
+    }
+    header.payloadChecksum = payloadHash;
+    header.headerChecksum  = headerChecksum(header);
+
+    // Write to a temporary name first so a crash never leaves a truncated cache behind.
+    std::filesystem::path tmpPath = cachePath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Warning: cannot create splat cache " << tmpPath << std::endl;
+            return false;
+        }
+
+        static constexpr char kPadding[kSectionAlign] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(kPadding, kSectionAlign - sizeof(header));
+        for (uint32_t s = 0; s < kSectionCount; ++s)
+        {
+            const uint64_t size = header.sections[s].size;
+            out.write(reinterpret_cast<const char*>(arrays[s].first), static_cast<std::streamsize>(size));
+            out.write(kPadding, static_cast<std::streamsize>(alignUp(size) - size));
+        }
+
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(tmpPath);
+            std::cerr << "Warning: failed to write splat cache " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        std::cerr << "Warning: failed to move splat cache into place: " << cachePath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+SplatCache::SplatCache(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath)
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(cachePath, ec))
+        return;
+
+    file_ = std::make_unique<MappedFile>(cachePath);
+    if (!file_->valid() || file_->size() < kSectionAlign)
+        return;
+
+    CacheHeader header;
+    std::memcpy(&header, file_->data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.headerSize != sizeof(CacheHeader) || header.headerChecksum != headerChecksum(header))
+    {
+        std::cerr << "Warning: ignoring corrupt splat cache " << cachePath << std::endl;
+        return;
+    }
+
+    if (!sourcePath.empty())
+    {
+        uint64_t sourceSize = 0;
+        int64_t  sourceTime = 0;
+        if (!sourceStamp(sourcePath, sourceSize, sourceTime) ||
+            sourceSize != header.sourceSize || sourceTime != header.sourceTime)
+        {
+            std::cout << "Splat cache is stale, rebuilding: " << cachePath << std::endl;
+            return;
+        }
+    }
+
+    const float* arrays[kSectionCount];
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+    {
+        const SectionEntry& section = header.sections[s];
+        if (section.offset % kSectionAlign != 0 || section.offset > file_->size() ||
+            section.size > file_->size() - section.offset)
+        {
+            std::cerr << "Warning: ignoring truncated splat cache " << cachePath << std::endl;
+            return;
+        }
+        arrays[s] = reinterpret_cast<const float*>(file_->data() + section.offset);
+    }
+
+    // Every section holds either nothing (attribute absent in the PLY) or `width` floats per splat.
+    const uint64_t widths[kSectionCount] = {3, 3, header.fRestPerSplat, 1, 3, 4};
+    bool           consistent            = header.sections[Positions].size == header.count * 3 * sizeof(float);
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+    {
+        const uint64_t size = header.sections[s].size;
+        consistent = consistent && (size == 0 || size == header.count * widths[s] * sizeof(float));
+    }
+    if (!consistent)
+    {
+        std::cerr << "Warning: ignoring inconsistent splat cache " << cachePath << std::endl;
+        return;
+    }
+
+    view_.count         = header.count;
+    view_.fRestPerSplat = header.fRestPerSplat;
+    view_.positions     = arrays[Positions];
+    view_.f_dc          = arrays[FDc];
+    view_.f_rest        = arrays[FRest];
+    view_.opacity       = arrays[Opacity];
+    view_.scale         = arrays[Scale];
+    view_.rotation      = arrays[Rotation];
+    shDegree_           = header.shDegree;
+    valid_              = true;
+}
+
+SplatCache::~SplatCache() = default;
+
+bool SplatCache::coversShDegree(int32_t maxShDegree, const std::filesystem::path& sourcePath) const
+{
+    if (!valid_ || shDegree_ >= maxShDegree)
+        return valid_;
+
+    PlyInfo info;
+    if (!readPlyInfo(sourcePath, info))
+        return false;
+
+    int32_t sourceDegree = 0;
+    for (int32_t d = 1; d <= 3; ++d)
+    {
+        if (info.fRestPerSplat >= kShCoeffsPerChannel[d] * 3)
+            sourceDegree = d;
+    }
+    return shDegree_ >= std::min(maxShDegree, sourceDegree);
+}
+
+bool SplatCache::verifyPayload() const
+{
+    if (!valid_)
+        return false;
+
+    CacheHeader header;
+    std::memcpy(&header, file_->data(), sizeof(header));
+
+    uint64_t hash = checksum64(nullptr, 0);
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+        hash = checksum64(file_->data() + header.sections[s].offset, header.sections[s].size, hash);
+    return hash == header.payloadChecksum;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include "SplatSet.h"
+
+class MappedFile;
+
+// Native binary cache of a loaded SplatSet (.gsbin).
+//
+// Stores the SOA arrays already converted to the renderer's coordinate system,
+// each in its own 256-byte-aligned section, behind a small header (count, SH
+// degree, section offsets, source PLY size/mtime and checksums). Reading it is
+// a memory map plus a header check, so later launches skip PLY parsing and
+// convertRdfToRub entirely.
+//
+// Usage:
+//   const auto cachePath = splatCachePath("scene.ply");     // scene.gsbin
+//   SplatCache cache(cachePath, "scene.ply");
+//   if (!cache.valid()) {
+//       SplatSet splats;
+//       loadPly("scene.ply", splats);
+//       writeSplatCache(cachePath, splats, "scene.ply");
+//   }
+
+// Cache file location for a source PLY: same directory, ".gsbin" extension.
+std::filesystem::path splatCachePath(const std::filesystem::path& plyPath);
+
+// Writes `splats` to `cachePath`. `sourcePath` is recorded so stale caches are
+// rejected after the PLY changes. Returns false (and leaves no file) on failure.
+bool writeSplatCache(const std::filesystem::path& cachePath, const SplatSet& splats,
+                     const std::filesystem::path& sourcePath);
+
+class SplatCache
+{
+public:
+    // Maps `cachePath` read-only. The cache is invalid if it is missing, has a bad
+    // header, or no longer matches `sourcePath` (pass an empty path to skip that check).
+    SplatCache(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath);
+    ~SplatCache();
+
+    SplatCache(const SplatCache&)            = delete;
+    SplatCache& operator=(const SplatCache&) = delete;
+
+    bool valid() const { return valid_; }
+
+    // Pointers into the mapping; valid for the lifetime of this object.
+    const SplatView& view() const { return view_; }
+    size_t  size() const { return view_.count; }
+    int32_t maxShDegree() const { return shDegree_; }
+
+    // True if the cache holds every SH band a load with `maxShDegree` would read from
+    // `sourcePath`. A cache written with fewer bands only falls short when the source
+    // actually has more, which is checked from the PLY header.
+    bool coversShDegree(int32_t maxShDegree, const std::filesystem::path& sourcePath) const;
+
+    // Recomputes the payload checksum. Touches every page, so it is not done on load.
+    bool verifyPayload() const;
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    SplatView                   view_;
+    int32_t                     shDegree_ = -1;
+    bool                        valid_    = false;
+};
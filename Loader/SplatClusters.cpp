@@ -0,0 +1,81 @@
+#include "SplatClusters.h"
+#include "QuantizedSplats.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+constexpr size_t kMinClustersPerTask = 256;
+
+// 3 sigma along the largest axis.
+inline float splatExtent(const float* logScale)
+{
+    return logScale ? 3.0f * std::exp(std::max(logScale[0], std::max(logScale[1], logScale[2]))) : 0.0f;
+}
+
+} // namespace
+
+void computeClusterBounds(const SplatView& splats, float* spheres, uint32_t threadCount)
+{
+    parallelFor(clusterCount(splats.count), threadCount, kMinClustersPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            const size_t first = c * kClusterRows;
+            const size_t last  = std::min(splats.count, first + kClusterRows);
+
+            // Box around every extent, then the sphere around the box center.
+            float lo[3], hi[3];
+            for (int i = 0; i < 3; ++i)
+            {
+                lo[i] = std::numeric_limits<float>::max();
+                hi[i] = std::numeric_limits<float>::lowest();
+            }
+            for (size_t r = first; r < last; ++r)
+            {
+                const float extent = splatExtent(splats.scale ? splats.scale + r * 3 : nullptr);
+                for (int i = 0; i < 3; ++i)
+                {
+                    lo[i] = std::min(lo[i], splats.positions[r * 3 + i] - extent);
+                    hi[i] = std::max(hi[i], splats.positions[r * 3 + i] + extent);
+                }
+            }
+
+            float* sphere = spheres + c * 4;
+            float  radius = 0.0f;
+            for (int i = 0; i < 3; ++i)
+                sphere[i] = 0.5f * (lo[i] + hi[i]);
+            for (size_t r = first; r < last; ++r)
+            {
+                const float dx = splats.positions[r * 3] - sphere[0];
+                const float dy = splats.positions[r * 3 + 1] - sphere[1];
+                const float dz = splats.positions[r * 3 + 2] - sphere[2];
+                radius = std::max(radius, std::sqrt(dx * dx + dy * dy + dz * dz) +
+                                              splatExtent(splats.scale ? splats.scale + r * 3 : nullptr));
+            }
+            sphere[3] = radius;
+        }
+    });
+}
+
+void computeClusterBounds(const QuantizedSplatSet& splats, float* spheres)
+{
+    static_assert(kClusterRows == kQuantChunkSize, "clusters and quantization chunks cover the same rows");
+    for (size_t c = 0; c < splats.chunks.size(); ++c)
+    {
+        const QuantizedChunk& chunk = splats.chunks[c];
+        float* sphere = spheres + c * 4;
+        float  halfDiagonal = 0.0f;
+        for (int i = 0; i < 3; ++i)
+        {
+            sphere[i] = 0.5f * (chunk.minPosition[i] + chunk.maxPosition[i]);
+            const float half = 0.5f * (chunk.maxPosition[i] - chunk.minPosition[i]);
+            halfDiagonal += half * half;
+        }
+        sphere[3] = std::sqrt(halfDiagonal) + splatExtent(chunk.maxScale);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "SplatSet.h"
+
+struct QuantizedSplatSet;
+
+// Bounding spheres of fixed runs of splats ("clusters") for GPU cluster culling.
+//
+// Cluster c holds rows [c * kClusterRows, (c + 1) * kClusterRows), the same rows as
+// one projection workgroup and one QuantizedSplats chunk. Each sphere encloses the
+// 3 sigma extent of every splat of its cluster, so a cluster outside the view
+// frustum contributes nothing to the image. Clusters are only tight when the rows
+// are spatially ordered (reorderMorton, or a Morton-ordered quantized scene).
+//
+// Usage:
+//   std::vector<float> spheres(clusterCount(splats.count) * 4);
+//   computeClusterBounds(splats, spheres.data());   // center xyz, radius per cluster
+
+inline constexpr size_t kClusterRows = 256;
+
+inline size_t clusterCount(size_t count)
+{
+    return (count + kClusterRows - 1) / kClusterRows;
+}
+
+// 4 floats per cluster (center x, y, z, radius) into `spheres`. Positions are
+// required; without scales the spheres only enclose the splat centers.
+void computeClusterBounds(const SplatView& splats, float* spheres, uint32_t threadCount = 0);
+
+// Same from the chunk table of a quantized scene (chunk bounds of position and log-scale).
+void computeClusterBounds(const QuantizedSplatSet& splats, float* spheres);
@@ -0,0 +1,357 @@
+#include "SplatFormats.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "miniply.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+constexpr float  kShC0             = 0.28209479177387814f; // zeroth-order SH basis constant
+constexpr size_t kSplatRecordSize  = 32;
+constexpr size_t kMinChunksPerTask = 64;
+constexpr size_t kMinRowsPerTask   = 64 * 1024;
+
+// Chunk bound properties in QuantizedChunk order; the color bounds are missing
+// from files written by older PlayCanvas tools (colors then span [0, 1]).
+constexpr const char* kChunkProperties[18] = {
+    "min_x",       "min_y",       "min_z",       "max_x",       "max_y",       "max_z",
+    "min_scale_x", "min_scale_y", "min_scale_z", "max_scale_x", "max_scale_y", "max_scale_z",
+    "min_r",       "min_g",       "min_b",       "max_r",       "max_g",       "max_b",
+};
+
+struct CompressedProperties
+{
+    uint32_t chunk[18];
+    uint32_t chunkCount = 0; // 12 or 18
+    uint32_t packed[4];      // position, rotation, scale, color
+};
+
+bool findChunkProperties(const miniply::PLYElement& elem, CompressedProperties& props)
+{
+    props.chunkCount = 0;
+    for (uint32_t i = 0; i < 18; ++i)
+    {
+        props.chunk[i] = elem.find_property(kChunkProperties[i]);
+        if (props.chunk[i] == miniply::kInvalidIndex)
+            break;
+        props.chunkCount = i + 1;
+    }
+    if (props.chunkCount < 18)
+        props.chunkCount = props.chunkCount >= 12 ? 12 : 0;
+    return props.chunkCount > 0;
+}
+
+bool findPackedProperties(const miniply::PLYElement& elem, CompressedProperties& props)
+{
+    return elem.find_properties(props.packed, 4, "packed_position", "packed_rotation", "packed_scale",
+                                "packed_color");
+}
+
+// PlayCanvas packs the quaternion as (x, y, z, w); SplatSet keeps rot_0..3 = (w, x, y, z).
+// The 10-bit codes are moved, not re-quantized. The RDF → RUB flip negates y and z,
+// which on a code is 1023 - code; when the dropped component is y or z the whole
+// quaternion is negated instead (q and -q are the same rotation) so it stays positive.
+uint32_t transcodeRotation(uint32_t packed, bool flipYZ)
+{
+    const uint32_t fileLargest = packed >> 30;
+    uint32_t       fileCodes[4] = {};
+    uint32_t       shift        = 20;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == fileLargest)
+            continue;
+        fileCodes[i] = (packed >> shift) & 0x3ffu;
+        shift -= 10;
+    }
+
+    const uint32_t largest  = (fileLargest + 1) & 3u;
+    const uint32_t codes[4] = {fileCodes[3], fileCodes[0], fileCodes[1], fileCodes[2]};
+
+    uint32_t result = largest << 30;
+    shift           = 20;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const bool negate = flipYZ && (largest >= 2 ? i < 2 : i >= 2);
+        result |= (negate ? 1023u - codes[i] : codes[i]) << shift;
+        shift -= 10;
+    }
+    return result;
+}
+
+// Mirrors y and z within the chunk bounds: codes become max - code, bounds swap and negate.
+uint32_t flipPackedYZ(uint32_t packed)
+{
+    return (packed & 0xffe00000u) | ((0x3ffu - ((packed >> 11) & 0x3ffu)) << 11) | (0x7ffu - (packed & 0x7ffu));
+}
+
+void flipChunkYZ(QuantizedChunk& chunk)
+{
+    for (int i = 1; i < 3; ++i)
+    {
+        const float minValue = chunk.minPosition[i];
+        chunk.minPosition[i] = -chunk.maxPosition[i];
+        chunk.maxPosition[i] = -minValue;
+    }
+}
+
+// PlayCanvas writes trunc((v / 8 + 0.5) * 256) per coefficient; each byte maps to the
+// QuantizedSplats byte of the same value (and of its negation, for flipped coefficients).
+struct ShByteTables
+{
+    std::array<uint8_t, 256> keep;
+    std::array<uint8_t, 256> negate;
+
+    ShByteTables()
+    {
+        for (uint32_t b = 0; b < 256; ++b)
+        {
+            const float value   = ((static_cast<float>(b) + 0.5f) / 256.0f - 0.5f) * 8.0f;
+            const float negated = -value;
+            quantizeShRest(&value, &keep[b], 1);
+            quantizeShRest(&negated, &negate[b], 1);
+        }
+    }
+};
+
+float logit(float alpha)
+{
+    alpha = std::clamp(alpha, 0.5f / 255.0f, 254.5f / 255.0f);
+    return -std::log(1.0f / alpha - 1.0f);
+}
+
+} // namespace
+
+bool isCompressedPly(const std::filesystem::path& filename)
+{
+    miniply::PLYReader reader(filename.string().c_str());
+    if (!reader.valid())
+        return false;
+
+    const uint32_t chunkIdx  = reader.find_element("chunk");
+    const uint32_t vertexIdx = reader.find_element(miniply::kPLYVertexElement);
+    if (chunkIdx == miniply::kInvalidIndex || vertexIdx == miniply::kInvalidIndex)
+        return false;
+
+    CompressedProperties props;
+    return findChunkProperties(*reader.get_element(chunkIdx), props) &&
+           findPackedProperties(*reader.get_element(vertexIdx), props);
+}
+
+bool isSplatFile(const std::filesystem::path& filename)
+{
+    return filename.extension() == ".splat";
+}
+
+bool loadCompressedPly(const std::filesystem::path& filename, QuantizedSplatSet& output,
+                       const PlyLoadOptions& options)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    miniply::PLYReader reader(filename.string().c_str());
+    if (!reader.valid())
+    {
+        std::cerr << "Error: failed to open PLY file: " << filename << std::endl;
+        return false;
+    }
+
+    // Elements come in file order: chunk, vertex, then the optional sh element.
+    CompressedProperties        props;
+    std::vector<QuantizedChunk> chunks;
+    std::vector<uint8_t>        shBytes;
+    size_t                      count       = 0;
+    uint32_t                    shStride    = 0; // coefficients per channel in the file
+    uint32_t                    shKeep      = 0; // coefficients per channel kept
+    bool                        foundVertex = false;
+
+    for (; reader.has_element(); reader.next_element())
+    {
+        const miniply::PLYElement& elem = *reader.element();
+        if (reader.element_is("chunk"))
+        {
+            if (!findChunkProperties(elem, props) || !reader.load_element())
+                break;
+            chunks.resize(elem.count);
+            for (QuantizedChunk& chunk : chunks)
+            {
+                std::fill(std::begin(chunk.minColor), std::end(chunk.minColor), 0.0f);
+                std::fill(std::begin(chunk.maxColor), std::end(chunk.maxColor), 1.0f);
+            }
+            reader.extract_properties_with_stride(props.chunk, props.chunkCount, miniply::PLYPropertyType::Float,
+                                                  chunks.data(), sizeof(QuantizedChunk));
+        }
+        else if (reader.element_is(miniply::kPLYVertexElement))
+        {
+            if (!findPackedProperties(elem, props) || !reader.load_element())
+                break;
+            count = elem.count;
+            output.resize(count, 0);
+            void* packedTargets[4] = {output.position.data(), output.rotation.data(), output.scale.data(),
+                                      output.color.data()};
+            for (uint32_t i = 0; i < 4; ++i)
+                reader.extract_properties(&props.packed[i], 1, miniply::PLYPropertyType::UInt, packedTargets[i]);
+            foundVertex = true;
+        }
+        else if (reader.element_is("sh") && elem.count == count)
+        {
+            uint32_t fileCount = 0;
+            char     name[16];
+            for (; fileCount < 45; ++fileCount)
+            {
+                std::snprintf(name, sizeof(name), "f_rest_%u", fileCount);
+                if (elem.find_property(name) == miniply::kInvalidIndex)
+                    break;
+            }
+            shStride              = fileCount / 3;
+            const uint32_t maxKeep = kShCoeffsPerChannel[std::clamp(options.maxShDegree, 0, 3)];
+            for (uint32_t coeffs : kShCoeffsPerChannel)
+            {
+                if (coeffs <= shStride && coeffs <= maxKeep)
+                    shKeep = coeffs;
+            }
+            if (shKeep == 0 || !reader.load_element())
+                continue;
+
+            uint32_t shProps[45];
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                for (uint32_t j = 0; j < shKeep; ++j)
+                {
+                    std::snprintf(name, sizeof(name), "f_rest_%u", c * shStride + j);
+                    shProps[c * shKeep + j] = elem.find_property(name);
+                }
+            }
+            shBytes.resize(count * shKeep * 3);
+            reader.extract_properties(shProps, shKeep * 3, miniply::PLYPropertyType::UChar, shBytes.data());
+        }
+    }
+
+    if (!foundVertex || chunks.size() != quantChunkCount(count) || count == 0)
+    {
+        std::cerr << "Error: invalid compressed PLY file (missing chunk or packed vertex data): " << filename
+                  << std::endl;
+        return false;
+    }
+
+    output.chunks = std::move(chunks);
+    if (!shBytes.empty())
+    {
+        output.fRestPerSplat = shKeep * 3;
+        output.f_rest        = std::move(shBytes);
+    }
+
+    // Remap rotations and SH bytes (and apply the axis flip) chunk by chunk.
+    static const ShByteTables shTables;
+    const bool                flip  = options.convertToRub;
+    const size_t              width = output.fRestPerSplat;
+    parallelFor(output.chunks.size(), options.threadCount, kMinChunksPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t c = begin; c < end; ++c)
+        {
+            const size_t first = c * kQuantChunkSize;
+            const size_t last  = std::min(count, first + kQuantChunkSize);
+            if (flip)
+                flipChunkYZ(output.chunks[c]);
+            for (size_t r = first; r < last; ++r)
+            {
+                output.rotation[r] = transcodeRotation(output.rotation[r], flip);
+                if (flip)
+                    output.position[r] = flipPackedYZ(output.position[r]);
+            }
+            for (size_t r = first; r < last && width > 0; ++r)
+            {
+                uint8_t* coeffs = output.f_rest.data() + r * width;
+                for (uint32_t ch = 0; ch < 3; ++ch)
+                {
+                    for (uint32_t j = 0; j < shKeep; ++j)
+                    {
+                        uint8_t& b = coeffs[ch * shKeep + j];
+                        b          = flip && kRdfToRubShFlip[j] < 0.0f ? shTables.negate[b] : shTables.keep[b];
+                    }
+                }
+            }
+        }
+    });
+
+    auto      endTime  = std::chrono::high_resolution_clock::now();
+    long long loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    std::cout << "Compressed PLY loaded: " << count << " splats in " << loadTime << "ms" << std::endl;
+    return true;
+}
+
+bool loadCompressedPly(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options)
+{
+    QuantizedSplatSet quantized;
+    if (!loadCompressedPly(filename, quantized, options))
+        return false;
+    dequantizeSplats(quantized, output, options.threadCount);
+    return true;
+}
+
+bool loadSplatFile(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    MappedFile file(filename);
+    if (!file.valid() || file.size() == 0 || file.size() % kSplatRecordSize != 0)
+    {
+        std::cerr << "Error: not a .splat file (expected 32-byte records): " << filename << std::endl;
+        return false;
+    }
+
+    const size_t count = file.size() / kSplatRecordSize;
+    output.positions.resize(count * 3);
+    output.f_dc.resize(count * 3);
+    output.f_rest.clear();
+    output.opacity.resize(count);
+    output.scale.resize(count * 3);
+    output.rotation.resize(count * 4);
+
+    parallelFor(count, options.threadCount, kMinRowsPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t r = begin; r < end; ++r)
+        {
+            const uint8_t* record = file.data() + r * kSplatRecordSize;
+            float          linearScale[3];
+            std::memcpy(&output.positions[r * 3], record, 3 * sizeof(float));
+            std::memcpy(linearScale, record + 12, 3 * sizeof(float));
+
+            const uint8_t* rgba     = record + 24;
+            const uint8_t* rotation = record + 28;
+            for (int i = 0; i < 3; ++i)
+            {
+                output.scale[r * 3 + i] = std::log(std::max(linearScale[i], 1e-30f));
+                output.f_dc[r * 3 + i]  = (static_cast<float>(rgba[i]) / 255.0f - 0.5f) / kShC0;
+            }
+            output.opacity[r] = logit(static_cast<float>(rgba[3]) / 255.0f);
+            for (int i = 0; i < 4; ++i)
+                output.rotation[r * 4 + i] = (static_cast<float>(rotation[i]) - 128.0f) / 128.0f;
+        }
+    });
+
+    if (options.convertToRub)
+        output.convertRdfToRub(options.threadCount);
+
+    auto      endTime  = std::chrono::high_resolution_clock::now();
+    long long loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    std::cout << "Splat file loaded: " << count << " splats in " << loadTime << "ms (mapped)" << std::endl;
+    return true;
+}
+
+bool loadSplatScene(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options)
+{
+    if (isSplatFile(filename))
+        return loadSplatFile(filename, output, options);
+    if (isCompressedPly(filename))
+        return loadCompressedPly(filename, output, options);
+    return loadPly(filename, output, options);
+}
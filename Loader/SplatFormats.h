@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include "PlyLoader.h"
+#include "QuantizedSplats.h"
+
+// Readers for the compact splat formats produced by other content pipelines.
+//
+//   PlayCanvas compressed.ply  "chunk" element with per-256-splat bounds, "vertex" element
+//                              with packed_position / packed_rotation / packed_scale /
+//                              packed_color (uint32), optional "sh" element with one uchar
+//                              per f_rest coefficient
+//   antimatter15 .splat        headerless 32-byte records: position and linear scale as
+//                              float3, RGBA as uchar4, rotation as uchar4 (q * 128 + 128, w first)
+//
+// compressed.ply uses the QuantizedSplats bit layout (apart from the quaternion order and
+// the SH byte mapping, which are remapped exactly), so it is transcoded straight into a
+// QuantizedSplatSet without a float round trip. Both readers split the decode across
+// options.threadCount workers and honour convertToRub and maxShDegree.
+//
+// Usage:
+//   QuantizedSplatSet quantized;
+//   if (isCompressedPly("scene.compressed.ply"))
+//       loadCompressedPly("scene.compressed.ply", quantized);
+//
+//   SplatSet splats;
+//   loadSplatScene("scene.splat", splats);   // .splat, compressed.ply or INRIA PLY
+
+// True if the file is a PLY with the PlayCanvas "chunk" + packed "vertex" layout.
+bool isCompressedPly(const std::filesystem::path& filename);
+
+// True for the antimatter15 .splat extension (the format has no header to check).
+bool isSplatFile(const std::filesystem::path& filename);
+
+bool loadCompressedPly(const std::filesystem::path& filename, QuantizedSplatSet& output,
+                       const PlyLoadOptions& options = {});
+
+// Transcodes to a QuantizedSplatSet, then dequantizes into fp32 arrays.
+bool loadCompressedPly(const std::filesystem::path& filename, SplatSet& output,
+                       const PlyLoadOptions& options = {});
+
+bool loadSplatFile(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options = {});
+
+// Picks loadSplatFile, loadCompressedPly or loadPly from the file.
+bool loadSplatScene(const std::filesystem::path& filename, SplatSet& output, const PlyLoadOptions& options = {});
@@ -0,0 +1,563 @@
+#include "SplatLod.h"
+#include "Covariance.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+
+constexpr char     kMagic[8]     = {'G', 'S', 'L', 'O', 'D', 0, 0, 0};
+constexpr uint32_t kVersion      = 1;
+constexpr uint64_t kSectionAlign = 256;
+constexpr uint32_t kSectionCount = 7;
+constexpr size_t   kMinNodesPerTask = 1024;
+
+// Merged opacity stays below 1 so its logit is finite.
+constexpr double kMaxMergedAlpha = 0.99;
+constexpr double kMinMergedAlpha = 1e-6;
+
+// Section order within the file: the node table, then the arrays in SplatView order.
+enum Section : uint32_t
+{
+    Nodes,
+    Positions,
+    FDc,
+    FRest,
+    Opacity,
+    Scale,
+    Rotation,
+};
+
+struct SectionEntry
+{
+    uint64_t offset; // from start of file, multiple of kSectionAlign
+    uint64_t size;   // in bytes
+};
+
+struct LodHeader
+{
+    char         magic[8];
+    uint32_t     version;
+    uint32_t     headerSize;
+    uint64_t     leafCount;
+    uint64_t     nodeCount;
+    uint32_t     fRestPerSplat;
+    uint32_t     reserved;
+    uint64_t     sourceSize; // size of the source file in bytes (0 = no source)
+    int64_t      sourceTime; // last_write_time of the source file, in file clock ticks
+    SectionEntry sections[kSectionCount];
+    uint64_t     headerChecksum;
+};
+static_assert(sizeof(LodHeader) <= kSectionAlign, "LOD header must fit before the first section");
+static_assert(sizeof(LodNode) == 24, "LOD nodes are written as-is");
+
+uint64_t headerChecksum(const LodHeader& header)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&header);
+    uint64_t    hash  = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < offsetof(LodHeader, headerChecksum); ++i)
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    return hash;
+}
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + kSectionAlign - 1) & ~(kSectionAlign - 1);
+}
+
+bool sourceStamp(const std::filesystem::path& sourcePath, uint64_t& size, int64_t& time)
+{
+    std::error_code ec;
+    size = std::filesystem::file_size(sourcePath, ec);
+    if (ec)
+        return false;
+    time = std::filesystem::last_write_time(sourcePath, ec).time_since_epoch().count();
+    return !ec;
+}
+
+double sigmoid(double x)
+{
+    return 1.0 / (1.0 + std::exp(-x));
+}
+
+// Largest projected area of the ellipsoid up to π: product of the two largest axes.
+double ellipsoidArea(const float* logScale)
+{
+    float s[3] = {logScale[0], logScale[1], logScale[2]};
+    std::sort(s, s + 3);
+    return std::exp(static_cast<double>(s[1]) + s[2]);
+}
+
+// Eigen decomposition of a symmetric 3x3 matrix by cyclic Jacobi rotations.
+// Column k of `vectors` is the eigenvector of values[k].
+void symmetricEigen(double a[3][3], double values[3], double vectors[3][3])
+{
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            vectors[i][j] = i == j ? 1.0 : 0.0;
+
+    for (int sweep = 0; sweep < 16; ++sweep)
+    {
+        const double offDiagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        const double diagonal    = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        if (offDiagonal <= 1e-24 * diagonal)
+            break;
+        for (int p = 0; p < 2; ++p)
+        {
+            for (int q = p + 1; q < 3; ++q)
+            {
+                if (a[p][q] == 0.0)
+                    continue;
+                const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const double t     = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c     = 1.0 / std::sqrt(t * t + 1.0);
+                const double s     = t * c;
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double akp = a[k][p], akq = a[k][q];
+                    a[k][p] = c * akp - s * akq;
+                    a[k][q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double apk = a[p][k], aqk = a[q][k];
+                    a[p][k] = c * apk - s * aqk;
+                    a[q][k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < 3; ++k)
+                {
+                    const double vkp = vectors[k][p], vkq = vectors[k][q];
+                    vectors[k][p] = c * vkp - s * vkq;
+                    vectors[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < 3; ++i)
+        values[i] = a[i][i];
+}
+
+// Log-scales and (w, x, y, z) rotation with R·S·Sᵀ·Rᵀ = covariance (computeCovariance inverted).
+void decomposeCovariance(const double covariance[6], float* logScale, float* rotation)
+{
+    double a[3][3] = {
+        {covariance[0], covariance[1], covariance[2]},
+        {covariance[1], covariance[3], covariance[4]},
+        {covariance[2], covariance[4], covariance[5]},
+    };
+    double values[3], r[3][3];
+    symmetricEigen(a, values, r);
+
+    // Proper rotation: flip the last axis of a reflection.
+    const double det = r[0][0] * (r[1][1] * r[2][2] - r[1][2] * r[2][1]) -
+                       r[0][1] * (r[1][0] * r[2][2] - r[1][2] * r[2][0]) +
+                       r[0][2] * (r[1][0] * r[2][1] - r[1][1] * r[2][0]);
+    if (det < 0.0)
+        for (int i = 0; i < 3; ++i)
+            r[i][2] = -r[i][2];
+
+    const double largest = std::max(values[0], std::max(values[1], values[2]));
+    for (int i = 0; i < 3; ++i)
+        logScale[i] = static_cast<float>(0.5 * std::log(std::max(values[i], largest * 1e-12 + 1e-30)));
+
+    double       q[4];
+    const double trace = r[0][0] + r[1][1] + r[2][2];
+    if (trace > 0.0)
+    {
+        const double s = 2.0 * std::sqrt(trace + 1.0);
+        q[0] = 0.25 * s;
+        q[1] = (r[2][1] - r[1][2]) / s;
+        q[2] = (r[0][2] - r[2][0]) / s;
+        q[3] = (r[1][0] - r[0][1]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        const double s = 2.0 * std::sqrt(1.0 + r[0][0] - r[1][1] - r[2][2]);
+        q[0] = (r[2][1] - r[1][2]) / s;
+        q[1] = 0.25 * s;
+        q[2] = (r[0][1] + r[1][0]) / s;
+        q[3] = (r[0][2] + r[2][0]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+        const double s = 2.0 * std::sqrt(1.0 + r[1][1] - r[0][0] - r[2][2]);
+        q[0] = (r[0][2] - r[2][0]) / s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = 0.25 * s;
+        q[3] = (r[1][2] + r[2][1]) / s;
+    }
+    else
+    {
+        const double s = 2.0 * std::sqrt(1.0 + r[2][2] - r[0][0] - r[1][1]);
+        q[0] = (r[1][0] - r[0][1]) / s;
+        q[1] = (r[0][2] + r[2][0]) / s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+        q[3] = 0.25 * s;
+    }
+    for (int i = 0; i < 4; ++i)
+        rotation[i] = static_cast<float>(q[i]);
+}
+
+// Merges rows [first, first + count) of `splats` into row `dst` and node `node`.
+// `weights` holds the moment weight of every inner node row (indexed by node);
+// leaves use opacity × area. `w` is per-task scratch of at least `count` entries.
+void mergeRows(SplatSet& splats, size_t leafCount, const std::vector<LodNode>& nodes,
+               std::vector<float>& weights, size_t first, size_t count, size_t dst, LodNode& node,
+               std::vector<double>& w)
+{
+    const size_t fRest = splats.f_rest.size() / splats.size();
+    float*       p     = splats.positions.data();
+    float*       dc    = splats.f_dc.data();
+    float*       rest  = splats.f_rest.data();
+    float*       o     = splats.opacity.data();
+    float*       s     = splats.scale.data();
+    float*       q     = splats.rotation.data();
+
+    // Moment weights; a fully transparent group falls back to equal weights.
+    double total = 0.0;
+    double cover = 0.0; // Σ α·area, preserved by the merged opacity
+    for (size_t c = 0; c < count; ++c)
+    {
+        const size_t r     = first + c;
+        const double alpha = sigmoid(o[r]);
+        const double area  = ellipsoidArea(&s[r * 3]);
+        w[c] = r < leafCount ? alpha * area : weights[r - leafCount];
+        if (!std::isfinite(w[c]) || w[c] < 0.0)
+            w[c] = 0.0;
+        total += w[c];
+        cover += std::isfinite(alpha * area) ? alpha * area : 0.0;
+    }
+    if (total <= 0.0)
+    {
+        std::fill(w.begin(), w.begin() + count, 1.0);
+        total = static_cast<double>(count);
+    }
+
+    double mean[3] = {};
+    for (size_t c = 0; c < count; ++c)
+        for (int i = 0; i < 3; ++i)
+            mean[i] += w[c] * p[(first + c) * 3 + i];
+    for (int i = 0; i < 3; ++i)
+        mean[i] /= total;
+
+    // Σ = Σc wc (Σc + dc·dcᵀ) / W with dc = μc − μ.
+    double covariance[6] = {};
+    for (size_t c = 0; c < count; ++c)
+    {
+        const size_t r = first + c;
+        float        child[6];
+        computeCovariance(&s[r * 3], &q[r * 4], child);
+        const double d[3] = {p[r * 3] - mean[0], p[r * 3 + 1] - mean[1], p[r * 3 + 2] - mean[2]};
+        covariance[0] += w[c] * (child[0] + d[0] * d[0]);
+        covariance[1] += w[c] * (child[1] + d[0] * d[1]);
+        covariance[2] += w[c] * (child[2] + d[0] * d[2]);
+        covariance[3] += w[c] * (child[3] + d[1] * d[1]);
+        covariance[4] += w[c] * (child[4] + d[1] * d[2]);
+        covariance[5] += w[c] * (child[5] + d[2] * d[2]);
+    }
+    for (double& v : covariance)
+        v /= total;
+
+    for (int i = 0; i < 3; ++i)
+        p[dst * 3 + i] = static_cast<float>(mean[i]);
+    decomposeCovariance(covariance, &s[dst * 3], &q[dst * 4]);
+
+    // Same covered area as the children: α = Σ αc·areac / area.
+    const double alpha = std::clamp(cover / ellipsoidArea(&s[dst * 3]), kMinMergedAlpha, kMaxMergedAlpha);
+    o[dst] = static_cast<float>(std::log(alpha / (1.0 - alpha)));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        double sum = 0.0;
+        for (size_t c = 0; c < count; ++c)
+            sum += w[c] * dc[(first + c) * 3 + i];
+        dc[dst * 3 + i] = static_cast<float>(sum / total);
+    }
+    for (size_t i = 0; i < fRest; ++i)
+    {
+        double sum = 0.0;
+        for (size_t c = 0; c < count; ++c)
+            sum += w[c] * rest[(first + c) * fRest + i];
+        rest[dst * fRest + i] = static_cast<float>(sum / total);
+    }
+    weights[dst - leafCount] = static_cast<float>(total);
+
+    // Bounding sphere of the children's spheres (3 sigma for leaves).
+    float bounds[3][2];
+    auto  childSphere = [&](size_t r, float* center)
+    {
+        if (r >= leafCount)
+        {
+            const LodNode& child = nodes[r - leafCount];
+            std::memcpy(center, child.center, sizeof(child.center));
+            return child.radius;
+        }
+        std::memcpy(center, &p[r * 3], 3 * sizeof(float));
+        return 3.0f * std::exp(std::max(s[r * 3], std::max(s[r * 3 + 1], s[r * 3 + 2])));
+    };
+    for (int i = 0; i < 3; ++i)
+    {
+        bounds[i][0] = std::numeric_limits<float>::max();
+        bounds[i][1] = std::numeric_limits<float>::lowest();
+    }
+    for (size_t c = 0; c < count; ++c)
+    {
+        float       center[3];
+        const float radius = childSphere(first + c, center);
+        for (int i = 0; i < 3; ++i)
+        {
+            bounds[i][0] = std::min(bounds[i][0], center[i] - radius);
+            bounds[i][1] = std::max(bounds[i][1], center[i] + radius);
+        }
+    }
+    for (int i = 0; i < 3; ++i)
+        node.center[i] = 0.5f * (bounds[i][0] + bounds[i][1]);
+    node.radius = 0.0f;
+    for (size_t c = 0; c < count; ++c)
+    {
+        float       center[3];
+        const float radius = childSphere(first + c, center);
+        const float dx = center[0] - node.center[0], dy = center[1] - node.center[1], dz = center[2] - node.center[2];
+        node.radius = std::max(node.radius, std::sqrt(dx * dx + dy * dy + dz * dz) + radius);
+    }
+    node.firstChild = static_cast<uint32_t>(first);
+    node.childCount = static_cast<uint16_t>(count);
+}
+
+} // namespace
+
+bool buildLodHierarchy(SplatSet& splats, std::vector<LodNode>& nodes, const LodOptions& options)
+{
+    const size_t leafCount = splats.size();
+    const size_t branching = options.branching;
+    if (leafCount == 0 || splats.f_dc.size() != leafCount * 3 || splats.opacity.size() != leafCount ||
+        splats.scale.size() != leafCount * 3 || splats.rotation.size() != leafCount * 4)
+    {
+        std::cerr << "Error: LOD hierarchy needs positions, f_dc, opacity, scale and rotation" << std::endl;
+        return false;
+    }
+    if (branching < 2 || branching > std::numeric_limits<uint16_t>::max())
+    {
+        std::cerr << "Error: LOD branching must be between 2 and 65535" << std::endl;
+        return false;
+    }
+
+    // Level sizes: each level groups `branching` consecutive rows of the level below.
+    std::vector<size_t> levelCounts;
+    size_t              nodeCount = 0;
+    for (size_t below = leafCount; levelCounts.empty() || below > 1;)
+    {
+        below = (below + branching - 1) / branching;
+        levelCounts.push_back(below);
+        nodeCount += below;
+    }
+    if (leafCount + nodeCount > std::numeric_limits<uint32_t>::max())
+    {
+        std::cerr << "Error: LOD hierarchy limited to 2^32 rows (" << leafCount + nodeCount << ")" << std::endl;
+        return false;
+    }
+
+    const size_t fRest = splats.f_rest.size() / leafCount;
+    const size_t rows  = leafCount + nodeCount;
+    splats.positions.resize(rows * 3);
+    splats.f_dc.resize(rows * 3);
+    splats.f_rest.resize(rows * fRest);
+    splats.opacity.resize(rows);
+    splats.scale.resize(rows * 3);
+    splats.rotation.resize(rows * 4);
+    nodes.assign(nodeCount, LodNode{});
+    std::vector<float> weights(nodeCount);
+
+    // Levels bottom-up; nodes of one level only read rows of the level below.
+    size_t belowFirst = 0, belowCount = leafCount, levelFirst = 0;
+    for (size_t level = 0; level < levelCounts.size(); ++level)
+    {
+        parallelFor(levelCounts[level], options.threadCount, kMinNodesPerTask, [&](size_t begin, size_t end)
+        {
+            std::vector<double> scratch(branching);
+            for (size_t j = begin; j < end; ++j)
+            {
+                const size_t first = belowFirst + j * branching;
+                const size_t count = std::min(branching, belowCount - j * branching);
+                LodNode&     node  = nodes[levelFirst + j];
+                mergeRows(splats, leafCount, nodes, weights, first, count, leafCount + levelFirst + j, node,
+                          scratch);
+                node.level = static_cast<uint16_t>(level + 1);
+            }
+        });
+        belowFirst = leafCount + levelFirst;
+        belowCount = levelCounts[level];
+        levelFirst += levelCounts[level];
+    }
+    return true;
+}
+
+std::filesystem::path lodScenePath(const std::filesystem::path& sourcePath)
+{
+    std::filesystem::path path = sourcePath;
+    path.replace_extension(".gsl");
+    return path;
+}
+
+bool isLodScene(const std::filesystem::path& path)
+{
+    return path.extension() == ".gsl";
+}
+
+bool writeLodScene(const std::filesystem::path& path, const SplatSet& splats, size_t leafCount,
+                   const std::vector<LodNode>& nodes, const std::filesystem::path& sourcePath)
+{
+    const SplatView view = splats.view();
+    if (view.count != leafCount + nodes.size() || nodes.empty())
+    {
+        std::cerr << "Error: LOD scene rows do not match the hierarchy" << std::endl;
+        return false;
+    }
+
+    const std::array<std::pair<const void*, size_t>, kSectionCount> sections = {{
+        {nodes.data(),    nodes.size() * sizeof(LodNode)},
+        {view.positions, splats.positions.size() * sizeof(float)},
+        {view.f_dc,      splats.f_dc.size() * sizeof(float)},
+        {view.f_rest,    splats.f_rest.size() * sizeof(float)},
+        {view.opacity,   splats.opacity.size() * sizeof(float)},
+        {view.scale,     splats.scale.size() * sizeof(float)},
+        {view.rotation,  splats.rotation.size() * sizeof(float)},
+    }};
+
+    LodHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version       = kVersion;
+    header.headerSize    = sizeof(LodHeader);
+    header.leafCount     = leafCount;
+    header.nodeCount     = nodes.size();
+    header.fRestPerSplat = static_cast<uint32_t>(view.fRestPerSplat);
+    if (!sourcePath.empty() && !sourceStamp(sourcePath, header.sourceSize, header.sourceTime))
+    {
+        std::cerr << "Warning: cannot stat " << sourcePath << ", not writing LOD scene" << std::endl;
+        return false;
+    }
+    uint64_t offset = kSectionAlign;
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+    {
+        header.sections[s] = {offset, sections[s].second};
+        offset             = alignUp(offset + sections[s].second);
+    }
+    header.headerChecksum = headerChecksum(header);
+
+    // Write to a temporary name first so a crash never leaves a truncated file behind.
+    std::filesystem::path tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "Warning: cannot create LOD scene " << tmpPath << std::endl;
+            return false;
+        }
+
+        static constexpr char kPadding[kSectionAlign] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(kPadding, kSectionAlign - sizeof(header));
+        for (uint32_t s = 0; s < kSectionCount; ++s)
+        {
+            const uint64_t size = sections[s].second;
+            out.write(static_cast<const char*>(sections[s].first), static_cast<std::streamsize>(size));
+            out.write(kPadding, static_cast<std::streamsize>(alignUp(size) - size));
+        }
+
+        if (!out)
+        {
+            out.close();
+            std::filesystem::remove(tmpPath);
+            std::cerr << "Warning: failed to write LOD scene " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tmpPath, ec);
+        std::cerr << "Warning: failed to move LOD scene into place: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+LodScene::LodScene(const std::filesystem::path& path, const std::filesystem::path& sourcePath)
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec))
+        return;
+
+    file_ = std::make_unique<MappedFile>(path);
+    if (!file_->valid() || file_->size() < kSectionAlign)
+        return;
+
+    LodHeader header;
+    std::memcpy(&header, file_->data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.headerSize != sizeof(LodHeader) || header.headerChecksum != headerChecksum(header))
+    {
+        std::cerr << "Warning: ignoring corrupt LOD scene " << path << std::endl;
+        return;
+    }
+
+    if (!sourcePath.empty() && header.sourceSize != 0)
+    {
+        uint64_t sourceSize = 0;
+        int64_t  sourceTime = 0;
+        if (!sourceStamp(sourcePath, sourceSize, sourceTime) ||
+            sourceSize != header.sourceSize || sourceTime != header.sourceTime)
+        {
+            std::cout << "LOD scene is stale, rebuilding: " << path << std::endl;
+            return;
+        }
+    }
+
+    // Every section must hold exactly `width` units per row (f_rest may be empty).
+    const uint64_t rows                    = header.leafCount + header.nodeCount;
+    const uint64_t widths[kSectionCount]   = {sizeof(LodNode), 3 * sizeof(float), 3 * sizeof(float),
+                                              header.fRestPerSplat * sizeof(float), sizeof(float),
+                                              3 * sizeof(float), 4 * sizeof(float)};
+    const void*    sections[kSectionCount] = {};
+    for (uint32_t s = 0; s < kSectionCount; ++s)
+    {
+        const SectionEntry& section  = header.sections[s];
+        const uint64_t      expected = (s == Nodes ? header.nodeCount : rows) * widths[s];
+        if (section.offset % kSectionAlign != 0 || section.offset > file_->size() ||
+            section.size > file_->size() - section.offset || section.size != expected)
+        {
+            std::cerr << "Warning: ignoring truncated LOD scene " << path << std::endl;
+            return;
+        }
+        sections[s] = file_->data() + section.offset;
+    }
+
+    nodes_              = static_cast<const LodNode*>(sections[Nodes]);
+    nodeCount_          = header.nodeCount;
+    leafCount_          = header.leafCount;
+    view_.count         = rows;
+    view_.fRestPerSplat = header.fRestPerSplat;
+    view_.positions     = static_cast<const float*>(sections[Positions]);
+    view_.f_dc          = static_cast<const float*>(sections[FDc]);
+    view_.f_rest        = header.fRestPerSplat > 0 ? static_cast<const float*>(sections[FRest]) : nullptr;
+    view_.opacity       = static_cast<const float*>(sections[Opacity]);
+    view_.scale         = static_cast<const float*>(sections[Scale]);
+    view_.rotation      = static_cast<const float*>(sections[Rotation]);
+    valid_              = true;
+}
+
+LodScene::~LodScene() = default;
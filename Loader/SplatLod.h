@@ -0,0 +1,92 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include "SplatSet.h"
+
+class MappedFile;
+
+// Level-of-detail hierarchy of merged Gaussians (.gsl), in the spirit of
+// hierarchical 3DGS.
+//
+// The splats are expected in Morton order (reorderMorton), so every run of
+// `branching` consecutive rows is a compact region of space. Runs of leaves are
+// grouped into level 1 nodes, runs of level 1 nodes into level 2 nodes, and so on
+// up to a single root. Every inner node holds one Gaussian merged from its
+// children by moment matching (weighted mean and covariance, weights =
+// opacity × projected area), with colors and SH averaged by the same weights and
+// opacity chosen so the merged splat covers the same area as its children.
+//
+// The merged Gaussians are appended to the splat rows: row r < leafCount is an
+// original splat, row leafCount + k is inner node k. Nodes are stored level by
+// level from level 1 up, so the root is the last node. A renderer picks a cut
+// through the tree (LodCut) and projects only the rows of that cut.
+//
+// Usage:
+//   SplatSet splats;
+//   loadSplatScene("scene.ply", splats);
+//   reorderMorton(splats);
+//   std::vector<LodNode> nodes;
+//   const size_t leafCount = splats.size();
+//   buildLodHierarchy(splats, nodes);               // splats now holds leaves + inner nodes
+//   writeLodScene(lodScenePath("scene.ply"), splats, leafCount, nodes, "scene.ply");
+//
+//   LodScene scene(lodScenePath("scene.ply"), "scene.ply");
+//   upload(scene.view());                           // leafCount() + nodeCount() rows
+
+struct LodNode
+{
+    float    center[3];  // bounding sphere of every leaf below (3 sigma extents)
+    float    radius;
+    uint32_t firstChild; // row of the first child: a leaf row for level 1, else leafCount + node index
+    uint16_t childCount;
+    uint16_t level;      // 1 = children are leaves
+};
+
+struct LodOptions
+{
+    uint32_t branching   = 8; // children per inner node (2-65535)
+    uint32_t threadCount = 0; // 0 = hardware concurrency
+};
+
+// Appends one merged row per inner node to `splats` and fills `nodes`. Rows past
+// the 32-bit range are rejected, since node links are 32-bit rows.
+bool buildLodHierarchy(SplatSet& splats, std::vector<LodNode>& nodes, const LodOptions& options = {});
+
+// LOD scene location for a source file: same directory, ".gsl" extension.
+std::filesystem::path lodScenePath(const std::filesystem::path& sourcePath);
+
+bool isLodScene(const std::filesystem::path& path);
+
+// Writes leaves + inner node rows of `splats` and the node table. `sourcePath` is
+// recorded so stale files are rejected after the source changes (empty = none).
+bool writeLodScene(const std::filesystem::path& path, const SplatSet& splats, size_t leafCount,
+                   const std::vector<LodNode>& nodes, const std::filesystem::path& sourcePath);
+
+class LodScene
+{
+public:
+    // Maps `path` read-only; invalid if missing, corrupt or stale against `sourcePath`.
+    LodScene(const std::filesystem::path& path, const std::filesystem::path& sourcePath);
+    ~LodScene();
+
+    LodScene(const LodScene&)            = delete;
+    LodScene& operator=(const LodScene&) = delete;
+
+    bool valid() const { return valid_; }
+
+    // All rows (leaves, then one per node); pointers into the mapping.
+    const SplatView& view() const { return view_; }
+    size_t           leafCount() const { return leafCount_; }
+
+    const LodNode* nodes() const { return nodes_; }
+    size_t         nodeCount() const { return nodeCount_; }
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    SplatView                   view_;
+    const LodNode*              nodes_     = nullptr;
+    size_t                      nodeCount_ = 0;
+    size_t                      leafCount_ = 0;
+    bool                        valid_     = false;
+};
@@ -0,0 +1,248 @@
+#include "SplatPrune.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+
+constexpr size_t kBlockRows        = 16 * 1024;
+constexpr size_t kMinBlocksPerTask = 4;
+
+// Removal reason per splat; 0 = kept. Lower values win (rules are applied last to first).
+constexpr uint8_t Kept         = 0;
+constexpr uint8_t NonFinite    = 1;
+constexpr uint8_t ZeroRotation = 2;
+constexpr uint8_t LowOpacity   = 3;
+constexpr uint8_t Oversized    = 4;
+constexpr uint8_t OutOfBounds  = 5;
+constexpr uint8_t ReasonCount  = 6;
+
+// Exponent bits all set: Inf or NaN. Integer compare so the loops vectorize.
+inline bool nonFinite(float value)
+{
+    return (std::bit_cast<uint32_t>(value) & 0x7f800000u) == 0x7f800000u;
+}
+
+struct BlockResult
+{
+    size_t counts[ReasonCount] = {};
+    size_t zeroedShRest        = 0;
+};
+
+struct Thresholds
+{
+    bool  opacity = false;
+    float minLogit = 0.0f;
+    bool  scale = false;
+    float maxLogScale = 0.0f;
+    bool  bounds = false;
+    float center[3] = {};
+    float maxDistanceSq = 0.0f;
+};
+
+// Selects the reason for every row of [first, last); each rule is one pass over
+// contiguous arrays with a select, applied from lowest to highest priority.
+void classifyBlock(const SplatSet& splats, const Thresholds& t, size_t first, size_t last, uint8_t* reason)
+{
+    const float* p  = splats.positions.data();
+    const float* dc = splats.f_dc.data();
+    const float* o  = splats.opacity.data();
+    const float* s  = splats.scale.data();
+    const float* q  = splats.rotation.data();
+
+    for (size_t r = first; r < last; ++r)
+        reason[r] = Kept;
+
+    if (t.bounds)
+    {
+        for (size_t r = first; r < last; ++r)
+        {
+            const float dx = p[r * 3] - t.center[0], dy = p[r * 3 + 1] - t.center[1], dz = p[r * 3 + 2] - t.center[2];
+            reason[r] = dx * dx + dy * dy + dz * dz > t.maxDistanceSq ? OutOfBounds : reason[r];
+        }
+    }
+    if (t.scale)
+    {
+        for (size_t r = first; r < last; ++r)
+        {
+            const float largest = std::max(s[r * 3], std::max(s[r * 3 + 1], s[r * 3 + 2]));
+            reason[r] = largest > t.maxLogScale ? Oversized : reason[r];
+        }
+    }
+    if (t.opacity)
+    {
+        for (size_t r = first; r < last; ++r)
+            reason[r] = o[r] < t.minLogit ? LowOpacity : reason[r];
+    }
+    for (size_t r = first; r < last; ++r)
+    {
+        const float normSq = q[r * 4] * q[r * 4] + q[r * 4 + 1] * q[r * 4 + 1] + q[r * 4 + 2] * q[r * 4 + 2] +
+                             q[r * 4 + 3] * q[r * 4 + 3];
+        reason[r] = normSq < 1e-12f ? ZeroRotation : reason[r];
+    }
+    for (size_t r = first; r < last; ++r)
+    {
+        bool bad = nonFinite(o[r]);
+        for (int i = 0; i < 3; ++i)
+            bad |= nonFinite(p[r * 3 + i]) | nonFinite(dc[r * 3 + i]) | nonFinite(s[r * 3 + i]);
+        for (int i = 0; i < 4; ++i)
+            bad |= nonFinite(q[r * 4 + i]);
+        reason[r] = bad ? NonFinite : reason[r];
+    }
+}
+
+// Per-axis median of the finite positions (robust to the floaters being removed).
+void medianPosition(const SplatSet& splats, float* center)
+{
+    const size_t       count = splats.size();
+    std::vector<float> axis;
+    axis.reserve(count);
+    for (int i = 0; i < 3; ++i)
+    {
+        axis.clear();
+        for (size_t r = 0; r < count; ++r)
+        {
+            const float v = splats.positions[r * 3 + i];
+            if (!nonFinite(v))
+                axis.push_back(v);
+        }
+        if (axis.empty())
+        {
+            center[i] = 0.0f;
+            continue;
+        }
+        std::nth_element(axis.begin(), axis.begin() + axis.size() / 2, axis.end());
+        center[i] = axis[axis.size() / 2];
+    }
+}
+
+} // namespace
+
+std::vector<uint32_t> pruneSplats(SplatSet& splats, const PruneOptions& options, PruneStats& stats)
+{
+    const size_t count = splats.size();
+    stats       = {};
+    stats.input = count;
+    if (count == 0 || splats.f_dc.size() != count * 3 || splats.opacity.size() != count ||
+        splats.scale.size() != count * 3 || splats.rotation.size() != count * 4)
+    {
+        std::cerr << "Error: pruning needs positions, f_dc, opacity, scale and rotation" << std::endl;
+        std::vector<uint32_t> all(count);
+        for (size_t r = 0; r < count; ++r)
+            all[r] = static_cast<uint32_t>(r);
+        return all;
+    }
+
+    // Thresholds in the stored domain: logit(minOpacity), log(maxScale).
+    Thresholds t;
+    if (options.minOpacity > 0.0f && options.minOpacity < 1.0f)
+    {
+        t.opacity  = true;
+        t.minLogit = -std::log(1.0f / options.minOpacity - 1.0f);
+    }
+    if (options.maxScale > 0.0f)
+    {
+        t.scale       = true;
+        t.maxLogScale = std::log(options.maxScale);
+    }
+    if (options.maxDistance > 0.0f)
+    {
+        t.bounds        = true;
+        t.maxDistanceSq = options.maxDistance * options.maxDistance;
+        medianPosition(splats, t.center);
+    }
+
+    const size_t             blocks = (count + kBlockRows - 1) / kBlockRows;
+    std::vector<uint8_t>     reason(count);
+    std::vector<BlockResult> results(blocks);
+    parallelFor(blocks, options.threadCount, kMinBlocksPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t b = begin; b < end; ++b)
+        {
+            const size_t first = b * kBlockRows;
+            const size_t last  = std::min(count, first + kBlockRows);
+            classifyBlock(splats, t, first, last, reason.data());
+            for (size_t r = first; r < last; ++r)
+                ++results[b].counts[reason[r]];
+        }
+    });
+
+    // Exclusive scan of kept rows per block → output offsets.
+    std::vector<size_t> offsets(blocks + 1, 0);
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        offsets[b + 1] = offsets[b] + results[b].counts[Kept];
+        stats.nonFinite += results[b].counts[NonFinite];
+        stats.zeroRotation += results[b].counts[ZeroRotation];
+        stats.lowOpacity += results[b].counts[LowOpacity];
+        stats.oversized += results[b].counts[Oversized];
+        stats.outOfBounds += results[b].counts[OutOfBounds];
+    }
+    const size_t kept = offsets[blocks];
+
+    SplatSet              out;
+    std::vector<uint32_t> keptRows(kept);
+    const size_t          restWidth = splats.f_rest.size() / count;
+    out.positions.resize(kept * 3);
+    out.f_dc.resize(kept * 3);
+    out.f_rest.resize(kept * restWidth);
+    out.opacity.resize(kept);
+    out.scale.resize(kept * 3);
+    out.rotation.resize(kept * 4);
+
+    parallelFor(blocks, options.threadCount, kMinBlocksPerTask, [&](size_t begin, size_t end)
+    {
+        for (size_t b = begin; b < end; ++b)
+        {
+            size_t       dst  = offsets[b];
+            const size_t last = std::min(count, (b + 1) * kBlockRows);
+            for (size_t r = b * kBlockRows; r < last; ++r)
+            {
+                if (reason[r] != Kept)
+                    continue;
+                keptRows[dst] = static_cast<uint32_t>(r);
+                std::memcpy(&out.positions[dst * 3], &splats.positions[r * 3], 3 * sizeof(float));
+                std::memcpy(&out.f_dc[dst * 3], &splats.f_dc[r * 3], 3 * sizeof(float));
+                std::memcpy(&out.scale[dst * 3], &splats.scale[r * 3], 3 * sizeof(float));
+                out.opacity[dst] = splats.opacity[r];
+
+                const float* q     = &splats.rotation[r * 4];
+                const float  scale = options.normalizeRotations
+                                         ? 1.0f / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3])
+                                         : 1.0f;
+                for (int i = 0; i < 4; ++i)
+                    out.rotation[dst * 4 + i] = q[i] * scale;
+
+                for (size_t i = 0; i < restWidth; ++i)
+                {
+                    const float v = splats.f_rest[r * restWidth + i];
+                    const bool  bad = nonFinite(v);
+                    results[b].zeroedShRest += bad;
+                    out.f_rest[dst * restWidth + i] = bad ? 0.0f : v;
+                }
+                ++dst;
+            }
+        }
+    });
+    for (const BlockResult& result : results)
+        stats.zeroedShRest += result.zeroedShRest;
+
+    splats = std::move(out);
+    return keptRows;
+}
+
+void printPruneStats(const PruneStats& stats)
+{
+    std::cout << "Pruned " << stats.removed() << " of " << stats.input << " splats (" << stats.kept() << " kept): "
+              << stats.nonFinite << " non-finite, " << stats.zeroRotation << " zero rotation, "
+              << stats.lowOpacity << " low opacity, " << stats.oversized << " oversized, "
+              << stats.outOfBounds << " out of bounds";
+    if (stats.zeroedShRest > 0)
+        std::cout << "; " << stats.zeroedShRest << " non-finite SH coefficients zeroed";
+    std::cout << std::endl;
+}
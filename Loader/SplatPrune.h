@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+#include "SplatSet.h"
+
+// Load-time sanitize-and-prune pass for degenerate splats, run between loading and
+// upload so they never reach the GPU buffers.
+//
+// A splat is removed by the first rule it fails, in this order:
+//   nonFinite     NaN / Inf in position, f_dc, opacity, scale or rotation
+//   zeroRotation  quaternion with (near-)zero norm
+//   lowOpacity    sigmoid(opacity) < minOpacity
+//   oversized     largest axis exp(scale) > maxScale (floaters)
+//   outOfBounds   farther than maxDistance from the per-axis median position
+// Kept splats are sanitized: quaternions are normalized and non-finite f_rest
+// coefficients are zeroed. The rules run as branch-free select loops over the SOA
+// arrays (auto-vectorized) on blocks split across worker threads, and the kept rows
+// are compacted in parallel from a prefix sum of the per-block counts.
+//
+// Usage:
+//   PruneStats stats;
+//   std::vector<uint32_t> keptRows = pruneSplats(splats, {}, stats);
+//   printPruneStats(stats);
+
+struct PruneOptions
+{
+    float    minOpacity  = 1.0f / 255.0f; // after sigmoid; 0 = off
+    float    maxScale    = 0.0f;          // world units, largest axis; 0 = off
+    float    maxDistance = 0.0f;          // world units from the median position; 0 = off
+    bool     normalizeRotations = true;
+    uint32_t threadCount = 0;             // 0 = hardware concurrency
+};
+
+struct PruneStats
+{
+    size_t input         = 0;
+    size_t nonFinite     = 0;
+    size_t zeroRotation  = 0;
+    size_t lowOpacity    = 0;
+    size_t oversized     = 0;
+    size_t outOfBounds   = 0;
+    size_t zeroedShRest  = 0; // non-finite f_rest coefficients replaced by 0 in kept splats
+
+    size_t removed() const { return nonFinite + zeroRotation + lowOpacity + oversized + outOfBounds; }
+    size_t kept() const { return input - removed(); }
+};
+
+// Compacts `splats` in place and returns the source row of every kept splat
+// (ascending), so data that is re-read from the file later can be matched up.
+// Positions, f_dc, opacity, scale and rotation must be present.
+std::vector<uint32_t> pruneSplats(SplatSet& splats, const PruneOptions& options, PruneStats& stats);
+
+void printPruneStats(const PruneStats& stats);
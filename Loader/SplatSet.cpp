@@ -0,0 +1,58 @@
+#include "SplatSet.h"
+#include "SignFlip.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+void SplatSet::truncateShDegree(int32_t degree)
+{
+    const size_t numPoints = size();
+    if (numPoints == 0 || f_rest.empty())
+        return;
+
+    const size_t oldCoeffs = f_rest.size() / numPoints / 3;
+    const size_t newCoeffs = std::min<size_t>(oldCoeffs, kShCoeffsPerChannel[std::clamp(degree, 0, 3)]);
+    if (newCoeffs == oldCoeffs)
+        return;
+
+    // Compacts in place: every destination index is at or below its source index.
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        for (size_t c = 0; c < 3; ++c)
+        {
+            const float* src = f_rest.data() + (i * 3 + c) * oldCoeffs;
+            float*       dst = f_rest.data() + (i * 3 + c) * newCoeffs;
+            std::memmove(dst, src, newCoeffs * sizeof(float));
+        }
+    }
+    f_rest.resize(numPoints * 3 * newCoeffs);
+    f_rest.shrink_to_fit();
+}
+
+void SplatSet::convertRdfToRub(uint32_t threadCount)
+{
+    const SimdLevel level = detectSimdLevel();
+
+    const uint32_t positionMask[3] = {0u, kSignBit, kSignBit};          // y, z
+    const uint32_t rotationMask[4] = {0u, 0u, kSignBit, kSignBit};      // qy, qz (w first)
+    xorRowSignMask(positions.data(), positions.size() / 3, 3, positionMask, threadCount, level);
+    xorRowSignMask(rotation.data(), rotation.size() / 4, 4, rotationMask, threadCount, level);
+
+    // f_rest rows are channel-major (R coeffs, G coeffs, B coeffs); every channel
+    // gets the same per-coefficient signs from kRdfToRubShFlip.
+    const size_t numPoints = size();
+    if (numPoints == 0 || f_rest.empty())
+        return;
+
+    const size_t rowFloats         = f_rest.size() / numPoints;
+    const size_t numCoeffsPerPoint = rowFloats / 3;
+
+    std::array<uint32_t, 45> shMask{};
+    for (size_t c = 0; c < 3; ++c)
+    {
+        for (size_t j = 0; j < numCoeffsPerPoint && j < 15; ++j)
+            shMask[c * numCoeffsPerPoint + j] = kRdfToRubShFlip[j] < 0.0f ? kSignBit : 0u;
+    }
+    xorRowSignMask(f_rest.data(), numPoints, rowFloats, shMask.data(), threadCount, level);
+}
@@ -4,6 +4,40 @@
 #include <cstdint>
 #include <cstddef>
 
+// Per-coefficient sign of the degree 1-3 SH bands under the RDF → RUB axis flip.
+// Derived from spz::coordinateConverter(RDF, RUB) where x=1, y=-1, z=-1:
+//   [0]=y, [1]=z, [2]=x, [3]=xy, [4]=yz, [5]=1, [6]=xz, [7]=1,
+//   [8]=y, [9]=xyz, [10]=y, [11]=z, [12]=x, [13]=z, [14]=x
+inline constexpr float kRdfToRubShFlip[15] = {
+    -1.0f, -1.0f,  1.0f,                              // degree 1: y, z, x
+    -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,                // degree 2: xy, yz, 1, xz, 1
+    -1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f   // degree 3: y, xyz, y, z, x, z, x
+};
+
+// f_rest coefficients per color channel for SH degree 0..3: (degree + 1)^2 - 1.
+inline constexpr uint32_t kShCoeffsPerChannel[4] = {0, 3, 8, 15};
+
+// f_rest floats per splat left after truncating `fRestPerSplat` to `degree`.
+inline size_t shRestFloatsForDegree(size_t fRestPerSplat, int32_t degree)
+{
+    const size_t keep = kShCoeffsPerChannel[degree < 0 ? 0 : degree > 3 ? 3 : degree];
+    return 3 * (fRestPerSplat / 3 < keep ? fRestPerSplat / 3 : keep);
+}
+
+// Non-owning view of SOA splat arrays, laid out like SplatSet.
+// Lets upload code consume a SplatSet and a mapped cache file the same way.
+struct SplatView
+{
+    size_t       count         = 0;
+    size_t       fRestPerSplat = 0; // 0, 9, 24 or 45
+    const float* positions     = nullptr;
+    const float* f_dc          = nullptr;
+    const float* f_rest        = nullptr;
+    const float* opacity       = nullptr;
+    const float* scale         = nullptr;
+    const float* rotation      = nullptr;
+};
+
 // Storage for a 3D Gaussian Splatting model loaded from PLY file.
 // Based on the INRIA 3DGS format.
 struct SplatSet
@@ -17,6 +51,14 @@ struct SplatSet
 
     size_t size() const { return positions.size() / 3; }
 
+    SplatView view() const
+    {
+        const size_t count = size();
+        return {count, count ? f_rest.size() / count : 0,
+                positions.data(), f_dc.data(), f_rest.data(),
+                opacity.data(), scale.data(), rotation.data()};
+    }
+
     // Returns max SH degree (0-3), or -1 if empty
     int32_t maxShDegree() const
     {
@@ -31,10 +73,18 @@ struct SplatSet
         return 0;
     }
 
+    // Drops SH bands above `degree` (0-3) from f_rest, keeping the channel-major layout.
+    void truncateShDegree(int32_t degree);
+
     // Convert from RDF (Right-Down-Forward) to RUB (Right-Up-Back) coordinate system.
     // PLY files from INRIA 3DGS training use RDF; Vulkan typically uses RUB.
     // Flips Y and Z axes for positions, quaternion components, and SH coefficients.
-    void convertRdfToRub()
+    // Applied as sign-bit XOR masks over whole rows with the widest SIMD kernel the
+    // CPU supports, split across `threadCount` workers (0 = hardware concurrency).
+    void convertRdfToRub(uint32_t threadCount = 0);
+
+    // Scalar reference for convertRdfToRub, kept for verification and benchmarks.
+    void convertRdfToRubScalar()
     {
         // Flip Y and Z for positions
         for (size_t i = 0; i < positions.size(); i += 3)
@@ -50,16 +100,7 @@ struct SplatSet
             rotation[i + 3] = -rotation[i + 3]; // flip qZ
         }
 
-        // Flip SH coefficients referencing Y and Z axes.
-        // Derived from spz::coordinateConverter(RDF, RUB) where x=1, y=-1, z=-1:
-        //   [0]=y, [1]=z, [2]=x, [3]=xy, [4]=yz, [5]=1, [6]=xz, [7]=1,
-        //   [8]=y, [9]=xyz, [10]=y, [11]=z, [12]=x, [13]=z, [14]=x
-        static constexpr float shFlip[15] = {
-            -1.0f, -1.0f,  1.0f,                          // degree 1: y, z, x
-            -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,            // degree 2: xy, yz, 1, xz, 1
-            -1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f  // degree 3: y, xyz, y, z, x, z, x
-        };
-
+        // Flip SH coefficients referencing Y and Z axes (see kRdfToRubShFlip).
         const size_t numPoints = size();
         if (numPoints == 0 || f_rest.empty()) return;
 
@@ -71,7 +112,7 @@ struct SplatSet
         {
             for (size_t j = 0; j < numCoeffsPerPoint && j < 15; ++j)
             {
-                const float flip = shFlip[j];
+                const float flip = kRdfToRubShFlip[j];
                 f_rest[idx + j]                          *= flip; // R
                 f_rest[idx + numCoeffsPerPoint + j]      *= flip; // G
                 f_rest[idx + numCoeffsPerPoint * 2 + j]  *= flip; // B
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+//
+// The producer only writes `tail_` and the consumer only writes `head_`, so each
+// side needs a single acquire load of the other's index and a release store of
+// its own. The indices live on separate cache lines to avoid false sharing.
+//
+// Usage:
+//   SpscQueue<Item> queue(256);
+//   queue.tryPush(item);      // producer thread; false when full
+//   Item out;
+//   while (queue.tryPop(out)) // consumer thread; false when empty
+//       ...
+template <class T>
+class SpscQueue
+{
+public:
+    // One slot is kept free to tell "full" from "empty", so `capacity` items fit.
+    explicit SpscQueue(size_t capacity)
+        : size_(capacity + 1), slots_(std::make_unique<T[]>(capacity + 1))
+    {
+    }
+
+    SpscQueue(const SpscQueue&)            = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    bool tryPush(T item)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t next = tail + 1 == size_ ? 0 : tail + 1;
+        if (next == head_.load(std::memory_order_acquire))
+            return false;
+
+        slots_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item)
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        item = std::move(slots_[head]);
+        head_.store(head + 1 == size_ ? 0 : head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called from a third thread; exact from either endpoint.
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    const size_t         size_;
+    std::unique_ptr<T[]> slots_;
+
+    alignas(kCacheLine) std::atomic<size_t> head_{0}; // next slot to pop (consumer-owned)
+    alignas(kCacheLine) std::atomic<size_t> tail_{0}; // next slot to push (producer-owned)
+};
@@ -0,0 +1,20 @@
+// ─── Gaussian이 덮는 tile 사각형 (proj.comp / bin.comp 공용) ───
+// proj.comp가 센 tileCount와 bin.comp가 기록하는 키 수가 항상 같도록 한 식만 씀.
+// 화면 좌표는 음수일 수 있으므로 (중심은 NDC ±1.3까지, 반지름은 더 바깥) float에서 floor + clamp한 뒤
+// 범위 안 값만 uint로 변환 (음수 float → uint 변환은 정의되지 않음)
+
+// [tileMin, tileMax] (양 끝 포함). 사각형이 tile 격자와 전혀 겹치지 않으면 (NaN 포함) false
+bool tileRect(vec2 mean2D, float radius, uint tileWidth, uint tileHeight,
+              out uvec2 tileMin, out uvec2 tileMax) {
+    vec2 lo = floor((mean2D - radius) / float(TILE_SIZE));
+    vec2 hi = floor((mean2D + radius) / float(TILE_SIZE));
+    vec2 last = vec2(tileWidth - 1u, tileHeight - 1u);
+    tileMin = uvec2(0u);
+    tileMax = uvec2(0u);
+    if (!(all(greaterThanEqual(hi, vec2(0.0))) && all(lessThanEqual(lo, last)))) {
+        return false;
+    }
+    tileMin = uvec2(clamp(lo, vec2(0.0), last));
+    tileMax = uvec2(clamp(hi, vec2(0.0), last));
+    return true;
+}
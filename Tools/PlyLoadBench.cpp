@@ -0,0 +1,216 @@
+// Load-time benchmark for loadPly.
+//
+// Compares miniply's buffered reader (one element copy plus one extract_properties
+// sweep per attribute group) against the mapped single-pass row scatter, and
+// reports the effective bandwidth over the vertex payload. Also times the
+// RDF → RUB conversion of the buffered path (scalar reference vs SIMD kernels)
+// and checks that both produce identical bits, and does the same for the fp16
+// packing of the attributes stored as halves on the GPU. Finally times the Morton
+// reorder and reports how far each 256-splat projection workgroup spreads in space
+// before and after it (the viewer's --timings flag measures the GPU side).
+//
+// Usage:
+//   PlyLoadBench scene.ply [iterations] [threads]
+
+#include "HalfFloat.h"
+#include "MortonOrder.h"
+#include "PlyLoader.h"
+#include "SignFlip.h"
+#include "miniply.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+struct BenchResult
+{
+    double bestMs = 0.0;
+    size_t splats = 0;
+};
+
+BenchResult run(const char* filename, const PlyLoadOptions& options, int iterations)
+{
+    BenchResult result;
+    result.bestMs = 1e30;
+    for (int i = 0; i < iterations; ++i)
+    {
+        SplatSet splats;
+        auto     start = std::chrono::high_resolution_clock::now();
+        if (!loadPly(filename, splats, options))
+        {
+            std::fprintf(stderr, "Failed to load %s\n", filename);
+            std::exit(EXIT_FAILURE);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        result.bestMs = std::min(result.bestMs, std::chrono::duration<double, std::milli>(end - start).count());
+        result.splats = splats.size();
+    }
+    return result;
+}
+
+void report(const char* label, const BenchResult& result, double payloadBytes, double passes)
+{
+    const double seconds = result.bestMs * 1e-3;
+    std::printf("%-22s %10.1f ms  %8.2f GB/s payload  %8.2f GB streamed (%.0f passes)\n",
+                label, result.bestMs, payloadBytes / seconds * 1e-9, payloadBytes * passes * 1e-9, passes);
+}
+
+template <class Fn>
+double bestOf(int iterations, const SplatSet& source, SplatSet& result, Fn&& convert)
+{
+    double bestMs = 1e30;
+    for (int i = 0; i < iterations; ++i)
+    {
+        result    = source;
+        auto start = std::chrono::high_resolution_clock::now();
+        convert(result);
+        auto end = std::chrono::high_resolution_clock::now();
+        bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return bestMs;
+}
+
+bool sameBits(const std::vector<float>& a, const std::vector<float>& b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+bool sameBits(const SplatSet& a, const SplatSet& b)
+{
+    return sameBits(a.positions, b.positions) && sameBits(a.rotation, b.rotation) && sameBits(a.f_rest, b.f_rest);
+}
+
+// Mean bounding-box diagonal of each run of `groupSize` rows, relative to the whole
+// scene's: how much of the scene one projection workgroup touches.
+double meanGroupSpread(const std::vector<float>& positions, size_t groupSize)
+{
+    auto diagonal = [&](size_t first, size_t last)
+    {
+        float minValue[3] = {INFINITY, INFINITY, INFINITY}, maxValue[3] = {-INFINITY, -INFINITY, -INFINITY};
+        for (size_t r = first; r < last; ++r)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                minValue[i] = std::min(minValue[i], positions[r * 3 + i]);
+                maxValue[i] = std::max(maxValue[i], positions[r * 3 + i]);
+            }
+        }
+        double sum = 0.0;
+        for (int i = 0; i < 3; ++i)
+            sum += static_cast<double>(maxValue[i] - minValue[i]) * (maxValue[i] - minValue[i]);
+        return std::sqrt(sum);
+    };
+
+    const size_t count  = positions.size() / 3;
+    const double scene  = diagonal(0, count);
+    double       total  = 0.0;
+    size_t       groups = 0;
+    for (size_t first = 0; first < count; first += groupSize, ++groups)
+        total += diagonal(first, std::min(count, first + groupSize));
+    return groups > 0 && scene > 0.0 ? total / groups / scene : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s scene.ply [iterations] [threads]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char*    filename   = argv[1];
+    const int      iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    const uint32_t threads    = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 0;
+
+    miniply::PLYReader reader(filename);
+    const uint32_t     vertexIdx = reader.valid() ? reader.find_element(miniply::kPLYVertexElement)
+                                                  : miniply::kInvalidIndex;
+    if (vertexIdx == miniply::kInvalidIndex)
+    {
+        std::fprintf(stderr, "No vertex element in %s\n", filename);
+        return EXIT_FAILURE;
+    }
+    const miniply::PLYElement& vertex = *reader.get_element(vertexIdx);
+    const double payloadBytes = static_cast<double>(vertex.count) * vertex.rowStride;
+
+    std::printf("%u splats, %u-byte rows, %.1f MB payload, best of %d\n",
+                vertex.count, vertex.rowStride, payloadBytes * 1e-6, iterations);
+
+    auto options = [](bool allowMapping, uint32_t threadCount)
+    {
+        PlyLoadOptions options;
+        options.allowMapping = allowMapping;
+        options.threadCount  = threadCount;
+        return options;
+    };
+
+    // Buffered: fread into miniply's element buffer, then six extract_properties sweeps.
+    report("buffered (6 sweeps)", run(filename, options(false, 0), iterations), payloadBytes, 7.0);
+    report("mapped fused, 1 thread", run(filename, options(true, 1), iterations), payloadBytes, 1.0);
+    report("mapped fused, N threads", run(filename, options(true, threads), iterations), payloadBytes, 1.0);
+
+    // RDF → RUB on an unconverted set (the buffered path's post-pass).
+    PlyLoadOptions rawOptions = options(true, threads);
+    rawOptions.convertToRub   = false;
+    SplatSet raw;
+    if (!loadPly(filename, raw, rawOptions))
+        return EXIT_FAILURE;
+
+    SplatSet reference, converted;
+    const double scalarMs = bestOf(iterations, raw, reference, [](SplatSet& s) { s.convertRdfToRubScalar(); });
+    const double simd1Ms  = bestOf(iterations, raw, converted, [](SplatSet& s) { s.convertRdfToRub(1); });
+    const bool   match1   = sameBits(reference, converted);
+    const double simdNMs  = bestOf(iterations, raw, converted, [&](SplatSet& s) { s.convertRdfToRub(threads); });
+    const bool   matchN   = sameBits(reference, converted);
+
+    std::printf("convertRdfToRub: scalar %.1f ms, %s 1 thread %.1f ms%s, N threads %.1f ms%s\n",
+                scalarMs, simdLevelName(detectSimdLevel()), simd1Ms, match1 ? "" : " (MISMATCH)",
+                simdNMs, matchN ? "" : " (MISMATCH)");
+
+    // fp16 packing of f_dc, opacity, scale and rotation (positions stay fp32).
+    std::vector<float> halfSource;
+    for (const auto* attribute : {&raw.f_dc, &raw.opacity, &raw.scale, &raw.rotation})
+        halfSource.insert(halfSource.end(), attribute->begin(), attribute->end());
+    std::vector<uint16_t> halfReference(halfSource.size()), halves(halfSource.size());
+
+    auto timePack = [&](std::vector<uint16_t>& dst, uint32_t threadCount, SimdLevel level)
+    {
+        double bestMs = 1e30;
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            packHalf(halfSource.data(), dst.data(), halfSource.size(), threadCount, level);
+            auto end = std::chrono::high_resolution_clock::now();
+            bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return bestMs;
+    };
+    const double halfScalarMs = timePack(halfReference, 1, SimdLevel::Scalar);
+    const double halfSimdMs   = timePack(halves, threads, detectSimdLevel());
+    const bool   halfMatch    = halves == halfReference;
+
+    std::printf("packHalf: scalar %.1f ms, %s N threads %.1f ms%s, %.1f MB -> %.1f MB\n",
+                halfScalarMs, simdLevelName(detectSimdLevel()), halfSimdMs, halfMatch ? "" : " (MISMATCH)",
+                halfSource.size() * sizeof(float) * 1e-6, halfSource.size() * sizeof(uint16_t) * 1e-6);
+
+    // Morton reorder (code + sort + gather of every array) on the converted set.
+    for (MortonPrecision precision : {MortonPrecision::Bits30, MortonPrecision::Bits63})
+    {
+        SplatSet     ordered;
+        const double mortonMs = bestOf(iterations, converted, ordered,
+                                       [&](SplatSet& s) { reorderMorton(s, precision, threads); });
+        std::printf("reorderMorton %s: %.1f ms, 256-splat workgroup spread %.4f -> %.4f of the scene\n",
+                    precision == MortonPrecision::Bits30 ? "30-bit" : "63-bit", mortonMs,
+                    meanGroupSpread(converted.positions, 256), meanGroupSpread(ordered.positions, 256));
+    }
+
+    return match1 && matchN && halfMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,148 @@
+// Writes the .gsbin splat cache for a PLY without starting the viewer.
+// Inputs may also be PlayCanvas compressed.ply or antimatter15 .splat files.
+//
+// Usage:
+//   SplatCacheTool scene.ply [scene.gsbin]   convert (default output next to the PLY)
+//   SplatCacheTool --verify scene.gsbin       check header and payload checksums
+//   SplatCacheTool --quantize scene.ply [scene.gsq]   write the chunk-quantized form
+//                                                     (Morton-ordered first, so chunk bounds are tight)
+//   SplatCacheTool --chunk scene.ply [scene.gsc]      write the streamable chunked scene
+//   SplatCacheTool --lod scene.ply [scene.gsl]        write the LOD hierarchy of merged Gaussians
+
+#include "PlyLoader.h"
+#include "SplatCache.h"
+#include "QuantizedSplats.h"
+#include "SplatFormats.h"
+#include "MortonOrder.h"
+#include "ChunkedScene.h"
+#include "SplatLod.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "Usage: %s scene.ply [scene.gsbin]\n"
+                             "       %s --verify scene.gsbin\n"
+                             "       %s --quantize scene.ply [scene.gsq]\n"
+                             "       %s --chunk scene.ply [scene.gsc]\n"
+                             "       %s --lod scene.ply [scene.gsl]\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (std::strcmp(argv[1], "--verify") == 0)
+    {
+        if (argc < 3)
+        {
+            std::fprintf(stderr, "--verify needs a cache file\n");
+            return EXIT_FAILURE;
+        }
+        SplatCache cache(argv[2], {});
+        if (!cache.valid() || !cache.verifyPayload())
+        {
+            std::fprintf(stderr, "%s: checksum mismatch or invalid cache\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        std::printf("%s: OK, %zu splats, SH degree %d\n", argv[2], cache.size(), cache.maxShDegree());
+        return EXIT_SUCCESS;
+    }
+
+    if (std::strcmp(argv[1], "--quantize") == 0)
+    {
+        if (argc < 3)
+        {
+            std::fprintf(stderr, "--quantize needs a PLY file\n");
+            return EXIT_FAILURE;
+        }
+        const std::filesystem::path plyPath = argv[2];
+        const std::filesystem::path outPath = argc > 3 ? std::filesystem::path(argv[3]) : quantizedSplatPath(plyPath);
+
+        // compressed.ply is already chunk-quantized, so it is transcoded without a float round trip.
+        SplatSet splats;
+        QuantizedSplatSet quantized;
+        if (isCompressedPly(plyPath))
+        {
+            if (!loadCompressedPly(plyPath, quantized))
+                return EXIT_FAILURE;
+        }
+        else
+        {
+            if (!loadSplatScene(plyPath, splats))
+                return EXIT_FAILURE;
+            reorderMorton(splats);
+            if (!quantizeSplats(splats.view(), quantized))
+                return EXIT_FAILURE;
+        }
+        if (!writeQuantizedSplats(outPath, quantized))
+            return EXIT_FAILURE;
+
+        // fp32 SOA: position 3 + f_dc 3 + opacity 1 + scale 3 + rotation 4 floats, plus f_rest
+        const size_t floatBytes = quantized.size() * (14 + quantized.fRestPerSplat) * sizeof(float);
+        std::printf("Wrote %s (%zu splats, %.1f MB -> %.1f MB)\n", outPath.string().c_str(), quantized.size(),
+                    floatBytes / 1e6, quantized.byteSize() / 1e6);
+        return EXIT_SUCCESS;
+    }
+
+    if (std::strcmp(argv[1], "--chunk") == 0)
+    {
+        if (argc < 3)
+        {
+            std::fprintf(stderr, "--chunk needs a PLY file\n");
+            return EXIT_FAILURE;
+        }
+        const std::filesystem::path plyPath = argv[2];
+        const std::filesystem::path outPath = argc > 3 ? std::filesystem::path(argv[3]) : chunkedScenePath(plyPath);
+
+        SplatSet splats;
+        if (!loadSplatScene(plyPath, splats))
+            return EXIT_FAILURE;
+        reorderMorton(splats);
+        if (!writeChunkedScene(outPath, splats, plyPath))
+            return EXIT_FAILURE;
+
+        const size_t chunks = (splats.size() + kDefaultSceneChunkRows - 1) / kDefaultSceneChunkRows;
+        std::printf("Wrote %s (%zu splats in %zu chunks of %zu)\n", outPath.string().c_str(), splats.size(), chunks,
+                    kDefaultSceneChunkRows);
+        return EXIT_SUCCESS;
+    }
+
+    if (std::strcmp(argv[1], "--lod") == 0)
+    {
+        if (argc < 3)
+        {
+            std::fprintf(stderr, "--lod needs a PLY file\n");
+            return EXIT_FAILURE;
+        }
+        const std::filesystem::path plyPath = argv[2];
+        const std::filesystem::path outPath = argc > 3 ? std::filesystem::path(argv[3]) : lodScenePath(plyPath);
+
+        SplatSet splats;
+        if (!loadSplatScene(plyPath, splats))
+            return EXIT_FAILURE;
+        reorderMorton(splats);
+        const size_t         leafCount = splats.size();
+        std::vector<LodNode> nodes;
+        if (!buildLodHierarchy(splats, nodes) || !writeLodScene(outPath, splats, leafCount, nodes, plyPath))
+            return EXIT_FAILURE;
+
+        std::printf("Wrote %s (%zu splats, %zu merged nodes in %u levels)\n", outPath.string().c_str(), leafCount,
+                    nodes.size(), static_cast<unsigned>(nodes.back().level));
+        return EXIT_SUCCESS;
+    }
+
+    const std::filesystem::path plyPath   = argv[1];
+    const std::filesystem::path cachePath = argc > 2 ? std::filesystem::path(argv[2]) : splatCachePath(plyPath);
+
+    SplatSet splats;
+    if (!loadSplatScene(plyPath, splats))
+        return EXIT_FAILURE;
+
+    if (!writeSplatCache(cachePath, splats, plyPath))
+        return EXIT_FAILURE;
+
+    std::printf("Wrote %s (%zu splats)\n", cachePath.string().c_str(), splats.size());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+#include "BinningPass.h"
+#include "ProjectionPass.h"
+#include "Context.h"
+#include <iostream>
+
+// bin.comp의 constant_id = 0 (STAGE). 파이프라인 생성 동안만 참조되지만 static에 둠.
+static const vk::SpecializationInfo* stageSpecialization(uint32_t stage) {
+    static const uint32_t kValues[3] = {0, 1, 2};
+    static const vk::SpecializationMapEntry kEntry{0, 0, sizeof(uint32_t)};
+    static const vk::SpecializationInfo kInfos[3] = {
+        {1, &kEntry, sizeof(uint32_t), &kValues[0]},
+        {1, &kEntry, sizeof(uint32_t), &kValues[1]},
+        {1, &kEntry, sizeof(uint32_t), &kValues[2]},
+    };
+    return &kInfos[stage];
+}
+
+// 세 stage 모두 같은 layout: projected2D, tileCount, blockOffsets, keys, values, count, stats
+static std::vector<vk::DescriptorSetLayoutBinding> binningBindings() {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    for (uint32_t b = 0; b < 7; b++) {
+        bindings.push_back({b, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute});
+    }
+    return bindings;
+}
+
+BinningPass::BinningPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight)
+    : reduce_(context, shaderPath, binningBindings(), sizeof(PushConstants), stageSpecialization(0)),
+      scan_(context, shaderPath, binningBindings(), sizeof(PushConstants), stageSpecialization(1)),
+      emit_(context, shaderPath, binningBindings(), sizeof(PushConstants), stageSpecialization(2)),
+      capacities_(framesInFlight, 0),
+      keyCapacities_(framesInFlight, 0)
+{
+    // segment 크기: Gaussian2D 구간이 maxStorageBufferRange에 들어가도록 (ProjectionPass와 같은 식)
+    const vk::PhysicalDeviceLimits limits = context.PhysicalDevice().getProperties().limits;
+    maxGroupsX_  = limits.maxComputeWorkGroupCount[0];
+    segmentSize_ = std::max<uint64_t>(SEGMENT_ALIGN,
+        limits.maxStorageBufferRange / ProjectionPass::GAUSSIAN_2D_STRIDE / SEGMENT_ALIGN * SEGMENT_ALIGN);
+
+    // set은 UpdateDescriptors에서 segment 수만큼 할당
+    descriptorSets_.resize(framesInFlight);
+    createDescriptorPool(context, framesInFlight, 1);
+}
+
+void BinningPass::createDescriptorPool(Context& context, uint32_t framesInFlight, uint32_t setsPerFrame) {
+    const uint32_t maxSets = framesInFlight * setsPerFrame;
+    vk::DescriptorPoolSize poolSize{vk::DescriptorType::eStorageBuffer, maxSets * 7};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+    poolInfo.setMaxSets(maxSets);
+    poolInfo.setPoolSizes(poolSize);
+    descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+    setsPerFrame_   = setsPerFrame;
+}
+
+void BinningPass::allocateDescriptorSets(Context& context, uint32_t frameIndex, uint32_t segmentCount) {
+    if (descriptorSets_[frameIndex].size() == segmentCount) {
+        return;
+    }
+    if (segmentCount > setsPerFrame_) {
+        // pool을 키움: 모든 frame의 set을 먼저 반환 (나머지 frame은 각자의 UpdateDescriptors에서 재할당)
+        for (auto& sets : descriptorSets_) {
+            sets.clear();
+        }
+        descriptorPool_ = nullptr;
+        createDescriptorPool(context, static_cast<uint32_t>(descriptorSets_.size()), segmentCount);
+    }
+    descriptorSets_[frameIndex].clear();
+
+    // layout이 동일하게 정의되어 있으므로 reduce layout으로 할당한 set을 세 파이프라인에 모두 binding
+    std::vector<vk::DescriptorSetLayout> layouts(segmentCount, reduce_.GetDescriptorSetLayout());
+    vk::DescriptorSetAllocateInfo allocInfo{};
+    allocInfo.setDescriptorPool(*descriptorPool_);
+    allocInfo.setSetLayouts(layouts);
+    descriptorSets_[frameIndex] = context.Device().allocateDescriptorSets(allocInfo);
+}
+
+void BinningPass::UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                                    uint64_t capacity, uint64_t keyCapacity) {
+    // 키 값(values[])과 push constant는 32비트 행 index. 넘는 행은 binning하지 않음
+    if (capacity > MAX_ROWS) {
+        std::cerr << "Binning supports at most " << MAX_ROWS << " splats (32-bit key values); "
+                  << capacity - MAX_ROWS << " splats will not be drawn" << std::endl;
+        capacity = MAX_ROWS;
+    }
+    const uint32_t segmentCount = static_cast<uint32_t>(
+        std::max<uint64_t>(1, (capacity + segmentSize_ - 1) / segmentSize_));
+    allocateDescriptorSets(context, frameIndex, segmentCount);
+
+    // 빈 범위는 허용되지 않으므로 최소 한 개
+    const uint64_t keys = std::max<uint64_t>(1, keyCapacity);
+    capacities_[frameIndex]    = capacity;
+    keyCapacities_[frameIndex] = keyCapacity;
+
+    // projected2D / tileCount만 segment 구간, 나머지는 전체 (blockOffsets는 전체 block index로 접근)
+    std::vector<std::array<vk::DescriptorBufferInfo, 7>> bufferInfos(segmentCount);
+    std::vector<vk::WriteDescriptorSet> writes;
+    writes.reserve(segmentCount * 7);
+    for (uint32_t s = 0; s < segmentCount; s++) {
+        const uint64_t first = s * segmentSize_;
+        const uint64_t rows  = std::max<uint64_t>(1, std::min(capacity, first + segmentSize_) - first);
+        bufferInfos[s] = {
+            vk::DescriptorBufferInfo{buffers.projected2D, first * ProjectionPass::GAUSSIAN_2D_STRIDE,
+                                     rows * ProjectionPass::GAUSSIAN_2D_STRIDE},
+            vk::DescriptorBufferInfo{buffers.tileCount, first * sizeof(uint32_t), rows * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.blockOffsets, 0, BlockOffsetBytes(capacity)},
+            vk::DescriptorBufferInfo{buffers.keys, 0, keys * 2 * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.values, 0, keys * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.keyCount, 0, sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.stats, 0, sizeof(uint32_t)},
+        };
+        for (uint32_t b = 0; b < 7; b++) {
+            vk::WriteDescriptorSet write{};
+            write.setDstSet(*descriptorSets_[frameIndex][s]);
+            write.setDstBinding(b);
+            write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+            write.setBufferInfo(bufferInfos[s][b]);
+            writes.push_back(write);
+        }
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void BinningPass::Record(vk::CommandBuffer cmd) {
+    if (keyCapacities_[currentFrame_] == 0) {
+        return;  // 아직 키 버퍼 없음
+    }
+    const uint64_t count = std::min(gaussianCount_, capacities_[currentFrame_]);
+    pushConstants_.keyCapacity = static_cast<uint32_t>(keyCapacities_[currentFrame_]);
+
+    const auto& sets = descriptorSets_[currentFrame_];
+    auto dispatch = [&](const ComputePipeline& pipeline, vk::DescriptorSet set, uint32_t x, uint32_t y) {
+        cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline.GetHandle());
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline.GetLayout(), 0, set, {});
+        cmd.pushConstants(pipeline.GetLayout(), vk::ShaderStageFlagBits::eCompute,
+                          0, sizeof(PushConstants), &pushConstants_);
+        cmd.dispatch(x, y, 1);
+    };
+    // segment마다 그 segment의 splat 수로 dispatch. block 수가 x 한도를 넘으면 y로 접음 (bin.comp가 평탄화)
+    auto dispatchSegments = [&](const ComputePipeline& pipeline) {
+        for (uint32_t s = 0; s < sets.size() && (s == 0 || s * segmentSize_ < count); s++) {
+            const uint64_t first = s * segmentSize_;
+            const uint64_t rows  = std::min(segmentSize_, count - std::min(count, first));
+            pushConstants_.gaussianCount = static_cast<uint32_t>(rows);
+            pushConstants_.firstRow      = static_cast<uint32_t>(first);
+
+            const uint64_t blocks = std::max<uint64_t>(1, BlockCount(rows));
+            const uint32_t groupsX = static_cast<uint32_t>(std::min<uint64_t>(blocks, maxGroupsX_));
+            const uint32_t groupsY = static_cast<uint32_t>((blocks + groupsX - 1) / groupsX);
+            dispatch(pipeline, *sets[s], groupsX, groupsY);
+        }
+    };
+    auto barrier = [&](vk::PipelineStageFlags dstStage, vk::AccessFlags dstAccess) {
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+        memoryBarrier.dstAccessMask = dstAccess;
+        cmd.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, dstStage, {}, memoryBarrier, {}, {});
+    };
+    const vk::AccessFlags shaderAccess = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+
+    dispatchSegments(reduce_);
+    barrier(vk::PipelineStageFlagBits::eComputeShader, shaderAccess);
+    // scan은 모든 segment의 block 합을 한 번에 (segment 크기가 BLOCK_SIZE의 배수라 block이 이어짐)
+    pushConstants_.gaussianCount = static_cast<uint32_t>(count);
+    pushConstants_.firstRow      = 0;
+    dispatch(scan_, *sets[0], 1, 1);
+    barrier(vk::PipelineStageFlagBits::eComputeShader, shaderAccess);
+    dispatchSegments(emit_);
+
+    // 키 / 개수 → 정렬, stats → fence 대기 후 호스트가 읽음
+    barrier(vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eHost,
+            shaderAccess | vk::AccessFlagBits::eHostRead);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "Core.h"
+#include "ComputePass.h"
+#include "ComputePipeline.h"
+
+class Context;
+
+// Projection이 센 Gaussian별 tileCount를 device 전체에서 exclusive scan해 키 쓰기 위치를 정하고,
+// Gaussian마다 겹친 tile 수만큼 (tile id, depth) 키 + Gaussian index를 SortPass 입력으로 기록.
+//
+// 세 dispatch로 구성 (bin.comp의 STAGE):
+//   Reduce: BLOCK_SIZE개 block마다 tileCount 합 → blockOffsets[block]
+//   Scan:   workgroup 하나가 block 합을 exclusive scan, 전체 합 → count(≤ keyCapacity) + stats
+//   Emit:   block 안에서 다시 scan해 Gaussian마다 [offset, offset + tileCount) 구간에 키 기록
+// 필요한 키 수는 GPU에서만 알게 되므로 CPU는 stats(HOST_VISIBLE)를 그 프레임 슬롯의 fence 뒤에 읽고,
+// keyCapacity를 넘었으면 버퍼를 키워 다시 UpdateDescriptors (넘친 프레임은 keyCapacity까지만 그려짐).
+// projected2D / tileCount는 maxStorageBufferRange를 넘을 수 있으므로 ProjectionPass처럼 segment로 나눠
+// reduce / emit을 segment마다 dispatch. blockOffsets와 키는 장면 전체 기준이라 scan은 한 번.
+//
+// Usage:
+//   BinningPass bin(context, "Shaders/bin.comp.spv", framesInFlight);
+//   bin.UpdateDescriptors(context, frame, buffers, capacity, keyCapacity);
+//   bin.SetPushConstants(gaussianCount, tileWidth, tileHeight);
+//   bin.Record(cmd);   // 이어서 SortPass (keys[0] / values[0] / count)
+class BinningPass : public ComputePass {
+public:
+    static constexpr uint32_t ITEMS_PER_THREAD = 16;
+    static constexpr uint32_t BLOCK_SIZE       = 256 * ITEMS_PER_THREAD;  // bin.comp와 일치
+    // 키 값은 32비트 행 index (firstRow + segment 안 index)이므로 binning할 수 있는 splat 수의 상한
+    static constexpr uint64_t MAX_ROWS = std::numeric_limits<uint32_t>::max();
+
+    struct Buffers {
+        vk::Buffer projected2D;   // ProjectionPass 출력 (Gaussian2D)
+        vk::Buffer tileCount;     // ProjectionPass 출력 (uint)
+        vk::Buffer blockOffsets;  // BlockOffsetBytes(capacity)
+        vk::Buffer keys;          // SortPass keys[0]: uvec2 × keyCapacity
+        vk::Buffer values;        // SortPass values[0]: uint × keyCapacity (32비트 전체 행 index)
+        vk::Buffer keyCount;      // SortPass count
+        vk::Buffer stats;         // HOST_VISIBLE uint 하나: 잘리기 전 전체 키 수
+    };
+
+    // gaussianCount / firstRow는 segment 단위 (Record가 segment마다 채움, scan은 전체)
+    struct PushConstants {
+        uint32_t gaussianCount;
+        uint32_t tileWidth;
+        uint32_t tileHeight;
+        uint32_t keyCapacity;
+        uint32_t firstRow;       // segment 첫 splat의 전체 index (BLOCK_SIZE의 배수)
+    };
+
+    BinningPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight);
+
+    static uint64_t BlockCount(uint64_t capacity) { return (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE; }
+    static vk::DeviceSize BlockOffsetBytes(uint64_t capacity) {
+        return sizeof(uint32_t) * std::max<uint64_t>(1, BlockCount(capacity));
+    }
+
+    // capacity: projection 출력 버퍼의 splat 수 (MAX_ROWS를 넘으면 오류 로그 후 잘림),
+    // keyCapacity: 키/값 버퍼의 키 수 (2^32 미만).
+    // segment마다 projected2D / tileCount의 [offset, range) 구간을 binding한 descriptor set을 둠
+    void UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                           uint64_t capacity, uint64_t keyCapacity);
+
+    void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
+    void SetPushConstants(uint64_t gaussianCount, uint32_t tileWidth, uint32_t tileHeight) {
+        gaussianCount_ = gaussianCount;
+        pushConstants_ = {0, tileWidth, tileHeight, 0};
+    }
+
+    // reduce → scan → emit. 끝에서 키/개수는 정렬(compute)에, stats는 호스트에 보이도록 배리어
+    void Record(vk::CommandBuffer cmd) override;
+
+private:
+    ComputePipeline reduce_;
+    ComputePipeline scan_;
+    ComputePipeline emit_;
+    vk::raii::DescriptorPool descriptorPool_ = nullptr;
+    uint32_t setsPerFrame_ = 0;  // 현재 pool이 frame마다 담을 수 있는 set 수
+    std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets_;  // [frame][segment]
+    std::vector<uint64_t> capacities_;      // binning할 수 있는 splat 수
+    std::vector<uint64_t> keyCapacities_;   // 0 = 버퍼 없음
+    uint64_t segmentSize_  = 0;             // SEGMENT_ALIGN의 배수, Gaussian2D 구간이 maxStorageBufferRange 안
+    uint32_t maxGroupsX_   = 65535;
+    uint32_t currentFrame_ = 0;
+    uint64_t gaussianCount_ = 0;
+    PushConstants pushConstants_{};
+
+    // segment 경계가 BLOCK_SIZE와 minStorageBufferOffsetAlignment(≤ 256)의 배수가 되도록
+    static constexpr uint64_t SEGMENT_ALIGN = 64 * 1024;
+
+    void createDescriptorPool(Context& context, uint32_t framesInFlight, uint32_t setsPerFrame);
+    void allocateDescriptorSets(Context& context, uint32_t frameIndex, uint32_t segmentCount);
+};
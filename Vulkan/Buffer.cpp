@@ -1,38 +1,9 @@
 #include "Buffer.h"
 #include "Context.h"
-
-// One-shot copy command for staging → device-local transfer
-static void copyBuffer(Context& context, VkBuffer src, VkBuffer dst, vk::DeviceSize size)
-{
-    vk::CommandPoolCreateInfo poolInfo{};
-    poolInfo.flags            = vk::CommandPoolCreateFlagBits::eTransient;
-    poolInfo.queueFamilyIndex = context.GetGraphicsQueueFamily();
-
-    vk::raii::CommandPool pool(context.Device(), poolInfo);
-
-    vk::CommandBufferAllocateInfo allocInfo{};
-    allocInfo.commandPool        = *pool;
-    allocInfo.level              = vk::CommandBufferLevel::ePrimary;
-    allocInfo.commandBufferCount = 1;
-
-    auto cmdBuffers = context.Device().allocateCommandBuffers(allocInfo);
-    auto& cmd       = cmdBuffers[0];
-
-    cmd.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-    cmd.copyBuffer(src, dst, vk::BufferCopy{0, 0, size});
-    cmd.end();
-
-    vk::CommandBuffer rawCmd = *cmd;
-    vk::SubmitInfo submitInfo{};
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers    = &rawCmd;
-
-    context.GetGraphicsQueue().submit(submitInfo);
-    context.GetGraphicsQueue().waitIdle();
-}
+#include "UploadManager.h"
 
 Buffer Buffer::CreateDeviceLocal(Context& context, vk::BufferUsageFlags usage,
-                                 vk::DeviceSize size, const void* data) {
+                                 vk::DeviceSize size) {
     Buffer buf;
     buf.allocator_ = context.GetAllocator();
     buf.size_ = size;
@@ -43,67 +14,26 @@ Buffer Buffer::CreateDeviceLocal(Context& context, vk::BufferUsageFlags usage,
     bufferInfo.usage = static_cast<VkBufferUsageFlags>(usage);
 
     VmaAllocationCreateInfo allocInfo{};
-    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-
-    if (data) {
-        // Device-local buffer (transfer destination)
-        bufferInfo.usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
-        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    allocInfo.usage          = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
-        if (vmaCreateBuffer(buf.allocator_, &bufferInfo, &allocInfo,
-                            &buf.buffer_, &buf.allocation_, nullptr) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create device-local buffer");
-        }
-
-        // Staging buffer (host-visible, coherent)
-        VkBuffer stagingBuffer           = VK_NULL_HANDLE;
-        VmaAllocation stagingAllocation  = nullptr;
-
-        VkBufferCreateInfo stagingInfo{};
-        stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        stagingInfo.size  = size;
-        stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-        VmaAllocationCreateInfo stagingAllocInfo{};
-        stagingAllocInfo.usage         = VMA_MEMORY_USAGE_AUTO;
-        stagingAllocInfo.flags         = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
-                                         VMA_ALLOCATION_CREATE_MAPPED_BIT;
-        stagingAllocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-
-        VmaAllocationInfo stagingAllocInfoOut{};
-        if (vmaCreateBuffer(buf.allocator_, &stagingInfo, &stagingAllocInfo,
-                            &stagingBuffer, &stagingAllocation, &stagingAllocInfoOut) != VK_SUCCESS) {
-            vmaDestroyBuffer(buf.allocator_, buf.buffer_, buf.allocation_);
-            buf.buffer_     = VK_NULL_HANDLE;
-            buf.allocation_ = nullptr;
-            throw std::runtime_error("Failed to create staging buffer");
-        }
-
-        memcpy(stagingAllocInfoOut.pMappedData, data, size);
-
-        try {
-            copyBuffer(context, stagingBuffer, buf.buffer_, size);
-        } catch (...) {
-            vmaDestroyBuffer(buf.allocator_, stagingBuffer, stagingAllocation);
-            vmaDestroyBuffer(buf.allocator_, buf.buffer_, buf.allocation_);
-            buf.buffer_     = VK_NULL_HANDLE;
-            buf.allocation_ = nullptr;
-            throw;
-        }
-        vmaDestroyBuffer(buf.allocator_, stagingBuffer, stagingAllocation);
-    } else {
-        // Device-local buffer without initial data
-        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-        if (vmaCreateBuffer(buf.allocator_, &bufferInfo, &allocInfo,
-                            &buf.buffer_, &buf.allocation_, nullptr) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create device-local buffer");
-        }
+    if (vmaCreateBuffer(buf.allocator_, &bufferInfo, &allocInfo,
+                        &buf.buffer_, &buf.allocation_, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create device-local buffer");
     }
 
     return buf;
 }
 
+Buffer Buffer::CreateDeviceLocal(Context& context, UploadManager& uploads,
+                                 vk::BufferUsageFlags usage, vk::DeviceSize size,
+                                 const void* data) {
+    // Device-local buffer (transfer destination); 복사는 uploads의 다음 Flush에 묶임
+    Buffer buf = CreateDeviceLocal(context, usage | vk::BufferUsageFlagBits::eTransferDst, size);
+    uploads.Enqueue(buf, data, size);
+    return buf;
+}
+
 Buffer Buffer::CreateHostVisible(Context& context, vk::BufferUsageFlags usage,
                                  vk::DeviceSize size) {
     Buffer buf;
@@ -2,12 +2,18 @@
 #include "Core.h"
 
 class Context;
+class UploadManager;
 
 class Buffer {
 public:
-    // GPU 전용 (DEVICE_LOCAL). data != nullptr면 내부 staging으로 초기 업로드.
+    // GPU 전용 (DEVICE_LOCAL), 초기 데이터 없음.
     static Buffer CreateDeviceLocal(Context& context, vk::BufferUsageFlags usage,
-                                    vk::DeviceSize size, const void* data = nullptr);
+                                    vk::DeviceSize size);
+
+    // GPU 전용 + 초기 데이터. 복사는 uploads에 예약만 되고 Flush()/Wait()로 완료됨.
+    static Buffer CreateDeviceLocal(Context& context, UploadManager& uploads,
+                                    vk::BufferUsageFlags usage, vk::DeviceSize size,
+                                    const void* data);
 
     // HOST_VISIBLE (매핑됨). 매 프레임 Upload용 스테이징 버퍼.
     static Buffer CreateHostVisible(Context& context, vk::BufferUsageFlags usage,
@@ -21,6 +27,7 @@ public:
 
     vk::Buffer GetHandle() const { return buffer_; }
     vk::DeviceSize GetSize() const { return size_; }
+    void* GetMappedData() const { return mappedData_; }  // HOST_VISIBLE 버퍼만, 그 외 nullptr
 
     // HOST_VISIBLE 버퍼에 데이터 쓰기 (memcpy)
     void Upload(const void* data, vk::DeviceSize size);
@@ -0,0 +1,95 @@
+#include "ClusterCullPass.h"
+#include "Context.h"
+
+ClusterCullPass::ClusterCullPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight)
+    : pipeline_(context, shaderPath,
+                // 3 SSBOs: cluster bounds, 보이는 cluster 목록, dispatch 인자
+                std::vector<vk::DescriptorSetLayoutBinding>{
+                    {0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                },
+                sizeof(PushConstants)),
+      dispatchArgs_(framesInFlight),
+      dispatchArgsSizes_(framesInFlight, 0)
+{
+    maxGroupsX_ = context.PhysicalDevice().getProperties().limits.maxComputeWorkGroupCount[0];
+
+    vk::DescriptorPoolSize poolSize{vk::DescriptorType::eStorageBuffer, framesInFlight * 3};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+    poolInfo.setMaxSets(framesInFlight);
+    poolInfo.setPoolSizes(poolSize);
+    descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+
+    std::vector<vk::DescriptorSetLayout> layouts(framesInFlight, pipeline_.GetDescriptorSetLayout());
+    vk::DescriptorSetAllocateInfo allocInfo{};
+    allocInfo.setDescriptorPool(*descriptorPool_);
+    allocInfo.setSetLayouts(layouts);
+    descriptorSets_ = context.Device().allocateDescriptorSets(allocInfo);
+}
+
+void ClusterCullPass::UpdateDescriptors(Context& context, uint32_t frameIndex,
+                                        vk::Buffer clusterBounds, vk::DeviceSize boundsSize,
+                                        vk::Buffer visibleClusters, vk::DeviceSize visibleSize,
+                                        vk::Buffer dispatchArgs, vk::DeviceSize argsSize) {
+    dispatchArgs_[frameIndex]      = dispatchArgs;
+    dispatchArgsSizes_[frameIndex] = argsSize;
+
+    const std::array<vk::DescriptorBufferInfo, 3> bufferInfos = {
+        vk::DescriptorBufferInfo{clusterBounds, 0, boundsSize},
+        vk::DescriptorBufferInfo{visibleClusters, 0, visibleSize},
+        vk::DescriptorBufferInfo{dispatchArgs, 0, argsSize},
+    };
+    std::array<vk::WriteDescriptorSet, 3> writes{};
+    for (uint32_t b = 0; b < 3; b++) {
+        writes[b].setDstSet(*descriptorSets_[frameIndex]);
+        writes[b].setDstBinding(b);
+        writes[b].setDescriptorType(vk::DescriptorType::eStorageBuffer);
+        writes[b].setBufferInfo(bufferInfos[b]);
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void ClusterCullPass::Record(vk::CommandBuffer cmd) {
+    // segment마다 (0, 1, 1): x는 cull.comp가 보이는 cluster마다 하나씩 올림
+    const size_t segmentCount = dispatchArgsSizes_[currentFrame_] / DISPATCH_ARGS_STRIDE;
+    std::vector<uint32_t> args(segmentCount * 3, 1);
+    for (size_t s = 0; s < segmentCount; s++) {
+        args[s * 3] = 0;
+    }
+    cmd.updateBuffer(dispatchArgs_[currentFrame_], 0,
+                     args.size() * sizeof(uint32_t), args.data());
+
+    vk::MemoryBarrier clearBarrier{};
+    clearBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    clearBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eComputeShader,
+        {}, clearBarrier, {}, {}
+    );
+
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_.GetHandle());
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                           pipeline_.GetLayout(), 0,
+                           *descriptorSets_[currentFrame_], {});
+    cmd.pushConstants(pipeline_.GetLayout(),
+                      vk::ShaderStageFlagBits::eCompute,
+                      0, sizeof(PushConstants), &pushConstants_);
+
+    // cluster 하나당 thread 하나. x 한도를 넘으면 y로 접음 (cull.comp가 평탄화)
+    const uint32_t groupCount = (pushConstants_.clusterCount + 255) / 256;
+    const uint32_t groupsX    = std::max(1u, std::min(groupCount, maxGroupsX_));
+    cmd.dispatch(groupsX, (groupCount + groupsX - 1) / groupsX, 1);
+
+    // 인자는 dispatchIndirect가, 목록은 proj.comp가 읽음
+    vk::MemoryBarrier cullBarrier{};
+    cullBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+    cullBarrier.dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead;
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader,
+        vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eComputeShader,
+        {}, cullBarrier, {}, {}
+    );
+}
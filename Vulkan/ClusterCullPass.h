@@ -0,0 +1,54 @@
+#pragma once
+#include "Core.h"
+#include "ComputePass.h"
+#include "ComputePipeline.h"
+
+class Context;
+
+// 256개 splat cluster(SplatClusters.h)의 bounding sphere를 frustum 평면과 비교해 보이는 cluster만
+// segment별 목록으로 모으고, 그 수를 segment별 vkCmdDispatchIndirect 인자 (x, 1, 1)로 기록.
+// ProjectionPass가 소유하며 projection dispatch 직전에 기록함 (cull.comp).
+//
+// 목록 레이아웃: segment s의 cluster는 visibleClusters[s * clustersPerSegment ...]에
+// segment 안 cluster index로 기록 (순서는 atomic 순서라 비결정적이지만 projection 출력 위치는
+// cluster index로 정해지므로 결과는 같음). 인자는 segment마다 uint 3개 = 12 B.
+class ClusterCullPass : public ComputePass {
+public:
+    struct PushConstants {
+        std::array<glm::vec4, 6> planes;  // FrustumPlanes: dot(n, p) + d >= 0이 안쪽
+        uint32_t clusterCount;
+        uint32_t clustersPerSegment;
+    };
+
+    static constexpr vk::DeviceSize DISPATCH_ARGS_STRIDE = 3 * sizeof(uint32_t);
+
+    ClusterCullPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight);
+
+    // clusterBounds: cluster마다 vec4 (center, radius), visibleClusters: cluster마다 uint,
+    // dispatchArgs: segment마다 DISPATCH_ARGS_STRIDE (STORAGE | INDIRECT | TRANSFER_DST)
+    void UpdateDescriptors(Context& context, uint32_t frameIndex,
+                           vk::Buffer clusterBounds, vk::DeviceSize boundsSize,
+                           vk::Buffer visibleClusters, vk::DeviceSize visibleSize,
+                           vk::Buffer dispatchArgs, vk::DeviceSize argsSize);
+
+    void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
+    void SetParameters(const std::array<glm::vec4, 6>& planes, uint64_t clusterCount,
+                       uint32_t clustersPerSegment) {
+        pushConstants_ = {planes, static_cast<uint32_t>(clusterCount), clustersPerSegment};
+    }
+    vk::Buffer GetDispatchArgs() const { return dispatchArgs_[currentFrame_]; }
+
+    // 인자 초기화 → cull → indirect 인자/목록을 읽는 projection 대비 배리어.
+    // 첫 배리어는 transfer 전체를 덮으므로 이 호출 앞에 기록한 fill도 projection 전에 보임
+    void Record(vk::CommandBuffer cmd) override;
+
+private:
+    ComputePipeline pipeline_;
+    vk::raii::DescriptorPool descriptorPool_ = nullptr;
+    std::vector<vk::raii::DescriptorSet> descriptorSets_;  // frame마다 하나
+    std::vector<vk::Buffer> dispatchArgs_;
+    std::vector<vk::DeviceSize> dispatchArgsSizes_;
+    uint32_t maxGroupsX_   = 65535;
+    uint32_t currentFrame_ = 0;
+    PushConstants pushConstants_{};
+};
@@ -8,12 +8,13 @@ CommandManager::CommandManager(Context& context) {
     poolInfo.setQueueFamilyIndex(context.GetGraphicsQueueFamily());
     pool_ = context.Device().createCommandPool(poolInfo);
 
-    // Allocate FRAMES_IN_FLIGHT command buffers
+    // Allocate FRAMES_IN_FLIGHT command buffers (compute passes + present)
     vk::CommandBufferAllocateInfo allocInfo{};
     allocInfo.setCommandPool(*pool_);
     allocInfo.setLevel(vk::CommandBufferLevel::ePrimary);
     allocInfo.setCommandBufferCount(FRAMES_IN_FLIGHT);
     commandBuffers_ = context.Device().allocateCommandBuffers(allocInfo);
+    presentBuffers_ = context.Device().allocateCommandBuffers(allocInfo);
 
     // Immediate submit resources
     vk::CommandPoolCreateInfo immPoolInfo{};
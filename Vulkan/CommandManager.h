@@ -13,6 +13,8 @@ public:
     CommandManager& operator=(const CommandManager&) = delete;
 
     const std::vector<vk::raii::CommandBuffer>& GetCommandBuffers() const { return commandBuffers_; }
+    // frame마다 두 번째 command buffer: swapchain 이미지를 건드리는 명령만 따로 제출 (acquire 대기 분리)
+    const std::vector<vk::raii::CommandBuffer>& GetPresentCommandBuffers() const { return presentBuffers_; }
 
     void ImmediateSubmit(Context& context,
                          std::function<void(vk::CommandBuffer)>&& fn);
@@ -20,6 +22,7 @@ public:
 private:
     vk::raii::CommandPool pool_ = nullptr;
     std::vector<vk::raii::CommandBuffer> commandBuffers_;
+    std::vector<vk::raii::CommandBuffer> presentBuffers_;
 
     // For ImmediateSubmit
     vk::raii::CommandPool immediatePool_      = nullptr;
@@ -3,7 +3,8 @@
 
 ComputePipeline::ComputePipeline(Context& context, const std::string& shaderPath,
                                  const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
-                                 uint32_t pushConstantSize) {
+                                 uint32_t pushConstantSize,
+                                 const vk::SpecializationInfo* specialization) {
     // Descriptor set layout
     vk::DescriptorSetLayoutCreateInfo layoutInfo{};
     layoutInfo.setBindings(bindings);
@@ -33,6 +34,7 @@ ComputePipeline::ComputePipeline(Context& context, const std::string& shaderPath
     stageInfo.setStage(vk::ShaderStageFlagBits::eCompute);
     stageInfo.setModule(*shaderModule);
     stageInfo.setPName("main");
+    stageInfo.setPSpecializationInfo(specialization);  // constant_id 값 (nullptr = 셰이더 기본값)
 
     vk::ComputePipelineCreateInfo pipelineInfo{};
     pipelineInfo.setStage(stageInfo);
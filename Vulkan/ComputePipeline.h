@@ -7,7 +7,8 @@ class ComputePipeline {
 public:
     ComputePipeline(Context& context, const std::string& shaderPath,
                     const std::vector<vk::DescriptorSetLayoutBinding>& bindings,
-                    uint32_t pushConstantSize = 0);
+                    uint32_t pushConstantSize = 0,
+                    const vk::SpecializationInfo* specialization = nullptr);
 
     vk::Pipeline GetHandle() const { return *pipeline_; }
     vk::PipelineLayout GetLayout() const { return *layout_; }
@@ -176,10 +176,11 @@ void Context::createLogicalDevice() {
 
     graphicsQueueFamily_ = indices.graphicsFamily.value();
     presentQueueFamily_  = indices.presentFamily.value();
+    transferQueueFamily_ = indices.transferFamily.value_or(graphicsQueueFamily_);
 
     // Use a set to ensure unique queue families
     std::set<uint32_t> uniqueQueueFamilies = {
-        graphicsQueueFamily_, presentQueueFamily_
+        graphicsQueueFamily_, presentQueueFamily_, transferQueueFamily_
     };
 
     float queuePriority = 1.0f;
@@ -194,7 +195,12 @@ void Context::createLogicalDevice() {
 
     vk::PhysicalDeviceFeatures deviceFeatures{};
 
+    // Timeline semaphore: UploadManager가 제출별 완료를 값으로 추적
+    vk::PhysicalDeviceVulkan12Features vulkan12Features{};
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+
     vk::DeviceCreateInfo createInfo{};
+    createInfo.pNext                   = &vulkan12Features;
     createInfo.queueCreateInfoCount    = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos       = queueCreateInfos.data();
     createInfo.pEnabledFeatures        = &deviceFeatures;
@@ -212,6 +218,7 @@ void Context::createLogicalDevice() {
 
     graphicsQueue_ = (*device_).getQueue(graphicsQueueFamily_, 0);
     presentQueue_  = (*device_).getQueue(presentQueueFamily_, 0);
+    transferQueue_ = (*device_).getQueue(transferQueueFamily_, 0);
 }
 
 // ---------------------------------------------------------------------------
@@ -259,6 +266,22 @@ Context::QueueFamilyIndices Context::findQueueFamilies(vk::PhysicalDevice device
         if (indices.isComplete()) break;
     }
 
+    // Transfer 전용 family (DMA 엔진) 우선, 없으면 graphics 없는 compute family.
+    // 둘 다 없으면 비워 두고 graphics 큐로 업로드.
+    for (uint32_t i = 0; i < static_cast<uint32_t>(queueFamilies.size()); i++) {
+        auto flags = queueFamilies[i].queueFlags;
+        if (!(flags & vk::QueueFlagBits::eTransfer) || (flags & vk::QueueFlagBits::eGraphics)) {
+            continue;
+        }
+        if (!(flags & vk::QueueFlagBits::eCompute)) {
+            indices.transferFamily = i;
+            break;
+        }
+        if (!indices.transferFamily.has_value()) {
+            indices.transferFamily = i;
+        }
+    }
+
     return indices;
 }
 
@@ -15,8 +15,11 @@ public:
     vk::raii::Instance& Instance() { return instance_; }
     vk::Queue GetGraphicsQueue() const { return graphicsQueue_; }
     vk::Queue GetPresentQueue() const { return presentQueue_; }
+    vk::Queue GetTransferQueue() const { return transferQueue_; }  // 전용 family가 없으면 graphics 큐
     uint32_t GetGraphicsQueueFamily() const { return graphicsQueueFamily_; }
     uint32_t GetPresentQueueFamily() const { return presentQueueFamily_; }
+    uint32_t GetTransferQueueFamily() const { return transferQueueFamily_; }
+    bool HasDedicatedTransferQueue() const { return transferQueueFamily_ != graphicsQueueFamily_; }
     VmaAllocator GetAllocator() const { return allocator_; }
     vk::SurfaceKHR GetSurface() const { return *surface_; }
 
@@ -32,8 +35,10 @@ private:
 
     vk::Queue graphicsQueue_;
     vk::Queue presentQueue_;
+    vk::Queue transferQueue_;
     uint32_t graphicsQueueFamily_ = 0;
     uint32_t presentQueueFamily_  = 0;
+    uint32_t transferQueueFamily_ = 0;
 
     void createInstance();
     void setupDebugMessenger();
@@ -45,6 +50,7 @@ private:
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> transferFamily;  // graphics 없는 family (선택)
         bool isComplete() const {
             return graphicsFamily.has_value() && presentFamily.has_value();
         }
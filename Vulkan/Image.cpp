@@ -0,0 +1,87 @@
+#include "Image.h"
+#include "Context.h"
+
+Image Image::CreateDeviceLocal(Context& context, vk::Format format, vk::Extent2D extent,
+                               vk::ImageUsageFlags usage) {
+    Image img;
+    img.allocator_ = context.GetAllocator();
+    img.format_    = format;
+    img.extent_    = extent;
+
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+    imageInfo.format        = static_cast<VkFormat>(format);
+    imageInfo.extent        = {extent.width, extent.height, 1};
+    imageInfo.mipLevels     = 1;
+    imageInfo.arrayLayers   = 1;
+    imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+    imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.usage         = static_cast<VkImageUsageFlags>(usage);
+    imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VmaAllocationCreateInfo allocInfo{};
+    allocInfo.usage          = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+    if (vmaCreateImage(img.allocator_, &imageInfo, &allocInfo,
+                       &img.image_, &img.allocation_, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create device-local image");
+    }
+
+    vk::ImageViewCreateInfo viewInfo{};
+    viewInfo.image    = img.image_;
+    viewInfo.viewType = vk::ImageViewType::e2D;
+    viewInfo.format   = format;
+    viewInfo.subresourceRange.aspectMask     = vk::ImageAspectFlagBits::eColor;
+    viewInfo.subresourceRange.baseMipLevel   = 0;
+    viewInfo.subresourceRange.levelCount     = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount     = 1;
+    img.view_ = vk::raii::ImageView(context.Device(), viewInfo);
+
+    return img;
+}
+
+void Image::destroy() {
+    view_ = nullptr;
+    if (image_ && allocation_ && allocator_) {
+        vmaDestroyImage(allocator_, image_, allocation_);
+    }
+}
+
+Image::~Image() {
+    destroy();
+}
+
+Image::Image(Image&& other) noexcept
+    : allocator_(other.allocator_)
+    , image_(other.image_)
+    , allocation_(other.allocation_)
+    , view_(std::move(other.view_))
+    , format_(other.format_)
+    , extent_(other.extent_)
+{
+    other.allocator_  = nullptr;
+    other.image_      = VK_NULL_HANDLE;
+    other.allocation_ = nullptr;
+}
+
+Image& Image::operator=(Image&& other) noexcept {
+    if (this != &other) {
+        destroy();
+
+        allocator_  = other.allocator_;
+        image_      = other.image_;
+        allocation_ = other.allocation_;
+        view_       = std::move(other.view_);
+        format_     = other.format_;
+        extent_     = other.extent_;
+
+        other.allocator_  = nullptr;
+        other.image_      = VK_NULL_HANDLE;
+        other.allocation_ = nullptr;
+    }
+    return *this;
+}
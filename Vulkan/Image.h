@@ -0,0 +1,35 @@
+#pragma once
+#include "Core.h"
+
+class Context;
+
+// 2D 이미지 (mip 1, layer 1) + 전체를 덮는 color view. Buffer처럼 VMA로 할당하고 이동만 가능.
+class Image {
+public:
+    // GPU 전용 (DEVICE_LOCAL). 초기 레이아웃은 UNDEFINED
+    static Image CreateDeviceLocal(Context& context, vk::Format format, vk::Extent2D extent,
+                                   vk::ImageUsageFlags usage);
+
+    ~Image();
+    Image(Image&&) noexcept;
+    Image& operator=(Image&&) noexcept;
+    Image(const Image&) = delete;
+    Image& operator=(const Image&) = delete;
+
+    vk::Image GetHandle() const { return image_; }
+    vk::ImageView GetView() const { return *view_; }
+    vk::Format GetFormat() const { return format_; }
+    vk::Extent2D GetExtent() const { return extent_; }
+
+private:
+    Image() = default;
+
+    VmaAllocator allocator_   = nullptr;
+    VkImage image_            = VK_NULL_HANDLE;
+    VmaAllocation allocation_ = nullptr;
+    vk::raii::ImageView view_ = nullptr;  // image_보다 먼저 파괴
+    vk::Format format_        = vk::Format::eUndefined;
+    vk::Extent2D extent_;
+
+    void destroy();
+};
@@ -1,10 +1,60 @@
 #include "ProjectionPass.h"
 #include "Context.h"
 
+// proj.comp의 constant_id = 0 (INPUT_FORMAT), 1 (INDEXED_INPUT). 파이프라인 생성 동안만 참조되지만 static에 둠.
+static const vk::SpecializationInfo* inputSpecialization(ProjectionPass::InputFormat format, bool indexed) {
+    static const uint32_t kValues[8][2] = {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {0, 1}, {1, 1}, {2, 1}, {3, 1}};
+    static const vk::SpecializationMapEntry kEntries[2] = {
+        {0, 0, sizeof(uint32_t)},
+        {1, sizeof(uint32_t), sizeof(uint32_t)},
+    };
+    static const vk::SpecializationInfo kInfos[8] = {
+        {2, kEntries, sizeof(kValues[0]), kValues[0]}, {2, kEntries, sizeof(kValues[1]), kValues[1]},
+        {2, kEntries, sizeof(kValues[2]), kValues[2]}, {2, kEntries, sizeof(kValues[3]), kValues[3]},
+        {2, kEntries, sizeof(kValues[4]), kValues[4]}, {2, kEntries, sizeof(kValues[5]), kValues[5]},
+        {2, kEntries, sizeof(kValues[6]), kValues[6]}, {2, kEntries, sizeof(kValues[7]), kValues[7]},
+    };
+    return &kInfos[static_cast<uint32_t>(format) + (indexed ? 4 : 0)];
+}
+
+// segment 첫 splat `first`에 해당하는 binding(1-10)의 바이트 offset. proj.comp / App의 staging 레이아웃과 일치.
+// indexed면 입력(1-5)은 행 번호로 임의 접근하므로 항상 버퍼 전체 (0 = 고정 버퍼)
+static vk::DeviceSize bindingOffset(ProjectionPass::InputFormat format, bool indexed,
+                                    uint32_t binding, uint64_t first) {
+    // binding 1-5의 splat당 바이트 (0 = segment와 무관한 고정 버퍼)
+    static constexpr vk::DeviceSize kInputStrides[4][5] = {
+        {12, 12, 4, 12, 16},  // Float32
+        {12,  6, 2,  6,  8},  // Float16: positions만 fp32
+        { 4,  4, 0,  4,  4},  // Quantized: binding 3은 청크 테이블 (아래)
+        {12, 12, 4, 24,  0},  // Covariance: binding 5는 dummy
+    };
+    static constexpr uint64_t kQuantChunkSize  = 256;      // QUANT_CHUNK_SIZE
+    static constexpr vk::DeviceSize kChunkBytes = 18 * 4;  // CHUNK_FLOATS floats
+    static constexpr uint64_t kClusterSize     = 256;      // kClusterRows = proj.comp workgroup 크기
+
+    switch (binding) {
+    case 6:  return first * ProjectionPass::GAUSSIAN_2D_STRIDE;
+    case 7:
+    case 8:
+    case 9:  return first * sizeof(uint32_t);
+    case 10: return first / kClusterSize * sizeof(uint32_t);  // segment의 보이는 cluster 목록
+    default: break;
+    }
+    if (indexed) {
+        return 0;
+    }
+    if (format == ProjectionPass::InputFormat::Quantized && binding == 3) {
+        return first / kQuantChunkSize * kChunkBytes;
+    }
+    return first * kInputStrides[static_cast<uint32_t>(format)][binding - 1];
+}
+
 ProjectionPass::ProjectionPass(Context& context, const std::string& shaderPath,
-                               uint32_t framesInFlight)
-    : pipeline_(context, shaderPath,
-                // 9 bindings: 1 UBO + 8 SSBOs
+                               uint32_t framesInFlight, InputFormat inputFormat, bool indexedInput)
+    : inputFormat_(inputFormat),
+      indexedInput_(indexedInput),
+      pipeline_(context, shaderPath,
+                // 11 bindings: 1 UBO + 10 SSBOs
                 std::vector<vk::DescriptorSetLayoutBinding>{
                     {0, vk::DescriptorType::eUniformBuffer, 1, vk::ShaderStageFlagBits::eCompute},
                     {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
@@ -15,69 +65,176 @@ ProjectionPass::ProjectionPass(Context& context, const std::string& shaderPath,
                     {6, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
                     {7, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
                     {8, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {9, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {10, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
                 },
-                sizeof(PushConstants))
+                sizeof(PushConstants),
+                inputSpecialization(inputFormat, indexedInput)),
+      cullPass_(context, std::filesystem::path(shaderPath).replace_filename("cull.comp.spv").string(),
+                framesInFlight),
+      clusterCulling_(framesInFlight, 0),
+      visibility_(framesInFlight),
+      tileCount_(framesInFlight)
 {
-    // Descriptor pool: 1 UBO + 8 SSBOs per set × framesInFlight sets
+    // segment 크기: 가장 큰 스트림(Gaussian2D)의 구간이 maxStorageBufferRange에 들어가도록.
+    // segment 안에서는 proj.comp의 idx*N 인덱스 연산이 32비트로 충분
+    const vk::PhysicalDeviceLimits limits = context.PhysicalDevice().getProperties().limits;
+    maxGroupsX_  = limits.maxComputeWorkGroupCount[0];
+    segmentSize_ = std::max<uint64_t>(SEGMENT_ALIGN,
+        std::min<uint64_t>(limits.maxStorageBufferRange / GAUSSIAN_2D_STRIDE,
+                           uint64_t{maxGroupsX_} * 256) / SEGMENT_ALIGN * SEGMENT_ALIGN);
+
+    // set은 UpdateDescriptors에서 segment 수만큼 할당
+    descriptorSets_.resize(framesInFlight);
+    createDescriptorPool(context, framesInFlight, 1);
+}
+
+void ProjectionPass::createDescriptorPool(Context& context, uint32_t framesInFlight, uint32_t setsPerFrame) {
+    // Descriptor pool: 1 UBO + 10 SSBOs per set × setsPerFrame × framesInFlight
+    const uint32_t maxSets = framesInFlight * setsPerFrame;
     std::array<vk::DescriptorPoolSize, 2> poolSizes = {
-        vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, framesInFlight},
-        vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, framesInFlight * 8}
+        vk::DescriptorPoolSize{vk::DescriptorType::eUniformBuffer, maxSets},
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, maxSets * 10}
     };
 
     vk::DescriptorPoolCreateInfo poolInfo{};
     poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
-    poolInfo.setMaxSets(framesInFlight);
+    poolInfo.setMaxSets(maxSets);
     poolInfo.setPoolSizes(poolSizes);
     descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+    setsPerFrame_   = setsPerFrame;
+}
+
+void ProjectionPass::allocateDescriptorSets(Context& context, uint32_t frameIndex, uint32_t segmentCount) {
+    if (descriptorSets_[frameIndex].size() == segmentCount) {
+        return;
+    }
+    if (segmentCount > setsPerFrame_) {
+        // pool을 키움: 모든 frame의 set을 먼저 반환 (나머지 frame은 각자의 UpdateDescriptors에서 재할당)
+        for (auto& sets : descriptorSets_) {
+            sets.clear();
+        }
+        descriptorPool_ = nullptr;
+        createDescriptorPool(context, static_cast<uint32_t>(descriptorSets_.size()), segmentCount);
+    }
+    descriptorSets_[frameIndex].clear();
 
-    // Allocate descriptor sets
-    std::vector<vk::DescriptorSetLayout> layouts(framesInFlight,
-                                                  pipeline_.GetDescriptorSetLayout());
+    std::vector<vk::DescriptorSetLayout> layouts(segmentCount, pipeline_.GetDescriptorSetLayout());
     vk::DescriptorSetAllocateInfo allocInfo{};
     allocInfo.setDescriptorPool(*descriptorPool_);
     allocInfo.setSetLayouts(layouts);
-    descriptorSets_ = context.Device().allocateDescriptorSets(allocInfo);
+    descriptorSets_[frameIndex] = context.Device().allocateDescriptorSets(allocInfo);
 }
 
 void ProjectionPass::UpdateDescriptors(Context& context, uint32_t frameIndex,
                                        vk::Buffer cameraUbo, vk::DeviceSize uboSize,
                                        const Buffers& buffers,
-                                       const BufferSizes& sizes) {
-    std::array<vk::DescriptorBufferInfo, 9> bufferInfos = {{
-        {cameraUbo,          0, uboSize},
-        {buffers.positions,  0, sizes.positions},
-        {buffers.sh,         0, sizes.sh},
-        {buffers.opacity,    0, sizes.opacity},
-        {buffers.scale,      0, sizes.scale},
-        {buffers.rotation,   0, sizes.rotation},
-        {buffers.projected2D,0, sizes.projected2D},
-        {buffers.visibility, 0, sizes.visibility},
-        {buffers.tileCount,  0, sizes.tileCount},
-    }};
-
-    std::array<vk::WriteDescriptorSet, 9> writes{};
-    for (uint32_t i = 0; i < 9; i++) {
-        writes[i].setDstSet(*descriptorSets_[frameIndex]);
-        writes[i].setDstBinding(i);
-        writes[i].setDescriptorType(i == 0 ? vk::DescriptorType::eUniformBuffer
+                                       const BufferSizes& sizes, uint64_t capacity) {
+    const uint32_t segmentCount = static_cast<uint32_t>(
+        std::max<uint64_t>(1, (capacity + segmentSize_ - 1) / segmentSize_));
+    allocateDescriptorSets(context, frameIndex, segmentCount);
+
+    // binding 9 / 10은 indexedInput / cluster culling이 아니면 읽히지 않지만 유효해야 하므로
+    // visibility를 대신 binding. cluster culling은 행 indirection과 함께 쓰지 않음 (cluster = 연속 행)
+    const bool hasRows = indexedInput_ && buffers.inputRows;
+    const bool culled  = !indexedInput_ && buffers.clusterBounds && buffers.visibleClusters &&
+                         buffers.dispatchArgs;
+    const std::array<vk::Buffer, 11> handles = {
+        cameraUbo, buffers.positions, buffers.sh, buffers.opacity, buffers.scale,
+        buffers.rotation, buffers.projected2D, buffers.visibility, buffers.tileCount,
+        hasRows ? buffers.inputRows : buffers.visibility,
+        culled ? buffers.visibleClusters : buffers.visibility,
+    };
+    const std::array<vk::DeviceSize, 11> totals = {
+        uboSize, sizes.positions, sizes.sh, sizes.opacity, sizes.scale,
+        sizes.rotation, sizes.projected2D, sizes.visibility, sizes.tileCount,
+        hasRows ? sizes.inputRows : sizes.visibility,
+        culled ? sizes.visibleClusters : sizes.visibility,
+    };
+
+    clusterCulling_[frameIndex] = culled;
+    visibility_[frameIndex]     = buffers.visibility;
+    tileCount_[frameIndex]      = buffers.tileCount;
+    if (culled) {
+        cullPass_.UpdateDescriptors(context, frameIndex,
+                                    buffers.clusterBounds, sizes.clusterBounds,
+                                    buffers.visibleClusters, sizes.visibleClusters,
+                                    buffers.dispatchArgs, sizes.dispatchArgs);
+    }
+
+    // 마지막 segment는 버퍼 끝까지 (fp16 word 패딩 포함), 고정 버퍼(stride 0)는 전체
+    std::vector<std::array<vk::DescriptorBufferInfo, 11>> bufferInfos(segmentCount);
+    std::vector<vk::WriteDescriptorSet> writes;
+    writes.reserve(segmentCount * 11);
+    for (uint32_t s = 0; s < segmentCount; s++) {
+        const uint64_t first = s * segmentSize_;
+        const uint64_t last  = std::min(capacity, first + segmentSize_);
+        bufferInfos[s][0] = {cameraUbo, 0, uboSize};
+        for (uint32_t b = 1; b < 11; b++) {
+            const vk::DeviceSize offset = bindingOffset(inputFormat_, indexedInput_, b, first);
+            vk::DeviceSize end = s + 1 == segmentCount ? totals[b]
+                                                       : bindingOffset(inputFormat_, indexedInput_, b, last);
+            if (end <= offset) {
+                end = totals[b];
+            }
+            bufferInfos[s][b] = {handles[b], offset, end - offset};
+        }
+
+        for (uint32_t b = 0; b < 11; b++) {
+            vk::WriteDescriptorSet write{};
+            write.setDstSet(*descriptorSets_[frameIndex][s]);
+            write.setDstBinding(b);
+            write.setDescriptorType(b == 0 ? vk::DescriptorType::eUniformBuffer
                                            : vk::DescriptorType::eStorageBuffer);
-        writes[i].setBufferInfo(bufferInfos[i]);
+            write.setBufferInfo(bufferInfos[s][b]);
+            writes.push_back(write);
+        }
     }
 
     context.Device().updateDescriptorSets(writes, {});
 }
 
 void ProjectionPass::Record(vk::CommandBuffer cmd) {
+    // cluster culling: 보이는 cluster 목록 + segment별 dispatch 인자를 먼저 만듦.
+    // proj.comp는 건너뛴 cluster의 행을 쓰지 않으므로 visibility / tileCount는 0으로 시작
+    const bool culled = clusterCulling_[currentFrame_] != 0;
+    if (culled) {
+        const vk::DeviceSize rowBytes = gaussianCount_ * sizeof(uint32_t);
+        cmd.fillBuffer(visibility_[currentFrame_], 0, rowBytes, 0);
+        cmd.fillBuffer(tileCount_[currentFrame_], 0, rowBytes, 0);
+
+        cullPass_.SetFrameIndex(currentFrame_);
+        cullPass_.SetParameters(planes_, (gaussianCount_ + 255) / 256,
+                                static_cast<uint32_t>(segmentSize_ / 256));
+        cullPass_.Record(cmd);
+    }
+    pushConstants_.clusterCulled = culled ? 1 : 0;
+
     cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_.GetHandle());
-    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
-                           pipeline_.GetLayout(), 0,
-                           *descriptorSets_[currentFrame_], {});
-    cmd.pushConstants(pipeline_.GetLayout(),
-                      vk::ShaderStageFlagBits::eCompute,
-                      0, sizeof(PushConstants), &pushConstants_);
-
-    uint32_t groupCount = (pushConstants_.gaussianCount + 255) / 256;
-    cmd.dispatch(groupCount, 1, 1);
+
+    // segment마다 descriptor set + 그 segment의 splat 수로 dispatch.
+    // workgroup이 maxComputeWorkGroupCount[0](최소 65535)를 넘으면 y로 접음 (proj.comp가 평탄화).
+    // culling이면 cull.comp가 센 보이는 cluster 수만큼 indirect dispatch
+    const auto& sets = descriptorSets_[currentFrame_];
+    for (uint32_t s = 0; s < sets.size() && s * segmentSize_ < gaussianCount_; s++) {
+        const uint64_t first = s * segmentSize_;
+        pushConstants_.gaussianCount = static_cast<uint32_t>(std::min(segmentSize_, gaussianCount_ - first));
+
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                               pipeline_.GetLayout(), 0,
+                               *sets[s], {});
+        cmd.pushConstants(pipeline_.GetLayout(),
+                          vk::ShaderStageFlagBits::eCompute,
+                          0, sizeof(PushConstants), &pushConstants_);
+
+        if (culled) {
+            cmd.dispatchIndirect(cullPass_.GetDispatchArgs(), s * ClusterCullPass::DISPATCH_ARGS_STRIDE);
+        } else {
+            const uint32_t groupCount = (pushConstants_.gaussianCount + 255) / 256;
+            const uint32_t groupsX    = std::min(groupCount, maxGroupsX_);
+            cmd.dispatch(groupsX, (groupCount + groupsX - 1) / groupsX, 1);
+        }
+    }
 
     // Compute → Compute 배리어 (후속 sort pass 대비)
     vk::MemoryBarrier barrier{};
@@ -2,11 +2,26 @@
 #include "Core.h"
 #include "ComputePass.h"
 #include "ComputePipeline.h"
+#include "ClusterCullPass.h"
 
 class Context;
 
 class ProjectionPass : public ComputePass {
 public:
+    // 입력 SOA 스트림(binding 1-5) 형식. proj.comp의 INPUT_FORMAT specialization constant 값.
+    //   Float32:   positions / f_dc / opacity / scale / rotation 모두 fp32
+    //   Float16:   positions만 fp32, 나머지는 packHalf 레이아웃
+    //   Quantized: QuantizedSplats 청크 양자화. binding 1 = position, 2 = color(rgb + alpha),
+    //              3 = QuantizedChunk 테이블, 4 = scale, 5 = rotation (모두 uint/splat)
+    //   Covariance: positions / f_dc fp32, 3 = sigmoid 적용된 opacity, 4 = 3D 공분산 6개
+    //              (Covariance.h), 5 = 사용 안 함 — 프레임마다 exp/쿼터니언/행렬곱 없음
+    enum class InputFormat : uint32_t {
+        Float32    = 0,
+        Float16    = 1,
+        Quantized  = 2,
+        Covariance = 3,
+    };
+
     struct Buffers {
         vk::Buffer positions;     // SSBO binding 1
         vk::Buffer sh;            // SSBO binding 2
@@ -16,6 +31,11 @@ public:
         vk::Buffer projected2D;   // SSBO binding 6 (output)
         vk::Buffer visibility;    // SSBO binding 7 (output)
         vk::Buffer tileCount;     // SSBO binding 8 (output)
+        vk::Buffer inputRows;     // SSBO binding 9: indexedInput일 때 출력 i가 읽을 입력 행 (아니면 null)
+        // cluster culling (셋 다 있고 indexedInput이 아닐 때만, 아니면 null): ClusterCullPass 참고
+        vk::Buffer clusterBounds;    // cluster마다 vec4 (center, radius)
+        vk::Buffer visibleClusters;  // SSBO binding 10: cluster마다 uint
+        vk::Buffer dispatchArgs;     // segment마다 ClusterCullPass::DISPATCH_ARGS_STRIDE (INDIRECT)
     };
 
     struct BufferSizes {
@@ -27,29 +47,78 @@ public:
         vk::DeviceSize projected2D;
         vk::DeviceSize visibility;
         vk::DeviceSize tileCount;
+        vk::DeviceSize inputRows;
+        vk::DeviceSize clusterBounds;
+        vk::DeviceSize visibleClusters;
+        vk::DeviceSize dispatchArgs;
     };
 
+    // gaussianCount는 segment 단위 (Record가 segment마다 채움)
     struct PushConstants {
         uint32_t gaussianCount;
         uint32_t tileWidth;
         uint32_t tileHeight;
+        uint32_t clusterCulled;  // Record가 채움
     };
 
+    // proj.comp의 Gaussian2D 크기 — 가장 큰 per-splat 스트림이라 segment 크기를 결정
+    static constexpr vk::DeviceSize GAUSSIAN_2D_STRIDE = 48;
+
+    // inputFormat / indexedInput은 파이프라인 생성 시 specialization으로 고정됨 (바꾸려면 pass를 다시 생성).
+    // indexedInput: 출력 i는 입력 행 inputRows[i]를 투영 (LOD cut). 입력 버퍼는 segment로 나누지 않고
+    // 전체를 binding하므로 각 입력 버퍼가 maxStorageBufferRange 안에 들어가야 함
     ProjectionPass(Context& context, const std::string& shaderPath,
-                   uint32_t framesInFlight);
+                   uint32_t framesInFlight, InputFormat inputFormat = InputFormat::Float32,
+                   bool indexedInput = false);
+
+    InputFormat GetInputFormat() const { return inputFormat_; }
+    bool IsIndexedInput() const { return indexedInput_; }
+
+    // cluster culling에 쓸 frustum 평면 (FrustumPlanes). culling 버퍼가 없으면 무시됨
+    void SetFrustum(const std::array<glm::vec4, 6>& planes) { planes_ = planes; }
 
+    // 버퍼는 하나씩이지만 maxStorageBufferRange를 넘을 수 있으므로 장면을 segment로 나눠
+    // segment마다 각 버퍼의 [offset, range) 구간을 binding한 descriptor set을 둠.
+    // capacity = 출력 버퍼에 들어가는 splat 수, sizes = 버퍼 전체 크기
     void UpdateDescriptors(Context& context, uint32_t frameIndex,
                            vk::Buffer cameraUbo, vk::DeviceSize uboSize,
-                           const Buffers& buffers, const BufferSizes& sizes);
+                           const Buffers& buffers, const BufferSizes& sizes, uint64_t capacity);
+
+    // segment 하나의 최대 splat 수 (SEGMENT_ALIGN의 배수). indirect dispatch는 y로 접을 수 없으므로
+    // workgroup 수가 maxComputeWorkGroupCount[0]을 넘지 않는 크기로 제한
+    uint64_t GetSegmentSize() const { return segmentSize_; }
 
     void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
-    void SetPushConstants(const PushConstants& pc) { pushConstants_ = pc; }
+    void SetPushConstants(uint64_t gaussianCount, uint32_t tileWidth, uint32_t tileHeight) {
+        gaussianCount_ = gaussianCount;
+        pushConstants_ = {0, tileWidth, tileHeight, 0};
+    }
     void Record(vk::CommandBuffer cmd) override;
 
 private:
+    // segment 경계의 모든 binding offset이 minStorageBufferOffsetAlignment(≤ 256)의 배수가
+    // 되도록: fp16 half 스트림, 256개 단위 청크 테이블(72 B)까지 포함
+    static constexpr uint64_t SEGMENT_ALIGN = 64 * 1024;
+
+    InputFormat inputFormat_;
+    bool indexedInput_;
     ComputePipeline pipeline_;
     vk::raii::DescriptorPool descriptorPool_          = nullptr;
-    std::vector<vk::raii::DescriptorSet> descriptorSets_;
+    uint32_t setsPerFrame_ = 0;  // 현재 pool이 frame마다 담을 수 있는 set 수
+    std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets_;  // [frame][segment]
+    uint64_t segmentSize_  = 0;
+    uint32_t maxGroupsX_   = 65535;  // maxComputeWorkGroupCount[0]
     uint32_t currentFrame_ = 0;
+    uint64_t gaussianCount_ = 0;
     PushConstants pushConstants_{};
+
+    // cluster culling: frame마다 켜짐 여부 + 건너뛴 cluster 행을 0으로 채울 출력 버퍼
+    ClusterCullPass cullPass_;
+    std::vector<uint8_t> clusterCulling_;
+    std::vector<vk::Buffer> visibility_;
+    std::vector<vk::Buffer> tileCount_;
+    std::array<glm::vec4, 6> planes_{};
+
+    void createDescriptorPool(Context& context, uint32_t framesInFlight, uint32_t setsPerFrame);
+    void allocateDescriptorSets(Context& context, uint32_t frameIndex, uint32_t segmentCount);
 };
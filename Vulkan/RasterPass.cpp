@@ -1,10 +1,160 @@
 #include "RasterPass.h"
+#include "ProjectionPass.h"
 #include "Context.h"
 
-RasterPass::RasterPass(Context& context, const std::string& shaderPath)
-    : pipeline_(context, shaderPath, {}) {
+uint64_t RasterPass::SegmentRows(const vk::PhysicalDeviceLimits& limits) {
+    return std::max<uint64_t>(SEGMENT_ALIGN,
+        limits.maxStorageBufferRange / ProjectionPass::GAUSSIAN_2D_STRIDE / SEGMENT_ALIGN * SEGMENT_ALIGN);
 }
 
-void RasterPass::Record(vk::CommandBuffer /*cmd*/) {
-    // TODO: per-tile rasterization (alpha-blended splats → framebuffer)
+uint64_t RasterPass::SegmentCount(const vk::PhysicalDeviceLimits& limits, uint64_t capacity) {
+    const uint64_t rows = SegmentRows(limits);
+    return std::max<uint64_t>(1, (capacity + rows - 1) / rows);
+}
+
+uint32_t RasterPass::MaxSegments(const vk::PhysicalDeviceLimits& limits) {
+    const uint32_t buffers = std::min(limits.maxPerStageDescriptorStorageBuffers,
+                                      limits.maxDescriptorSetStorageBuffers);
+    return buffers > 2 ? buffers - 2 : 0;
+}
+
+RasterPass::RasterPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight,
+                       uint32_t projectedSegments)
+    : projectedSegments_(projectedSegments),
+      specializationEntry_(0, 0, sizeof(uint32_t)),
+      specialization_(1, &specializationEntry_, sizeof(uint32_t), &projectedSegments_),
+      pipeline_(context, shaderPath,
+                // SSBOs (projected2D segment 배열, 정렬된 값, tile 구간) + 출력 storage image
+                std::vector<vk::DescriptorSetLayoutBinding>{
+                    {0, vk::DescriptorType::eStorageBuffer, projectedSegments, vk::ShaderStageFlagBits::eCompute},
+                    {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {3, vk::DescriptorType::eStorageImage, 1, vk::ShaderStageFlagBits::eCompute},
+                },
+                sizeof(PushConstants), &specialization_),
+      buffersBound_(framesInFlight, 0),
+      targets_(framesInFlight)
+{
+    segmentSize_ = SegmentRows(context.PhysicalDevice().getProperties().limits);
+
+    // frame마다 set 2개 (정렬 결과가 values[0] / values[1]인 경우)
+    const uint32_t maxSets = framesInFlight * 2;
+    std::array<vk::DescriptorPoolSize, 2> poolSizes = {
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageBuffer, maxSets * (projectedSegments_ + 2)},
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, maxSets},
+    };
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+    poolInfo.setMaxSets(maxSets);
+    poolInfo.setPoolSizes(poolSizes);
+    descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+
+    descriptorSets_.resize(framesInFlight);
+    for (auto& sets : descriptorSets_) {
+        std::array<vk::DescriptorSetLayout, 2> layouts = {
+            pipeline_.GetDescriptorSetLayout(), pipeline_.GetDescriptorSetLayout()};
+        vk::DescriptorSetAllocateInfo allocInfo{};
+        allocInfo.setDescriptorPool(*descriptorPool_);
+        allocInfo.setSetLayouts(layouts);
+        sets = context.Device().allocateDescriptorSets(allocInfo);
+    }
+}
+
+void RasterPass::UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                                   const BufferSizes& sizes) {
+    buffersBound_[frameIndex] = 1;
+
+    // segment 구간마다 하나. 용량은 App이 로드 시 projectedSegments_ 안으로 맞춤 (남는 원소는 마지막 segment)
+    const vk::DeviceSize segmentBytes = segmentSize_ * ProjectionPass::GAUSSIAN_2D_STRIDE;
+    const uint64_t segmentCount = std::min<uint64_t>(
+        projectedSegments_, std::max<uint64_t>(1, (sizes.projected2D + segmentBytes - 1) / segmentBytes));
+    std::vector<vk::DescriptorBufferInfo> projectedInfos(projectedSegments_);
+    for (uint32_t s = 0; s < projectedSegments_; s++) {
+        const vk::DeviceSize offset = std::min<uint64_t>(s, segmentCount - 1) * segmentBytes;
+        projectedInfos[s] = {buffers.projected2D, offset, std::min(segmentBytes, sizes.projected2D - offset)};
+    }
+
+    std::array<std::array<vk::DescriptorBufferInfo, 2>, 2> bufferInfos;
+    std::vector<vk::WriteDescriptorSet> writes;
+    for (uint32_t k = 0; k < 2; k++) {
+        vk::WriteDescriptorSet projected{};
+        projected.setDstSet(*descriptorSets_[frameIndex][k]);
+        projected.setDstBinding(0);
+        projected.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+        projected.setBufferInfo(projectedInfos);
+        writes.push_back(projected);
+
+        bufferInfos[k] = {
+            vk::DescriptorBufferInfo{buffers.values[k], 0, sizes.values},
+            vk::DescriptorBufferInfo{buffers.tileRanges, 0, sizes.tileRanges},
+        };
+        for (uint32_t b = 1; b < 3; b++) {
+            vk::WriteDescriptorSet write{};
+            write.setDstSet(*descriptorSets_[frameIndex][k]);
+            write.setDstBinding(b);
+            write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+            write.setBufferInfo(bufferInfos[k][b - 1]);
+            writes.push_back(write);
+        }
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void RasterPass::SetTarget(Context& context, uint32_t frameIndex, const Target& target) {
+    // view 값이 같아도 다시 씀: swapchain 재생성 뒤 새 view가 같은 handle을 받을 수 있음
+    targets_[frameIndex] = target;
+    if (!target.view) {
+        return;  // 출력 없음 (IsReady() == false)
+    }
+
+    vk::DescriptorImageInfo imageInfo{};
+    imageInfo.imageView   = target.view;
+    imageInfo.imageLayout = vk::ImageLayout::eGeneral;
+    std::array<vk::WriteDescriptorSet, 2> writes{};
+    for (uint32_t k = 0; k < 2; k++) {
+        writes[k].setDstSet(*descriptorSets_[frameIndex][k]);
+        writes[k].setDstBinding(3);
+        writes[k].setDescriptorType(vk::DescriptorType::eStorageImage);
+        writes[k].setImageInfo(imageInfo);
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void RasterPass::Record(vk::CommandBuffer cmd) {
+    if (!IsReady()) {
+        return;  // 아직 버퍼 / 출력 이미지 없음
+    }
+    const Target& target = targets_[currentFrame_];
+
+    // 모든 픽셀을 다시 쓰므로 이전 내용은 버림 (UNDEFINED → GENERAL).
+    // 이전 프레임의 읽기(transfer / compute)가 끝난 뒤에 쓰도록 실행 의존성만
+    vk::ImageMemoryBarrier toGeneral{};
+    toGeneral.srcAccessMask       = {};
+    toGeneral.dstAccessMask       = vk::AccessFlagBits::eShaderWrite;
+    toGeneral.oldLayout           = vk::ImageLayout::eUndefined;
+    toGeneral.newLayout           = vk::ImageLayout::eGeneral;
+    toGeneral.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toGeneral.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toGeneral.image               = target.image;
+    toGeneral.subresourceRange    = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+        vk::PipelineStageFlagBits::eComputeShader,
+        {}, {}, {}, toGeneral
+    );
+
+    const PushConstants push{
+        (target.extent.width + TILE_SIZE - 1) / TILE_SIZE,
+        (target.extent.height + TILE_SIZE - 1) / TILE_SIZE,
+        target.swapRedBlue ? 1u : 0u,
+        static_cast<uint32_t>(segmentSize_),
+    };
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_.GetHandle());
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                           pipeline_.GetLayout(), 0,
+                           *descriptorSets_[currentFrame_][resultIndex_], {});
+    cmd.pushConstants(pipeline_.GetLayout(),
+                      vk::ShaderStageFlagBits::eCompute,
+                      0, sizeof(PushConstants), &push);
+    cmd.dispatch(push.tileWidth, push.tileHeight, 1);
 }
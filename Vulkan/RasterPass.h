@@ -1,14 +1,101 @@
 #pragma once
+#include "Core.h"
 #include "ComputePass.h"
 #include "ComputePipeline.h"
 
 class Context;
 
+// Tile 기반 compute rasterizer (rast.comp). workgroup 하나가 16×16 tile 하나를 맡아 그 tile의 정렬된
+// 구간(TileRangePass)을 BATCH_SIZE개씩 shared memory로 함께 읽고, 픽셀마다 conic을 평가해
+// 앞에서부터 alpha blending. 투과율이 임계값 아래로 내려간 픽셀은 멈추고, tile의 모든 픽셀이
+// 끝나면 workgroup이 남은 batch를 건너뜀. 결과는 storage image(RGBA8)에 기록.
+// projected2D는 maxStorageBufferRange를 넘을 수 있으므로 segment 구간들을 binding 0의 배열로 binding하고,
+// 정렬된 값(전체 index)을 index / segmentRows로 나눠 segment를 고름. 배열 크기(segment 수)는
+// specialization으로 고정되므로 출력 버퍼 용량이 segment 수를 바꾸면 pass를 다시 생성.
+//
+// Usage:
+//   RasterPass raster(context, "Shaders/rast.comp.spv", framesInFlight,
+//                     RasterPass::SegmentCount(limits, capacity));   // ≤ MaxSegments(limits)
+//   raster.UpdateDescriptors(context, frame, buffers, sizes);
+//   raster.SetTarget(context, frame, {image, view, extent});   // GENERAL로 전환 후 기록
+//   raster.SetResultIndex(sort.GetResultIndex());
+//   if (raster.IsReady()) raster.Record(cmd);   // 끝나면 이미지는 GENERAL, 셰이더 쓰기는 호출자가 배리어로 넘김
 class RasterPass : public ComputePass {
 public:
-    RasterPass(Context& context, const std::string& shaderPath);
+    static constexpr uint32_t TILE_SIZE  = 16;
+    static constexpr uint32_t BATCH_SIZE = TILE_SIZE * TILE_SIZE;  // rast.comp와 일치
+    // rast.comp의 image format (rgba8)
+    static constexpr vk::Format OUTPUT_FORMAT = vk::Format::eR8G8B8A8Unorm;
+
+    struct Buffers {
+        vk::Buffer projected2D;            // ProjectionPass 출력
+        std::array<vk::Buffer, 2> values;  // SortPass values[0] / values[1] (결과 쪽은 SetResultIndex)
+        vk::Buffer tileRanges;             // TileRangePass 출력
+    };
+
+    struct BufferSizes {
+        vk::DeviceSize projected2D;
+        vk::DeviceSize values;
+        vk::DeviceSize tileRanges;
+    };
+
+    struct Target {
+        vk::Image image;       // STORAGE usage, OUTPUT_FORMAT과 호환되는 view
+        vk::ImageView view;
+        vk::Extent2D extent;
+        bool swapRedBlue = false;  // R/B를 바꿔 기록 (BGRA swapchain으로 vkCmdCopyImage할 때)
+    };
+
+    struct PushConstants {
+        uint32_t tileWidth;
+        uint32_t tileHeight;
+        uint32_t swapRedBlue;
+        uint32_t segmentRows;  // projected2D segment 하나의 splat 수
+    };
+
+    // projectedSegments: binding 0의 배열 크기 (rast.comp의 constant_id = 0)
+    RasterPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight,
+               uint32_t projectedSegments = 1);
+
+    // segment 하나의 splat 수: Gaussian2D 구간이 maxStorageBufferRange에 들어가는 SEGMENT_ALIGN의 배수
+    static uint64_t SegmentRows(const vk::PhysicalDeviceLimits& limits);
+    // capacity개 splat의 projected2D에 필요한 segment 수
+    static uint64_t SegmentCount(const vk::PhysicalDeviceLimits& limits, uint64_t capacity);
+    // binding 0에 둘 수 있는 최대 segment 수 (storage buffer descriptor 한도에서 binding 1, 2를 뺀 값)
+    static uint32_t MaxSegments(const vk::PhysicalDeviceLimits& limits);
+
+    uint32_t GetProjectedSegments() const { return projectedSegments_; }
+
+    // projected2D를 segment로 나눠 binding (sizes.projected2D는 projectedSegments개 안에 들어가야 함)
+    void UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                           const BufferSizes& sizes);
+    // 출력 이미지 (binding 3). 그 frame 슬롯의 set이 사용 중이 아닐 때만 (fence 대기 후).
+    // Renderer가 매 프레임 설정 (Direct present면 acquire한 swapchain 이미지)
+    void SetTarget(Context& context, uint32_t frameIndex, const Target& target);
+
+    void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
+    void SetResultIndex(uint32_t resultIndex) { resultIndex_ = resultIndex; }
+
+    // 현재 frame에 버퍼와 출력 이미지가 모두 있는지 (없으면 Record는 아무것도 기록하지 않음)
+    bool IsReady() const { return buffersBound_[currentFrame_] && targets_[currentFrame_].view; }
+
     void Record(vk::CommandBuffer cmd) override;
 
 private:
+    // pipeline_보다 먼저 초기화되어야 함 (specialization 데이터)
+    uint32_t projectedSegments_;
+    vk::SpecializationMapEntry specializationEntry_;
+    vk::SpecializationInfo specialization_;
     ComputePipeline pipeline_;
+    vk::raii::DescriptorPool descriptorPool_ = nullptr;
+    // [frame][k] = values[k]를 읽는 set
+    std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets_;
+    std::vector<uint8_t> buffersBound_;
+    std::vector<Target> targets_;
+    uint64_t segmentSize_  = 0;  // SEGMENT_ALIGN의 배수, Gaussian2D 구간이 maxStorageBufferRange 안
+    uint32_t currentFrame_ = 0;
+    uint32_t resultIndex_  = 0;
+
+    // segment 경계가 minStorageBufferOffsetAlignment(≤ 256)의 배수가 되도록 (ProjectionPass와 같음)
+    static constexpr uint64_t SEGMENT_ALIGN = 64 * 1024;
 };
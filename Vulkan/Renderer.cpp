@@ -1,40 +1,41 @@
 #include "Renderer.h"
 #include "Buffer.h"
+#include "Image.h"
 #include "Context.h"
 #include "Swapchain.h"
-#include "Pipeline.h"
 #include "ComputePass.h"
+#include "RasterPass.h"
+#include "UploadManager.h"
 
 // ---------------------------------------------------------------------------
 // Constructor
 // ---------------------------------------------------------------------------
 
-Renderer::Renderer(Context& context, Swapchain& swapchain,
-                   Pipeline& pipeline, CommandManager& commands) {
-    createFramebuffers(context, swapchain, pipeline);
+Renderer::Renderer(Context& context, Swapchain& swapchain, CommandManager& commands)
+    : presentPath_(choosePresentPath(swapchain)) {
     createSyncObjects(context, swapchain.GetImageCount());
+    createTimestampPool(context);
 }
 
 // ---------------------------------------------------------------------------
-// createFramebuffers
+// choosePresentPath
 // ---------------------------------------------------------------------------
 
-void Renderer::createFramebuffers(Context& context, Swapchain& swapchain,
-                                  Pipeline& pipeline) {
-    const auto& imageViews = swapchain.GetImageViews();
-    framebuffers_.reserve(imageViews.size());
-
-    for (const auto& imageView : imageViews) {
-        vk::ImageView attachments[] = { *imageView };
-
-        vk::FramebufferCreateInfo framebufferInfo{};
-        framebufferInfo.setRenderPass(pipeline.GetRenderPass());
-        framebufferInfo.setAttachments(attachments);
-        framebufferInfo.setWidth(swapchain.GetExtent().width);
-        framebufferInfo.setHeight(swapchain.GetExtent().height);
-        framebufferInfo.setLayers(1);
-
-        framebuffers_.emplace_back(context.Device(), framebufferInfo);
+Renderer::PresentPath Renderer::choosePresentPath(const Swapchain& swapchain) {
+    if (swapchain.GetUsage() & vk::ImageUsageFlagBits::eStorage) {
+        return PresentPath::Direct;
+    }
+    if (!(swapchain.GetUsage() & vk::ImageUsageFlagBits::eTransferDst)) {
+        throw std::runtime_error("Swapchain supports neither storage nor transfer-dst usage");
+    }
+    switch (swapchain.GetFormat()) {
+        case vk::Format::eR8G8B8A8Unorm:
+        case vk::Format::eR8G8B8A8Srgb:
+        case vk::Format::eB8G8R8A8Unorm:
+        case vk::Format::eB8G8R8A8Srgb:
+            return PresentPath::Copy;
+        default:
+            return PresentPath::Blit;
     }
 }
 
@@ -62,42 +63,202 @@ void Renderer::createSyncObjects(Context& context, uint32_t swapchainImageCount)
     }
 }
 
+// ---------------------------------------------------------------------------
+// createTimestampPool / readTimestamps
+// ---------------------------------------------------------------------------
+
+void Renderer::createTimestampPool(Context& context) {
+    auto properties = context.PhysicalDevice().getProperties();
+    auto families   = context.PhysicalDevice().getQueueFamilyProperties();
+    if (families[context.GetGraphicsQueueFamily()].timestampValidBits == 0 ||
+        properties.limits.timestampPeriod == 0.0f) {
+        return;
+    }
+    timestampPeriodNs_ = properties.limits.timestampPeriod;
+
+    vk::QueryPoolCreateInfo poolInfo{};
+    poolInfo.setQueryType(vk::QueryType::eTimestamp);
+    poolInfo.setQueryCount(TIMESTAMPS_PER_FRAME * FRAMES_IN_FLIGHT);
+    timestampPool_ = context.Device().createQueryPool(poolInfo);
+}
+
+void Renderer::readTimestamps() {
+    if (!*timestampPool_ || !timestampsPending_[currentFrame_]) {
+        return;
+    }
+    timestampsPending_[currentFrame_] = false;
+
+    // fence 대기 후이므로 결과가 이미 있음 (eWait 불필요)
+    auto [result, ticks] = timestampPool_.getResults<uint64_t>(
+        currentFrame_ * TIMESTAMPS_PER_FRAME, TIMESTAMPS_PER_FRAME,
+        TIMESTAMPS_PER_FRAME * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+    if (result != vk::Result::eSuccess) {
+        return;
+    }
+    auto ms = [&](uint32_t begin, uint32_t end) {
+        return static_cast<double>(ticks[end] - ticks[begin]) * timestampPeriodNs_ * 1e-6;
+    };
+    passTimings_.projMs   = ms(0, 1);
+    passTimings_.binMs    = ms(1, 2);
+    passTimings_.sortMs   = ms(2, 3);
+    passTimings_.rangesMs = ms(3, 4);
+    passTimings_.rasterMs = ms(4, 5);
+    passTimings_.valid    = true;
+}
+
 // ---------------------------------------------------------------------------
 // recordCommandBuffer
 // ---------------------------------------------------------------------------
 
-void Renderer::recordCommandBuffer(vk::CommandBuffer cmd, uint32_t imageIndex,
-                                   Swapchain& swapchain, Pipeline& pipeline,
-                                   Buffer* uboStaging, Buffer* uboDevice,
-                                   ComputePass* projPass, ComputePass* sortPass,
-                                   ComputePass* rasterPass) {
+uint64_t Renderer::recordCommandBuffer(vk::CommandBuffer cmd, vk::CommandBuffer presentCmd, uint32_t imageIndex,
+                                       Swapchain& swapchain,
+                                       Buffer* uboStaging, Buffer* uboDevice,
+                                       UploadManager* uploads, ComputePass* projPass,
+                                       ComputePass* binPass, ComputePass* sortPass,
+                                       ComputePass* rangePass, RasterPass* rasterPass,
+                                       Image* rasterImage) {
     vk::CommandBufferBeginInfo beginInfo{};
     cmd.begin(beginInfo);
 
+    // Transfer 큐에서 끝난 업로드의 소유권 acquire (compute pass보다 먼저)
+    uint64_t uploadWait = uploads ? uploads->RecordAcquires(cmd) : 0;
+
     // Staging → Device UBO copy
     if (uboStaging && uboDevice) {
         uboStaging->RecordCopy(cmd, *uboDevice);
     }
 
-    // ─── Compute passes ───
+    // ─── Compute passes (pass 경계마다 timestamp) ───
+    const uint32_t firstQuery = currentFrame_ * TIMESTAMPS_PER_FRAME;
+    auto timestamp = [&](uint32_t index) {
+        if (*timestampPool_) {
+            cmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *timestampPool_, firstQuery + index);
+        }
+    };
+    if (*timestampPool_) {
+        cmd.resetQueryPool(*timestampPool_, firstQuery, TIMESTAMPS_PER_FRAME);
+        timestampsPending_[currentFrame_] = true;
+    }
+
+    timestamp(0);
     if (projPass)   projPass->Record(cmd);
+    timestamp(1);
+    if (binPass)    binPass->Record(cmd);
+    timestamp(2);
     if (sortPass)   sortPass->Record(cmd);
-    if (rasterPass) rasterPass->Record(cmd);
+    timestamp(3);
+    if (rangePass)  rangePass->Record(cmd);
+    timestamp(4);
+    cmd.end();
 
-    // ─── Render pass ───
-    vk::ClearValue clearColor{vk::ClearColorValue{std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}}};
+    // ─── Raster + present: 이 command buffer만 swapchain acquire를 기다림 ───
+    // (앞 command buffer의 pass 끝 배리어는 제출 순서상 뒤인 이 명령들에도 적용됨)
+    presentCmd.begin(beginInfo);
+    const bool rasterized = rasterPass && rasterPass->IsReady();
+    if (rasterized) rasterPass->Record(presentCmd);
+    if (*timestampPool_) {
+        presentCmd.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *timestampPool_, firstQuery + 5);
+    }
 
-    vk::RenderPassBeginInfo renderPassInfo{};
-    renderPassInfo.setRenderPass(pipeline.GetRenderPass());
-    renderPassInfo.setFramebuffer(*framebuffers_[imageIndex]);
-    renderPassInfo.renderArea.offset = vk::Offset2D{0, 0};
-    renderPassInfo.renderArea.extent = swapchain.GetExtent();
-    renderPassInfo.setClearValues(clearColor);
+    // ─── Present: render pass 없이 raster 출력을 swapchain 이미지로 ───
+    recordPresent(presentCmd, swapchain.GetImages()[imageIndex], swapchain, rasterImage, rasterized);
+    presentCmd.end();
 
-    cmd.beginRenderPass(renderPassInfo, vk::SubpassContents::eInline);
-    // TODO: fullscreen quad (graphics pipeline + draw call)
-    cmd.endRenderPass();
-    cmd.end();
+    return uploadWait;
+}
+
+// ---------------------------------------------------------------------------
+// recordPresent
+// ---------------------------------------------------------------------------
+
+void Renderer::recordPresent(vk::CommandBuffer cmd, vk::Image swapchainImage,
+                             Swapchain& swapchain, Image* rasterImage, bool rasterized) {
+    auto imageBarrier = [](vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
+                           vk::AccessFlags srcAccess, vk::AccessFlags dstAccess) {
+        vk::ImageMemoryBarrier barrier{};
+        barrier.srcAccessMask       = srcAccess;
+        barrier.dstAccessMask       = dstAccess;
+        barrier.oldLayout           = oldLayout;
+        barrier.newLayout           = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image               = image;
+        barrier.subresourceRange    = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+        return barrier;
+    };
+
+    // Direct: raster가 swapchain 이미지(GENERAL)에 이미 기록함 → 전환만
+    if (rasterized && presentPath_ == PresentPath::Direct) {
+        cmd.pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eBottomOfPipe,
+            {}, {}, {},
+            imageBarrier(swapchainImage, vk::ImageLayout::eGeneral, vk::ImageLayout::ePresentSrcKHR,
+                         vk::AccessFlagBits::eShaderWrite, {}));
+        return;
+    }
+
+    // 장면이 없는데 TRANSFER_DST도 안 되는 swapchain (Direct 전용): 내용 없이 전환만
+    if (!(swapchain.GetUsage() & vk::ImageUsageFlagBits::eTransferDst)) {
+        cmd.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe,
+            {}, {}, {},
+            imageBarrier(swapchainImage, vk::ImageLayout::eUndefined, vk::ImageLayout::ePresentSrcKHR,
+                         {}, {}));
+        return;
+    }
+
+    // swapchain 이미지는 이전 내용을 버리고 TRANSFER_DST로 (acquire 대기는 transfer 단계),
+    // raster 이미지는 셰이더 쓰기를 끝내고 TRANSFER_SRC로
+    std::vector<vk::ImageMemoryBarrier> toTransfer = {
+        imageBarrier(swapchainImage, vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal,
+                     {}, vk::AccessFlagBits::eTransferWrite),
+    };
+    if (rasterized) {
+        toTransfer.push_back(
+            imageBarrier(rasterImage->GetHandle(), vk::ImageLayout::eGeneral,
+                         vk::ImageLayout::eTransferSrcOptimal,
+                         vk::AccessFlagBits::eShaderWrite, vk::AccessFlagBits::eTransferRead));
+    }
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+        vk::PipelineStageFlagBits::eTransfer,
+        {}, {}, {}, toTransfer);
+
+    const vk::ImageSubresourceLayers colorLayers{vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+    const vk::Extent2D extent{
+        std::min(rasterImage ? rasterImage->GetExtent().width : 0u, swapchain.GetExtent().width),
+        std::min(rasterImage ? rasterImage->GetExtent().height : 0u, swapchain.GetExtent().height),
+    };
+    if (!rasterized) {
+        // 장면 없음: 검정
+        vk::ClearColorValue black{std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f}};
+        cmd.clearColorImage(swapchainImage, vk::ImageLayout::eTransferDstOptimal, black,
+                            vk::ImageSubresourceRange{vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1});
+    } else if (presentPath_ == PresentPath::Copy) {
+        // 같은 32비트 계열이라 바이트 그대로 (sRGB 재인코딩 없음, BGRA면 raster가 R/B를 바꿔 씀)
+        vk::ImageCopy region{};
+        region.srcSubresource = colorLayers;
+        region.dstSubresource = colorLayers;
+        region.extent         = vk::Extent3D{extent.width, extent.height, 1};
+        cmd.copyImage(rasterImage->GetHandle(), vk::ImageLayout::eTransferSrcOptimal,
+                      swapchainImage, vk::ImageLayout::eTransferDstOptimal, region);
+    } else {
+        vk::ImageBlit region{};
+        region.srcSubresource = colorLayers;
+        region.dstSubresource = colorLayers;
+        region.srcOffsets[1]  = vk::Offset3D{static_cast<int32_t>(extent.width),
+                                             static_cast<int32_t>(extent.height), 1};
+        region.dstOffsets[1]  = region.srcOffsets[1];
+        cmd.blitImage(rasterImage->GetHandle(), vk::ImageLayout::eTransferSrcOptimal,
+                      swapchainImage, vk::ImageLayout::eTransferDstOptimal, region,
+                      vk::Filter::eNearest);
+    }
+
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eBottomOfPipe,
+        {}, {}, {},
+        imageBarrier(swapchainImage, vk::ImageLayout::eTransferDstOptimal,
+                     vk::ImageLayout::ePresentSrcKHR, vk::AccessFlagBits::eTransferWrite, {}));
 }
 
 // ---------------------------------------------------------------------------
@@ -107,13 +268,14 @@ void Renderer::recordCommandBuffer(vk::CommandBuffer cmd, uint32_t imageIndex,
 void Renderer::WaitForCurrentFrame(Context& context) {
     context.Device().waitForFences(
         *inFlight_[currentFrame_], VK_TRUE, UINT64_MAX);
+    readTimestamps();
 }
 
-bool Renderer::DrawFrame(Context& context, Swapchain& swapchain,
-                         Pipeline& pipeline, CommandManager& commands,
-                         Buffer* uboStaging, Buffer* uboDevice,
-                         ComputePass* projPass, ComputePass* sortPass,
-                         ComputePass* rasterPass) {
+bool Renderer::DrawFrame(Context& context, Swapchain& swapchain, CommandManager& commands,
+                         Buffer* uboStaging, Buffer* uboDevice, UploadManager* uploads,
+                         ComputePass* projPass, ComputePass* binPass,
+                         ComputePass* sortPass, ComputePass* rangePass,
+                         RasterPass* rasterPass, Image* rasterImage) {
     // Fence already waited by WaitForCurrentFrame() before UBO upload
 
     // Acquire next swapchain image
@@ -126,24 +288,62 @@ bool Renderer::DrawFrame(Context& context, Swapchain& swapchain,
 
     context.Device().resetFences(*inFlight_[currentFrame_]);
 
+    // raster 출력 대상: Direct면 방금 받은 swapchain 이미지, 아니면 frame별 raster 이미지
+    // (BGRA swapchain으로 복사할 때는 raster가 R/B를 바꿔 기록)
+    if (rasterPass) {
+        RasterPass::Target target{};
+        if (presentPath_ == PresentPath::Direct) {
+            target = {swapchain.GetImages()[imageIndex], *swapchain.GetImageViews()[imageIndex],
+                      swapchain.GetExtent()};
+        } else if (rasterImage) {
+            const bool bgra = swapchain.GetFormat() == vk::Format::eB8G8R8A8Unorm ||
+                              swapchain.GetFormat() == vk::Format::eB8G8R8A8Srgb;
+            target = {rasterImage->GetHandle(), rasterImage->GetView(), rasterImage->GetExtent(),
+                      presentPath_ == PresentPath::Copy && bgra};
+        }
+        rasterPass->SetTarget(context, currentFrame_, target);
+    }
+
     // Record command buffer
-    auto& cmdBuffers = commands.GetCommandBuffers();
+    auto& cmdBuffers     = commands.GetCommandBuffers();
+    auto& presentBuffers = commands.GetPresentCommandBuffers();
     cmdBuffers[currentFrame_].reset();
-    recordCommandBuffer(*cmdBuffers[currentFrame_], imageIndex,
-                        swapchain, pipeline,
-                        uboStaging, uboDevice,
-                        projPass, sortPass, rasterPass);
-
-    // Submit
-    vk::PipelineStageFlags waitStage = vk::PipelineStageFlagBits::eColorAttachmentOutput;
+    presentBuffers[currentFrame_].reset();
+    uint64_t uploadWait = recordCommandBuffer(*cmdBuffers[currentFrame_], *presentBuffers[currentFrame_],
+                                              imageIndex,
+                                              swapchain,
+                                              uboStaging, uboDevice,
+                                              uploads, projPass, binPass, sortPass,
+                                              rangePass, rasterPass, rasterImage);
+
+    // Submit — 두 batch를 한 번에: compute pass(projection ~ tile 구간)는 acquire를 기다리지 않고
+    // 이전 프레임의 present와 겹쳐 실행, raster + present batch만 swapchain 이미지를 처음 건드리는
+    // 단계에서 acquire 대기 (Direct면 raster의 compute, 장면이 없으면 clear / 복사의 transfer).
+    // acquire한 업로드가 있으면 첫 batch가 upload timeline을 대기 (compute 단계에서)
+    const vk::PipelineStageFlags acquireStage = presentPath_ == PresentPath::Direct
+        ? vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer
+        : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTransfer);
+    const vk::PipelineStageFlags uploadStage = vk::PipelineStageFlagBits::eComputeShader;
+
+    const vk::Semaphore uploadSemaphore = uploadWait > 0 ? uploads->GetTimeline() : vk::Semaphore{};
+    vk::TimelineSemaphoreSubmitInfo uploadTimeline{};
+    uploadTimeline.setWaitSemaphoreValues(uploadWait);
+    vk::SubmitInfo computeSubmit{};
+    if (uploadWait > 0) {
+        computeSubmit.setPNext(&uploadTimeline);
+        computeSubmit.setWaitSemaphores(uploadSemaphore);
+        computeSubmit.setWaitDstStageMask(uploadStage);
+    }
+    computeSubmit.setCommandBuffers(*cmdBuffers[currentFrame_]);
 
-    vk::SubmitInfo submitInfo{};
-    submitInfo.setWaitSemaphores(*imageAvailable_[currentFrame_]);
-    submitInfo.setWaitDstStageMask(waitStage);
-    submitInfo.setCommandBuffers(*cmdBuffers[currentFrame_]);
-    submitInfo.setSignalSemaphores(*renderFinished_[imageIndex]);
+    vk::SubmitInfo presentSubmit{};
+    presentSubmit.setWaitSemaphores(*imageAvailable_[currentFrame_]);
+    presentSubmit.setWaitDstStageMask(acquireStage);
+    presentSubmit.setCommandBuffers(*presentBuffers[currentFrame_]);
+    presentSubmit.setSignalSemaphores(*renderFinished_[imageIndex]);
 
-    context.GetGraphicsQueue().submit(submitInfo, *inFlight_[currentFrame_]);
+    const std::array<vk::SubmitInfo, 2> submits = {computeSubmit, presentSubmit};
+    context.GetGraphicsQueue().submit(submits, *inFlight_[currentFrame_]);
 
     // Present
     vk::SwapchainKHR swapchains[] = { *swapchain.GetHandle() };
@@ -170,13 +370,11 @@ bool Renderer::DrawFrame(Context& context, Swapchain& swapchain,
 }
 
 // ---------------------------------------------------------------------------
-// RecreateFramebuffers
+// RecreateSwapchainResources
 // ---------------------------------------------------------------------------
 
-void Renderer::RecreateFramebuffers(Context& context, Swapchain& swapchain,
-                                    Pipeline& pipeline) {
-    framebuffers_.clear();
-    createFramebuffers(context, swapchain, pipeline);
+void Renderer::RecreateSwapchainResources(Context& context, Swapchain& swapchain) {
+    presentPath_ = choosePresentPath(swapchain);
 
     // Recreate per-image semaphores (image count may change)
     vk::SemaphoreCreateInfo semaphoreInfo{};
@@ -4,47 +4,89 @@
 
 class Context;
 class Swapchain;
-class Pipeline;
 class Buffer;
+class Image;
 class ComputePass;
+class RasterPass;
+class UploadManager;
 
 class Renderer {
 public:
-    Renderer(Context& context, Swapchain& swapchain,
-             Pipeline& pipeline, CommandManager& commands);
+    // 마지막으로 완료된 프레임의 compute pass GPU 시간 (timestamp query)
+    struct PassTimings {
+        double projMs   = 0.0;
+        double binMs    = 0.0;
+        double sortMs   = 0.0;
+        double rangesMs = 0.0;
+        double rasterMs = 0.0;
+        bool valid      = false;  // timestamp 미지원이거나 아직 완료된 프레임이 없으면 false
+    };
+
+    // raster 출력을 swapchain 이미지로 올리는 방법 (swapchain 형식 / usage로 결정)
+    enum class PresentPath {
+        Direct,  // STORAGE swapchain: raster가 swapchain 이미지에 바로 기록, 전환만
+        Copy,    // 8비트 RGBA / BGRA swapchain: raster 이미지를 vkCmdCopyImage (변환 없음)
+        Blit,    // 그 외 형식: vkCmdBlitImage로 형식 변환
+    };
+
+    Renderer(Context& context, Swapchain& swapchain, CommandManager& commands);
 
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
     // Returns true if swapchain needs recreation
-    bool DrawFrame(Context& context, Swapchain& swapchain,
-                   Pipeline& pipeline, CommandManager& commands,
-                   Buffer* uboStaging, Buffer* uboDevice,
-                   ComputePass* projPass, ComputePass* sortPass, ComputePass* rasterPass);
+    // rasterImage: Direct가 아닐 때 raster가 기록할 중간 이미지 (RasterPass::OUTPUT_FORMAT)
+    bool DrawFrame(Context& context, Swapchain& swapchain, CommandManager& commands,
+                   Buffer* uboStaging, Buffer* uboDevice, UploadManager* uploads,
+                   ComputePass* projPass, ComputePass* binPass, ComputePass* sortPass,
+                   ComputePass* rangePass, RasterPass* rasterPass, Image* rasterImage);
+
+    // swapchain 재생성 후: image별 semaphore와 present 경로를 다시 만듦
+    void RecreateSwapchainResources(Context& context, Swapchain& swapchain);
 
-    void RecreateFramebuffers(Context& context, Swapchain& swapchain,
-    Pipeline& pipeline);
+    // Direct면 App은 raster 이미지를 만들지 않음
+    PresentPath GetPresentPath() const { return presentPath_; }
 
     uint32_t GetCurrentFrame() const { return currentFrame_; }
 
     // Wait for current frame's fence (call before writing to per-frame resources)
+    // 이 프레임 슬롯이 이전에 기록한 timestamp도 여기서 읽음
     void WaitForCurrentFrame(Context& context);
 
+    const PassTimings& GetPassTimings() const { return passTimings_; }
+
 private:
     static constexpr uint32_t FRAMES_IN_FLIGHT = CommandManager::FRAMES_IN_FLIGHT;
 
-    std::vector<vk::raii::Framebuffer> framebuffers_;
+    PresentPath presentPath_ = PresentPath::Copy;
 
     std::vector<vk::raii::Semaphore> imageAvailable_;
     std::vector<vk::raii::Semaphore> renderFinished_;
     std::vector<vk::raii::Fence> inFlight_;
     uint32_t currentFrame_ = 0;
 
-    void createFramebuffers(Context& context, Swapchain& swapchain, Pipeline& pipeline);
+    // Frame마다 pass 경계 6개 (proj 전, proj 후, binning 후, sort 후, tile 구간 후, raster 후)
+    static constexpr uint32_t TIMESTAMPS_PER_FRAME = 6;
+    vk::raii::QueryPool timestampPool_ = nullptr;  // graphics 큐가 timestamp를 지원할 때만
+    double timestampPeriodNs_ = 0.0;
+    std::array<bool, FRAMES_IN_FLIGHT> timestampsPending_{};
+    PassTimings passTimings_;
+
+    void createTimestampPool(Context& context);
+    void readTimestamps();
+
+    static PresentPath choosePresentPath(const Swapchain& swapchain);
     void createSyncObjects(Context& context, uint32_t swapchainImageCount);
-    void recordCommandBuffer(vk::CommandBuffer cmd, uint32_t imageIndex,
-                             Swapchain& swapchain, Pipeline& pipeline,
-                             Buffer* uboStaging, Buffer* uboDevice,
-                             ComputePass* projPass, ComputePass* sortPass,
-                             ComputePass* rasterPass);
+    // cmd: UBO 복사 + projection ~ tile 구간, presentCmd: raster + swapchain 이미지로 올리기.
+    // Returns the upload timeline value the submit must wait for (0 = none)
+    uint64_t recordCommandBuffer(vk::CommandBuffer cmd, vk::CommandBuffer presentCmd, uint32_t imageIndex,
+                                 Swapchain& swapchain,
+                                 Buffer* uboStaging, Buffer* uboDevice,
+                                 UploadManager* uploads, ComputePass* projPass,
+                                 ComputePass* binPass, ComputePass* sortPass,
+                                 ComputePass* rangePass, RasterPass* rasterPass,
+                                 Image* rasterImage);
+    // raster 출력(또는 장면이 없으면 검정)을 swapchain 이미지에 올리고 PRESENT_SRC로 전환
+    void recordPresent(vk::CommandBuffer cmd, vk::Image swapchainImage, Swapchain& swapchain,
+                       Image* rasterImage, bool rasterized);
 };
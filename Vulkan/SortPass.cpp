@@ -1,10 +1,137 @@
 #include "SortPass.h"
 #include "Context.h"
 
-SortPass::SortPass(Context& context, const std::string& shaderPath)
-    : pipeline_(context, shaderPath, {}) {
+// sort.comp의 constant_id = 0 (STAGE). 파이프라인 생성 동안만 참조되지만 static에 둠.
+static const vk::SpecializationInfo* stageSpecialization(uint32_t stage) {
+    static const uint32_t kValues[3] = {0, 1, 2};
+    static const vk::SpecializationMapEntry kEntry{0, 0, sizeof(uint32_t)};
+    static const vk::SpecializationInfo kInfos[3] = {
+        {1, &kEntry, sizeof(uint32_t), &kValues[0]},
+        {1, &kEntry, sizeof(uint32_t), &kValues[1]},
+        {1, &kEntry, sizeof(uint32_t), &kValues[2]},
+    };
+    return &kInfos[stage];
 }
 
-void SortPass::Record(vk::CommandBuffer /*cmd*/) {
-    // TODO: radix sort by (tile_id, depth)
+// 세 stage 모두 같은 layout: keysIn, valuesIn, keysOut, valuesOut, histograms, count
+static std::vector<vk::DescriptorSetLayoutBinding> sortBindings() {
+    std::vector<vk::DescriptorSetLayoutBinding> bindings;
+    for (uint32_t b = 0; b < 6; b++) {
+        bindings.push_back({b, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute});
+    }
+    return bindings;
+}
+
+// Downsweep은 subgroup마다 digit 개수를 shared에 모으므로 workgroup(256)당 subgroup이 32개 이하여야 함.
+// 파이프라인 생성 전에 확인하도록 첫 멤버 초기화에서 호출
+static Context& requireSubgroupBallot(Context& context) {
+    auto chain = context.PhysicalDevice().getProperties2<vk::PhysicalDeviceProperties2,
+                                                         vk::PhysicalDeviceSubgroupProperties>();
+    const auto& subgroup = chain.get<vk::PhysicalDeviceSubgroupProperties>();
+    if (!(subgroup.supportedStages & vk::ShaderStageFlagBits::eCompute) ||
+        !(subgroup.supportedOperations & vk::SubgroupFeatureFlagBits::eBallot) ||
+        subgroup.subgroupSize < 8) {
+        throw std::runtime_error("GPU radix sort requires subgroup ballot in compute with subgroups of 8+");
+    }
+    return context;
+}
+
+SortPass::SortPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight)
+    : upsweep_(requireSubgroupBallot(context), shaderPath, sortBindings(),
+               sizeof(PushConstants), stageSpecialization(0)),
+      scan_(context, shaderPath, sortBindings(), sizeof(PushConstants), stageSpecialization(1)),
+      downsweep_(context, shaderPath, sortBindings(), sizeof(PushConstants), stageSpecialization(2)),
+      histograms_(framesInFlight),
+      capacities_(framesInFlight, 0)
+{
+    maxGroupsX_ = context.PhysicalDevice().getProperties().limits.maxComputeWorkGroupCount[0];
+
+    // frame마다 set 2개 (ping-pong 방향별) × 6 SSBOs
+    const uint32_t maxSets = framesInFlight * 2;
+    vk::DescriptorPoolSize poolSize{vk::DescriptorType::eStorageBuffer, maxSets * 6};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+    poolInfo.setMaxSets(maxSets);
+    poolInfo.setPoolSizes(poolSize);
+    descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+
+    // layout이 동일하게 정의되어 있으므로 upsweep layout으로 할당한 set을 세 파이프라인에 모두 binding
+    descriptorSets_.resize(framesInFlight);
+    for (auto& sets : descriptorSets_) {
+        std::array<vk::DescriptorSetLayout, 2> layouts = {
+            upsweep_.GetDescriptorSetLayout(), upsweep_.GetDescriptorSetLayout()};
+        vk::DescriptorSetAllocateInfo allocInfo{};
+        allocInfo.setDescriptorPool(*descriptorPool_);
+        allocInfo.setSetLayouts(layouts);
+        sets = context.Device().allocateDescriptorSets(allocInfo);
+    }
+}
+
+void SortPass::UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                                 uint64_t capacity) {
+    histograms_[frameIndex] = buffers.histograms;
+    capacities_[frameIndex] = capacity;
+
+    // 키 버퍼는 8 B, 값 버퍼는 4 B × capacity. 빈 범위는 허용되지 않으므로 최소 한 개
+    const uint64_t rows = std::max<uint64_t>(1, capacity);
+    std::array<std::array<vk::DescriptorBufferInfo, 6>, 2> bufferInfos;
+    std::vector<vk::WriteDescriptorSet> writes;
+    for (uint32_t dir = 0; dir < 2; dir++) {
+        const uint32_t src = dir, dst = dir ^ 1;
+        bufferInfos[dir] = {
+            vk::DescriptorBufferInfo{buffers.keys[src], 0, rows * 2 * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.values[src], 0, rows * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.keys[dst], 0, rows * 2 * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.values[dst], 0, rows * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.histograms, 0, HistogramBytes(capacity)},
+            vk::DescriptorBufferInfo{buffers.count, 0, sizeof(uint32_t)},
+        };
+        for (uint32_t b = 0; b < 6; b++) {
+            vk::WriteDescriptorSet write{};
+            write.setDstSet(*descriptorSets_[frameIndex][dir]);
+            write.setDstBinding(b);
+            write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+            write.setBufferInfo(bufferInfos[dir][b]);
+            writes.push_back(write);
+        }
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void SortPass::Record(vk::CommandBuffer cmd) {
+    if (!histograms_[currentFrame_]) {
+        return;  // 아직 정렬할 버퍼 없음
+    }
+    const uint64_t blocks = std::max<uint64_t>(1, BlockCount(capacities_[currentFrame_]));
+    const uint32_t groupsX = static_cast<uint32_t>(std::min<uint64_t>(blocks, maxGroupsX_));
+    const uint32_t groupsY = static_cast<uint32_t>((blocks + groupsX - 1) / groupsX);
+
+    // 전역 histogram은 pass마다 atomic으로 누적되므로 모든 pass 구간을 한 번에 비움
+    cmd.fillBuffer(histograms_[currentFrame_], 0, sizeof(uint32_t) * MAX_PASSES * RADIX, 0);
+
+    auto barrier = [&](vk::PipelineStageFlags src, vk::AccessFlags srcAccess) {
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = srcAccess;
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+        cmd.pipelineBarrier(src, vk::PipelineStageFlagBits::eComputeShader, {}, memoryBarrier, {}, {});
+    };
+    barrier(vk::PipelineStageFlagBits::eTransfer, vk::AccessFlagBits::eTransferWrite);
+
+    auto dispatch = [&](const ComputePipeline& pipeline, vk::DescriptorSet set,
+                        const PushConstants& push, uint32_t x, uint32_t y) {
+        cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline.GetHandle());
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline.GetLayout(), 0, set, {});
+        cmd.pushConstants(pipeline.GetLayout(), vk::ShaderStageFlagBits::eCompute,
+                          0, sizeof(PushConstants), &push);
+        cmd.dispatch(x, y, 1);
+        barrier(vk::PipelineStageFlagBits::eComputeShader, vk::AccessFlagBits::eShaderWrite);
+    };
+
+    for (uint32_t pass = 0; pass < passCount_; pass++) {
+        const vk::DescriptorSet set = *descriptorSets_[currentFrame_][pass & 1];
+        const PushConstants push{pass, static_cast<uint32_t>(blocks)};
+        dispatch(upsweep_, set, push, groupsX, groupsY);
+        dispatch(scan_, set, push, RADIX, 1);
+        dispatch(downsweep_, set, push, groupsX, groupsY);
+    }
 }
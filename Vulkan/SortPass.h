@@ -1,14 +1,77 @@
 #pragma once
+#include "Core.h"
 #include "ComputePass.h"
 #include "ComputePipeline.h"
 
 class Context;
 
+// 64비트 키(uvec2: x = 하위 32비트 = depth, y = 상위 = tile id) + 32비트 값의 GPU LSD radix sort.
+//
+// pass마다 8비트 digit 하나를 정렬하며, pass는 세 dispatch로 구성 (sort.comp의 STAGE):
+//   Upsweep:   BLOCK_KEYS개 block마다 digit histogram → blockHistogram[digit][block], 전역 합계
+//   Scan:      digit마다 workgroup 하나가 block 방향 exclusive scan + 앞 digit들의 합계 → 출력 위치
+//   Downsweep: block을 256개씩 다시 읽어 subgroup ballot으로 안정적인 순위를 매기고 scatter
+// 키 수는 GPU 버퍼(count)에서 읽으므로 CPU가 몰라도 되고(binning 결과), dispatch는 capacity 기준.
+// 키는 pass마다 keys[0] ↔ keys[1]을 오가며, 정렬 결과는 keys[GetResultIndex()].
+// SetKeyBits로 실제 쓰이는 상위 비트까지만 pass를 돌림 (32비트 depth + tile id 비트 수).
+//
+// Usage:
+//   SortPass sort(context, "Shaders/sort.comp.spv", framesInFlight);
+//   sort.UpdateDescriptors(context, frame, buffers, capacity);   // HistogramBytes(capacity)
+//   sort.SetKeyBits(32 + tileBits);
+//   sort.Record(cmd);   // keys[sort.GetResultIndex()] / values[...]가 정렬됨
 class SortPass : public ComputePass {
 public:
-    SortPass(Context& context, const std::string& shaderPath);
+    static constexpr uint32_t RADIX_BITS      = 8;
+    static constexpr uint32_t RADIX           = 1u << RADIX_BITS;
+    static constexpr uint32_t MAX_PASSES      = 64 / RADIX_BITS;
+    static constexpr uint32_t KEYS_PER_THREAD = 16;
+    static constexpr uint32_t BLOCK_KEYS      = 256 * KEYS_PER_THREAD;  // sort.comp와 일치
+
+    struct Buffers {
+        std::array<vk::Buffer, 2> keys;    // uvec2 키, 정렬 전 입력은 keys[0]
+        std::array<vk::Buffer, 2> values;  // uint 값, 정렬 전 입력은 values[0]
+        vk::Buffer count;                  // uint 하나: 정렬할 키 수 (≤ capacity)
+        vk::Buffer histograms;             // HistogramBytes(capacity), TRANSFER_DST
+    };
+
+    struct PushConstants {
+        uint32_t pass;         // digit = 키의 [pass * 8, pass * 8 + 8) 비트
+        uint32_t blockStride;  // capacity의 block 수 (blockHistogram의 digit 행 길이)
+    };
+
+    // subgroup ballot이 compute에서 지원되지 않거나 subgroup이 8보다 작으면 예외
+    SortPass(Context& context, const std::string& shaderPath, uint32_t framesInFlight);
+
+    static uint64_t BlockCount(uint64_t capacity) { return (capacity + BLOCK_KEYS - 1) / BLOCK_KEYS; }
+    // 전역 histogram (pass × digit) + blockHistogram (digit × block)
+    static vk::DeviceSize HistogramBytes(uint64_t capacity) {
+        return sizeof(uint32_t) * (uint64_t{MAX_PASSES} * RADIX + RADIX * std::max<uint64_t>(1, BlockCount(capacity)));
+    }
+
+    // capacity: 키/값 버퍼에 들어가는 최대 키 수 (2^32 미만)
+    void UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers, uint64_t capacity);
+
+    void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
+    // 키에서 정렬할 하위 비트 수 (1-64). pass 수 = ceil(keyBits / 8)
+    void SetKeyBits(uint32_t keyBits) {
+        passCount_ = std::clamp<uint32_t>((keyBits + RADIX_BITS - 1) / RADIX_BITS, 1, MAX_PASSES);
+    }
+    uint32_t GetPassCount() const { return passCount_; }
+    uint32_t GetResultIndex() const { return passCount_ & 1; }
+
     void Record(vk::CommandBuffer cmd) override;
 
 private:
-    ComputePipeline pipeline_;
+    ComputePipeline upsweep_;
+    ComputePipeline scan_;
+    ComputePipeline downsweep_;
+    vk::raii::DescriptorPool descriptorPool_ = nullptr;
+    // [frame][0] = keys[0] → keys[1], [frame][1] = keys[1] → keys[0]
+    std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets_;
+    std::vector<vk::Buffer> histograms_;
+    std::vector<uint64_t> capacities_;
+    uint32_t maxGroupsX_   = 65535;
+    uint32_t currentFrame_ = 0;
+    uint32_t passCount_    = MAX_PASSES;
 };
@@ -28,7 +28,11 @@ void Swapchain::Recreate(Context& context, GLFWwindow* window) {
 void Swapchain::create(Context& context, GLFWwindow* window) {
     SwapchainSupportDetails support = querySupport(*context.PhysicalDevice(), context.GetSurface());
 
-    vk::SurfaceFormatKHR surfaceFormat = chooseFormat(support.formats);
+    // STORAGE가 되면 raster 출력 형식 그대로, 아니면 복사 / blit 대상으로 기본 형식
+    const bool storage = supportsStorage(*context.PhysicalDevice(), support);
+    vk::SurfaceFormatKHR surfaceFormat = storage
+        ? vk::SurfaceFormatKHR{STORAGE_FORMAT, vk::ColorSpaceKHR::eSrgbNonlinear}
+        : chooseFormat(support.formats);
     vk::PresentModeKHR presentMode     = choosePresentMode(support.presentModes);
     vk::Extent2D extent                = chooseExtent(support.capabilities, window);
 
@@ -47,6 +51,12 @@ void Swapchain::create(Context& context, GLFWwindow* window) {
     createInfo.imageExtent      = extent;
     createInfo.imageArrayLayers = 1;
     createInfo.imageUsage       = vk::ImageUsageFlagBits::eColorAttachment;
+    if (support.capabilities.supportedUsageFlags & vk::ImageUsageFlagBits::eTransferDst) {
+        createInfo.imageUsage |= vk::ImageUsageFlagBits::eTransferDst;  // 복사 / blit / clear
+    }
+    if (storage) {
+        createInfo.imageUsage |= vk::ImageUsageFlagBits::eStorage;
+    }
 
     uint32_t graphicsFamily = context.GetGraphicsQueueFamily();
     uint32_t presentFamily  = context.GetPresentQueueFamily();
@@ -73,6 +83,7 @@ void Swapchain::create(Context& context, GLFWwindow* window) {
     // Store format and extent for later use
     format_ = surfaceFormat.format;
     extent_ = extent;
+    usage_  = createInfo.imageUsage;
 
     // Retrieve swapchain images
     images_ = swapchain_.getImages();
@@ -133,6 +144,29 @@ vk::SurfaceFormatKHR Swapchain::chooseFormat(
     return formats[0];
 }
 
+// ---------------------------------------------------------------------------
+// supportsStorage - STORAGE_FORMAT + SRGB_NONLINEAR로 storage image를 만들 수 있는지
+// ---------------------------------------------------------------------------
+
+bool Swapchain::supportsStorage(vk::PhysicalDevice device,
+                                const SwapchainSupportDetails& support) const
+{
+    if (!(support.capabilities.supportedUsageFlags & vk::ImageUsageFlagBits::eStorage)) {
+        return false;
+    }
+    if (!(device.getFormatProperties(STORAGE_FORMAT).optimalTilingFeatures &
+          vk::FormatFeatureFlagBits::eStorageImage)) {
+        return false;
+    }
+    for (const auto& format : support.formats) {
+        if (format.format == STORAGE_FORMAT &&
+            format.colorSpace == vk::ColorSpaceKHR::eSrgbNonlinear) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // ---------------------------------------------------------------------------
 // choosePresentMode - prefer Mailbox, fallback to FIFO
 // ---------------------------------------------------------------------------
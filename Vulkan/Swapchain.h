@@ -5,6 +5,10 @@ class Context; // forward declaration
 
 class Swapchain {
 public:
+    // rast.comp의 image format (RasterPass::OUTPUT_FORMAT). surface가 이 형식에 STORAGE usage를
+    // 허용하면 이 형식으로 만들어 raster가 swapchain 이미지에 바로 기록
+    static constexpr vk::Format STORAGE_FORMAT = vk::Format::eR8G8B8A8Unorm;
+
     Swapchain(Context& context, GLFWwindow* window);
 
     // Non-copyable, non-movable (owns raii resources)
@@ -15,7 +19,9 @@ public:
 
     vk::Format GetFormat() const { return format_; }
     vk::Extent2D GetExtent() const { return extent_; }
+    vk::ImageUsageFlags GetUsage() const { return usage_; }
     uint32_t GetImageCount() const { return static_cast<uint32_t>(images_.size()); }
+    const std::vector<vk::Image>& GetImages() const { return images_; }
     const std::vector<vk::raii::ImageView>& GetImageViews() const { return imageViews_; }
     const vk::raii::SwapchainKHR& GetHandle() const { return swapchain_; }
 
@@ -25,6 +31,7 @@ private:
     std::vector<vk::raii::ImageView> imageViews_;
     vk::Format format_;
     vk::Extent2D extent_;
+    vk::ImageUsageFlags usage_;
 
     void create(Context& context, GLFWwindow* window);
 
@@ -36,6 +43,7 @@ private:
 
     SwapchainSupportDetails querySupport(vk::PhysicalDevice device, vk::SurfaceKHR surface) const;
     vk::SurfaceFormatKHR chooseFormat(const std::vector<vk::SurfaceFormatKHR>& formats) const;
+    bool supportsStorage(vk::PhysicalDevice device, const SwapchainSupportDetails& support) const;
     vk::PresentModeKHR choosePresentMode(const std::vector<vk::PresentModeKHR>& modes) const;
     vk::Extent2D chooseExtent(const vk::SurfaceCapabilitiesKHR& capabilities, GLFWwindow* window) const;
 };
@@ -0,0 +1,94 @@
+#include "TileRangePass.h"
+#include "Context.h"
+
+TileRangePass::TileRangePass(Context& context, const std::string& shaderPath, uint32_t framesInFlight)
+    : pipeline_(context, shaderPath,
+                // 3 SSBOs: 정렬된 키, 키 수, tile 구간
+                std::vector<vk::DescriptorSetLayoutBinding>{
+                    {0, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {1, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                    {2, vk::DescriptorType::eStorageBuffer, 1, vk::ShaderStageFlagBits::eCompute},
+                },
+                sizeof(PushConstants)),
+      keyCapacities_(framesInFlight, 0),
+      tileCounts_(framesInFlight, 0)
+{
+    maxGroupsX_ = context.PhysicalDevice().getProperties().limits.maxComputeWorkGroupCount[0];
+
+    // frame마다 set 2개 (정렬 결과가 keys[0] / keys[1]인 경우) × 3 SSBOs
+    const uint32_t maxSets = framesInFlight * 2;
+    vk::DescriptorPoolSize poolSize{vk::DescriptorType::eStorageBuffer, maxSets * 3};
+    vk::DescriptorPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet);
+    poolInfo.setMaxSets(maxSets);
+    poolInfo.setPoolSizes(poolSize);
+    descriptorPool_ = context.Device().createDescriptorPool(poolInfo);
+
+    descriptorSets_.resize(framesInFlight);
+    for (auto& sets : descriptorSets_) {
+        std::array<vk::DescriptorSetLayout, 2> layouts = {
+            pipeline_.GetDescriptorSetLayout(), pipeline_.GetDescriptorSetLayout()};
+        vk::DescriptorSetAllocateInfo allocInfo{};
+        allocInfo.setDescriptorPool(*descriptorPool_);
+        allocInfo.setSetLayouts(layouts);
+        sets = context.Device().allocateDescriptorSets(allocInfo);
+    }
+}
+
+void TileRangePass::UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                                      uint64_t keyCapacity, uint32_t tileCount) {
+    keyCapacities_[frameIndex] = keyCapacity;
+    tileCounts_[frameIndex]    = tileCount;
+
+    // 빈 범위는 허용되지 않으므로 최소 한 개
+    const uint64_t keys = std::max<uint64_t>(1, keyCapacity);
+    std::array<std::array<vk::DescriptorBufferInfo, 3>, 2> bufferInfos;
+    std::vector<vk::WriteDescriptorSet> writes;
+    for (uint32_t k = 0; k < 2; k++) {
+        bufferInfos[k] = {
+            vk::DescriptorBufferInfo{buffers.keys[k], 0, keys * 2 * sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.count, 0, sizeof(uint32_t)},
+            vk::DescriptorBufferInfo{buffers.tileRanges, 0, std::max(1u, tileCount) * 2 * sizeof(uint32_t)},
+        };
+        for (uint32_t b = 0; b < 3; b++) {
+            vk::WriteDescriptorSet write{};
+            write.setDstSet(*descriptorSets_[frameIndex][k]);
+            write.setDstBinding(b);
+            write.setDescriptorType(vk::DescriptorType::eStorageBuffer);
+            write.setBufferInfo(bufferInfos[k][b]);
+            writes.push_back(write);
+        }
+    }
+    context.Device().updateDescriptorSets(writes, {});
+}
+
+void TileRangePass::Record(vk::CommandBuffer cmd) {
+    if (keyCapacities_[currentFrame_] == 0 || tileCounts_[currentFrame_] == 0) {
+        return;  // 아직 키 / tile 구간 버퍼 없음
+    }
+
+    // 키 경계는 keyCount + 1개 (마지막 키 뒤 포함). 256개씩, x 한도를 넘으면 y로 접음
+    const uint64_t groups = (keyCapacities_[currentFrame_] + 1 + 255) / 256;
+    const uint32_t groupsX = static_cast<uint32_t>(std::min<uint64_t>(groups, maxGroupsX_));
+    const uint32_t groupsY = static_cast<uint32_t>((groups + groupsX - 1) / groupsX);
+
+    const PushConstants push{tileCounts_[currentFrame_]};
+    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline_.GetHandle());
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                           pipeline_.GetLayout(), 0,
+                           *descriptorSets_[currentFrame_][resultIndex_], {});
+    cmd.pushConstants(pipeline_.GetLayout(),
+                      vk::ShaderStageFlagBits::eCompute,
+                      0, sizeof(PushConstants), &push);
+    cmd.dispatch(groupsX, groupsY, 1);
+
+    // Compute → Compute 배리어 (후속 raster pass 대비)
+    vk::MemoryBarrier barrier{};
+    barrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+    barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    cmd.pipelineBarrier(
+        vk::PipelineStageFlagBits::eComputeShader,
+        vk::PipelineStageFlagBits::eComputeShader,
+        {}, barrier, {}, {}
+    );
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Core.h"
+#include "ComputePass.h"
+#include "ComputePipeline.h"
+
+class Context;
+
+// 정렬된 키(tile id가 상위 비트)에서 tile 경계를 찾아 tile마다 [start, end) 구간을 tileRanges에 기록
+// (ranges.comp). 키 경계마다 스레드 하나가 앞 tile의 end, 뒤 tile의 start, 그 사이 빈 tile의 (i, i)를
+// 쓰므로 tileRanges를 미리 비우지 않아도 모든 tile이 갱신됨. 키 수는 GPU 버퍼(count)에서 읽고
+// dispatch는 keyCapacity + 1개 스레드 기준.
+//
+// Usage:
+//   TileRangePass ranges(context, "Shaders/ranges.comp.spv", framesInFlight);
+//   ranges.UpdateDescriptors(context, frame, buffers, keyCapacity, tileCount);
+//   ranges.SetResultIndex(sort.GetResultIndex());
+//   ranges.Record(cmd);   // sort 다음
+class TileRangePass : public ComputePass {
+public:
+    static constexpr uint32_t TILE_SIZE = 16;  // proj.comp / bin.comp와 일치
+
+    // 화면을 덮는 tile 격자 (tileWidth × tileHeight)
+    static vk::Extent2D TileGrid(vk::Extent2D extent) {
+        return {(extent.width + TILE_SIZE - 1) / TILE_SIZE, (extent.height + TILE_SIZE - 1) / TILE_SIZE};
+    }
+
+    struct Buffers {
+        std::array<vk::Buffer, 2> keys;  // SortPass keys[0] / keys[1] (결과 쪽은 SetResultIndex)
+        vk::Buffer count;                // SortPass count
+        vk::Buffer tileRanges;           // uvec2 × tileCount
+    };
+
+    struct PushConstants {
+        uint32_t tileCount;
+    };
+
+    TileRangePass(Context& context, const std::string& shaderPath, uint32_t framesInFlight);
+
+    void UpdateDescriptors(Context& context, uint32_t frameIndex, const Buffers& buffers,
+                           uint64_t keyCapacity, uint32_t tileCount);
+
+    void SetFrameIndex(uint32_t frameIndex) { currentFrame_ = frameIndex; }
+    void SetResultIndex(uint32_t resultIndex) { resultIndex_ = resultIndex; }
+
+    void Record(vk::CommandBuffer cmd) override;
+
+private:
+    ComputePipeline pipeline_;
+    vk::raii::DescriptorPool descriptorPool_ = nullptr;
+    // [frame][k] = keys[k]를 읽는 set
+    std::vector<std::vector<vk::raii::DescriptorSet>> descriptorSets_;
+    std::vector<uint64_t> keyCapacities_;
+    std::vector<uint32_t> tileCounts_;
+    uint32_t maxGroupsX_   = 65535;
+    uint32_t currentFrame_ = 0;
+    uint32_t resultIndex_  = 0;
+};
@@ -0,0 +1,265 @@
+#include "UploadManager.h"
+#include "Context.h"
+
+UploadManager::UploadManager(Context& context, vk::DeviceSize stagingSize)
+    : device_(context.Device())
+    , queue_(context.GetTransferQueue())
+    , transferFamily_(context.GetTransferQueueFamily())
+    , graphicsFamily_(context.GetGraphicsQueueFamily())
+    , ring_(Buffer::CreateHostVisible(context, vk::BufferUsageFlagBits::eTransferSrc, stagingSize)) {
+    vk::CommandPoolCreateInfo poolInfo{};
+    poolInfo.setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
+                      vk::CommandPoolCreateFlagBits::eTransient);
+    poolInfo.setQueueFamilyIndex(transferFamily_);
+    pool_ = context.Device().createCommandPool(poolInfo);
+
+    vk::CommandBufferAllocateInfo allocInfo{};
+    allocInfo.setCommandPool(*pool_);
+    allocInfo.setLevel(vk::CommandBufferLevel::ePrimary);
+    allocInfo.setCommandBufferCount(MAX_BATCHES_IN_FLIGHT);
+    commandBuffers_ = context.Device().allocateCommandBuffers(allocInfo);
+
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.setSemaphoreType(vk::SemaphoreType::eTimeline);
+    typeInfo.setInitialValue(0);
+    vk::SemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.setPNext(&typeInfo);
+    timeline_ = context.Device().createSemaphore(semaphoreInfo);
+}
+
+UploadManager::~UploadManager() {
+    // 제출된 복사가 ring/command buffer를 참조하므로 완료를 기다린 뒤 해제
+    if (!inFlight_.empty()) {
+        Wait(inFlight_.back().ticket);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Enqueue
+// ---------------------------------------------------------------------------
+
+void UploadManager::Enqueue(const Buffer& dst, const void* data, vk::DeviceSize size,
+                            vk::DeviceSize dstOffset) {
+    // ring의 1/4 단위로 나눠 앞 조각이 전송되는 동안 다음 조각을 채울 수 있게 함
+    const vk::DeviceSize maxPiece = ring_.GetSize() / 4;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    for (vk::DeviceSize done = 0; done < size;) {
+        vk::DeviceSize piece  = std::min(size - done, maxPiece);
+        vk::DeviceSize offset = reserve(piece);
+
+        memcpy(static_cast<uint8_t*>(ring_.GetMappedData()) + offset, bytes + done, piece);
+        pending_.push_back({ring_.GetHandle(), dst.GetHandle(),
+                            vk::BufferCopy{offset, dstOffset + done, piece}});
+        ringPending_ = true;
+        done += piece;
+    }
+}
+
+void UploadManager::EnqueueCopy(const Buffer& src, const Buffer& dst, vk::DeviceSize size,
+                                vk::DeviceSize srcOffset, vk::DeviceSize dstOffset) {
+    pending_.push_back({src.GetHandle(), dst.GetHandle(),
+                        vk::BufferCopy{srcOffset, dstOffset, size}});
+}
+
+// ---------------------------------------------------------------------------
+// Flush / completion
+// ---------------------------------------------------------------------------
+
+uint64_t UploadManager::Flush() {
+    if (pending_.empty()) {
+        return nextTicket_ - 1;
+    }
+
+    uint32_t slot = acquireCommandBuffer();
+    auto& cmd = commandBuffers_[slot];
+    cmd.reset({});
+
+    vk::CommandBufferBeginInfo beginInfo{};
+    beginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    cmd.begin(beginInfo);
+
+    // 같은 src/dst 쌍이 연속되면 하나의 vkCmdCopyBuffer로 묶음
+    std::vector<vk::BufferCopy> regions;
+    for (size_t i = 0; i < pending_.size(); i++) {
+        regions.push_back(pending_[i].region);
+        bool last = i + 1 == pending_.size() ||
+                    pending_[i + 1].src != pending_[i].src ||
+                    pending_[i + 1].dst != pending_[i].dst;
+        if (last) {
+            cmd.copyBuffer(pending_[i].src, pending_[i].dst, regions);
+            regions.clear();
+        }
+    }
+
+    uint64_t ticket = nextTicket_++;
+
+    if (transferFamily_ == graphicsFamily_) {
+        // 같은 큐: TRANSFER_WRITE → SHADER/UNIFORM/TRANSFER READ로 이후 제출에 가시화
+        vk::MemoryBarrier barrier{};
+        barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eUniformRead |
+                                vk::AccessFlagBits::eTransferRead;
+        cmd.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+            {}, barrier, {}, {});
+    } else {
+        // 전용 transfer 큐: 복사한 구간마다 소유권 release (graphics 쪽 acquire와 동일한 범위)
+        PendingAcquire acquire{ticket, {}};
+        std::vector<vk::BufferMemoryBarrier> releases;
+        for (const auto& copy : pending_) {
+            vk::BufferMemoryBarrier barrier{};
+            barrier.srcQueueFamilyIndex = transferFamily_;
+            barrier.dstQueueFamilyIndex = graphicsFamily_;
+            barrier.buffer = copy.dst;
+            barrier.offset = copy.region.dstOffset;
+            barrier.size   = copy.region.size;
+
+            barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+            releases.push_back(barrier);
+
+            barrier.srcAccessMask = {};
+            barrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eUniformRead |
+                                    vk::AccessFlagBits::eTransferRead;
+            acquire.barriers.push_back(barrier);
+        }
+        cmd.pipelineBarrier(
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eBottomOfPipe,
+            {}, {}, releases, {});
+        acquires_.push_back(std::move(acquire));
+    }
+
+    cmd.end();
+
+    vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+    timelineInfo.setSignalSemaphoreValues(ticket);
+
+    vk::CommandBuffer rawCmd = *cmd;
+    vk::Semaphore timeline   = *timeline_;
+    vk::SubmitInfo submitInfo{};
+    submitInfo.setPNext(&timelineInfo);
+    submitInfo.setCommandBuffers(rawCmd);
+    submitInfo.setSignalSemaphores(timeline);
+    queue_.submit(submitInfo);
+
+    batchTickets_[slot] = ticket;
+    inFlight_.push_back({ticket, head_, batchBytes_});
+    batchBytes_ = 0;
+    pending_.clear();
+    ringPending_ = false;
+    return ticket;
+}
+
+bool UploadManager::IsComplete(uint64_t ticket) const {
+    return timeline_.getCounterValue() >= ticket;
+}
+
+void UploadManager::Wait(uint64_t ticket) const {
+    vk::Semaphore timeline = *timeline_;
+    vk::SemaphoreWaitInfo waitInfo{};
+    waitInfo.setSemaphores(timeline);
+    waitInfo.setValues(ticket);
+    auto result = device_.waitSemaphores(waitInfo, UINT64_MAX);
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error("Failed to wait for upload completion");
+    }
+}
+
+uint64_t UploadManager::RecordAcquires(vk::CommandBuffer cmd) {
+    // 완료된 제출만 acquire → graphics submit이 미완료 전송을 기다리며 멈추지 않음
+    uint64_t completed = timeline_.getCounterValue();
+    uint64_t waitValue = 0;
+    std::vector<vk::BufferMemoryBarrier> barriers;
+    while (!acquires_.empty() && acquires_.front().ticket <= completed) {
+        auto& acquire = acquires_.front();
+        barriers.insert(barriers.end(), acquire.barriers.begin(), acquire.barriers.end());
+        waitValue = acquire.ticket;
+        acquires_.pop_front();
+    }
+
+    if (!barriers.empty()) {
+        cmd.pipelineBarrier(
+            vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+            {}, {}, barriers, {});
+    }
+    return waitValue;
+}
+
+// ---------------------------------------------------------------------------
+// Staging ring
+// ---------------------------------------------------------------------------
+
+void UploadManager::retire() {
+    uint64_t completed = timeline_.getCounterValue();
+    while (!inFlight_.empty() && inFlight_.front().ticket <= completed) {
+        tail_  = inFlight_.front().ringEnd;
+        used_ -= inFlight_.front().ringBytes;
+        inFlight_.pop_front();
+    }
+
+    // 사용 중인 바이트가 없으면 처음부터 다시 채움 (wrap으로 버려지는 공간 최소화).
+    // 복사만 하는 batch(EnqueueCopy)가 진행 중이어도 ring은 비어 있음
+    if (used_ == 0) {
+        head_ = tail_ = 0;
+    }
+}
+
+vk::DeviceSize UploadManager::reserve(vk::DeviceSize size) {
+    size = (size + RING_ALIGNMENT - 1) & ~(RING_ALIGNMENT - 1);
+    const vk::DeviceSize ringSize = ring_.GetSize();
+
+    // 이번 batch가 차지하는 바이트 (wrap으로 건너뛴 끝부분 포함, 완료 시 retire가 반환)
+    auto take = [&](vk::DeviceSize bytes) {
+        used_       += bytes;
+        batchBytes_ += bytes;
+    };
+
+    for (;;) {
+        retire();
+
+        // head_ == tail_은 비었거나 가득 찬 경우 둘 다이므로 used_로 구분.
+        // 사용 구간 [tail_, head_)가 끝까지 이어져 있으면 뒤쪽, 부족하면 앞쪽으로 wrap
+        if (used_ == 0 || head_ > tail_) {
+            if (ringSize - head_ >= size) {
+                vk::DeviceSize offset = head_;
+                head_ += size;
+                take(size);
+                return offset;
+            }
+            if (tail_ >= size) {
+                take(ringSize - head_ + size);
+                head_ = size;
+                return 0;
+            }
+        } else if (head_ < tail_ && tail_ - head_ >= size) {
+            vk::DeviceSize offset = head_;
+            head_ += size;
+            take(size);
+            return offset;
+        }
+
+        // 공간 부족: 쌓인 복사를 제출하고 가장 오래된 제출이 끝나기를 기다림
+        if (ringPending_) {
+            Flush();
+        }
+        Wait(inFlight_.front().ticket);
+    }
+}
+
+uint32_t UploadManager::acquireCommandBuffer() {
+    uint64_t completed = timeline_.getCounterValue();
+    uint32_t oldest = 0;
+    for (uint32_t i = 0; i < MAX_BATCHES_IN_FLIGHT; i++) {
+        if (batchTickets_[i] <= completed) {
+            return i;
+        }
+        if (batchTickets_[i] < batchTickets_[oldest]) {
+            oldest = i;
+        }
+    }
+    Wait(batchTickets_[oldest]);
+    return oldest;
+}
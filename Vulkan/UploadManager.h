@@ -0,0 +1,102 @@
+#pragma once
+#include "Core.h"
+#include "Buffer.h"
+#include <deque>
+
+class Context;
+
+// Host → device 업로드를 모아 한 번에 submit하는 관리자.
+//
+// 데이터는 재사용되는 staging ring(HOST_VISIBLE, 매핑)에 복사되고, Flush()까지 쌓인
+// 복사는 하나의 command buffer로 제출된다. 완료는 timeline semaphore 값(ticket)으로
+// 추적하므로 큐 전체를 비우지 않고 필요한 제출만 기다릴 수 있다.
+//
+// 전용 transfer 큐가 있으면 그 큐에 제출해 렌더링과 겹쳐 실행된다. 이때 대상 버퍼
+// 구간은 transfer → graphics family로 소유권이 넘어가야 하므로, Flush가 release
+// barrier를 기록하고 Renderer가 프레임 앞에서 RecordAcquires로 acquire barrier를
+// 기록한 뒤 반환된 timeline 값을 submit의 wait semaphore로 사용한다.
+//
+// Usage:
+//   uploads.Enqueue(dst, data, size);        // ring에 복사 후 예약
+//   uploads.EnqueueCopy(staging, dst, size);  // 이미 staging에 있는 데이터
+//   uint64_t ticket = uploads.Flush();        // 한 번의 submit
+//   uploads.Wait(ticket);                     // 필요할 때만 대기
+class UploadManager {
+public:
+    static constexpr vk::DeviceSize DEFAULT_STAGING_SIZE = 64ull * 1024 * 1024;
+
+    UploadManager(Context& context, vk::DeviceSize stagingSize = DEFAULT_STAGING_SIZE);
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    // data[0, size) → dst[dstOffset, ...). ring보다 큰 데이터는 나눠서 복사하며,
+    // ring이 가득 차면 쌓인 복사를 제출하고 가장 오래된 제출의 완료를 기다린다.
+    void Enqueue(const Buffer& dst, const void* data, vk::DeviceSize size,
+                 vk::DeviceSize dstOffset = 0);
+
+    // 호출자 소유 staging 버퍼에서의 복사. src는 ticket 완료까지 유지되어야 함.
+    void EnqueueCopy(const Buffer& src, const Buffer& dst, vk::DeviceSize size,
+                     vk::DeviceSize srcOffset = 0, vk::DeviceSize dstOffset = 0);
+
+    // 쌓인 복사를 제출. 반환값이 timeline에 signal되면 완료 (쌓인 게 없으면 마지막 ticket).
+    uint64_t Flush();
+
+    bool IsComplete(uint64_t ticket) const;
+    void Wait(uint64_t ticket) const;
+
+    vk::Semaphore GetTimeline() const { return *timeline_; }
+
+    // 완료된 제출 중 아직 graphics 큐가 acquire하지 않은 구간의 acquire barrier를 기록.
+    // 반환값: graphics submit이 timeline에서 기다릴 값 (0이면 대기 불필요).
+    uint64_t RecordAcquires(vk::CommandBuffer cmd);
+
+private:
+    static constexpr uint32_t MAX_BATCHES_IN_FLIGHT = 4;
+    static constexpr vk::DeviceSize RING_ALIGNMENT  = 16;
+
+    struct PendingCopy {
+        vk::Buffer src;
+        vk::Buffer dst;
+        vk::BufferCopy region;
+    };
+
+    struct Batch {
+        uint64_t ticket;
+        vk::DeviceSize ringEnd;    // 이 제출이 완료되면 ring의 [.., ringEnd)가 비워짐
+        vk::DeviceSize ringBytes;  // 그때 반환되는 바이트 수 (복사만 하는 batch는 0)
+    };
+
+    // release와 짝이 되는 acquire barrier (graphics 큐에서 기록 대기 중)
+    struct PendingAcquire {
+        uint64_t ticket;
+        std::vector<vk::BufferMemoryBarrier> barriers;
+    };
+
+    vk::raii::Device& device_;
+    vk::Queue queue_;
+    uint32_t transferFamily_ = 0;
+    uint32_t graphicsFamily_ = 0;
+
+    Buffer ring_;
+    vk::DeviceSize head_ = 0;  // 다음 기록 위치
+    vk::DeviceSize tail_ = 0;  // 아직 사용 중인 가장 오래된 구간의 시작
+    vk::DeviceSize used_ = 0;  // 사용 중인 바이트 (head_ == tail_일 때 빈 ring / 가득 찬 ring 구분)
+    vk::DeviceSize batchBytes_ = 0;  // 아직 제출하지 않은 batch가 차지한 바이트
+    bool ringPending_    = false;
+
+    vk::raii::CommandPool pool_ = nullptr;
+    std::vector<vk::raii::CommandBuffer> commandBuffers_;
+    std::array<uint64_t, MAX_BATCHES_IN_FLIGHT> batchTickets_{};
+    vk::raii::Semaphore timeline_ = nullptr;
+
+    std::vector<PendingCopy> pending_;
+    std::deque<Batch> inFlight_;
+    std::deque<PendingAcquire> acquires_;
+    uint64_t nextTicket_ = 1;
+
+    vk::DeviceSize reserve(vk::DeviceSize size);
+    uint32_t acquireCommandBuffer();
+    void retire();
+};
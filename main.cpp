@@ -3,11 +3,56 @@
 int main(int argc, char* argv[]) {
     try {
         App app(1600, 900, "Gaussian Splatting");
-        app.InitializePLY(argv[1]);
+
+        // GaussianSplatting --sort-bench [count ...]: 장면 없이 GPU radix sort만 측정
+        if (argc >= 2 && std::strcmp(argv[1], "--sort-bench") == 0) {
+            SortBenchmarkOptions bench;
+            if (argc > 2) {
+                bench.counts.clear();
+                for (int i = 2; i < argc; ++i) {
+                    bench.counts.push_back(std::stoull(argv[i]));
+                }
+            }
+            app.RunSortBenchmark(bench);
+            return EXIT_SUCCESS;
+        }
+
+        // 로드는 백그라운드에서 진행, 창은 바로 뜨고 장면이 청크 단위로 나타남
+        SceneLoadOptions options;
+        options.async = true;
+
+        // 사용법: GaussianSplatting scene.ply [--fp16 | --covariance] [--morton] [--prune] [--stream] [--lod] [--no-cull] [--timings]
+        // --fp16: positions 외 입력을 fp16으로 올림 (projection이 읽는 대역폭 절반)
+        // --covariance: 3D 공분산 + 활성화된 opacity를 로드 시 계산 (projection의 exp / sigmoid / 회전 행렬 생략)
+        // scene.gsc 또는 --stream: 보이는 chunk만 GPU pool에 올리는 out-of-core 렌더링
+        // scene.gsl 또는 --lod: 병합된 Gaussian 계층에서 화면 크기로 고른 cut만 projection
+        // --no-cull: 256개 splat cluster 단위 GPU frustum culling 끔 (모든 splat을 projection)
+        // --timings: 240 프레임마다 pass별 GPU 시간과 projection 처리량(Msplats/s) 출력.
+        //            --morton 유무로 같은 장면을 돌려 재배열 전후 projection 처리량을 비교
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--fp16") == 0) {
+                options.inputFormat = ProjectionPass::InputFormat::Float16;
+            } else if (std::strcmp(argv[i], "--covariance") == 0) {
+                options.inputFormat = ProjectionPass::InputFormat::Covariance;
+            } else if (std::strcmp(argv[i], "--morton") == 0) {
+                options.mortonOrder = true;
+            } else if (std::strcmp(argv[i], "--prune") == 0) {
+                options.prune = true;
+            } else if (std::strcmp(argv[i], "--stream") == 0) {
+                options.streaming = true;
+            } else if (std::strcmp(argv[i], "--lod") == 0) {
+                options.lod = true;
+            } else if (std::strcmp(argv[i], "--no-cull") == 0) {
+                options.clusterCulling = false;
+            } else if (std::strcmp(argv[i], "--timings") == 0) {
+                app.SetTimingLog(true);
+            }
+        }
+        app.InitializePLY(argv[1], options);
         app.Run();
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
         return EXIT_FAILURE;
     }
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}